@@ -5,11 +5,14 @@
  */
 
 #include <algos.h>
+#include <kway_merge.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <getopt.h>
 #include <stdbool.h>
 #include <errno.h>
+#include <assert.h>
+#include <string.h>
 
 
 static int
@@ -21,6 +24,15 @@ qsort_compare(const void *a, const void *b)
     return x - y;
 }
 
+static int
+qsort_compare_int64(const void *a, const void *b)
+{
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
 static void
 test_search(void)
 {
@@ -59,6 +71,11 @@ test_merge_sort(void)
 {
     int ARR_SIZE = 10;
     int64_t arr[ARR_SIZE];
+    int64_t big[1000];
+    int64_t expect[1000];
+    arena_t *arena = create_arena(0);
+    uint64_t chunks = 0;
+    int error = 0;
 
     for (int i = 0; i < ARR_SIZE; i++) {
         arr[i] = rand() % 101;
@@ -69,12 +86,32 @@ test_merge_sort(void)
         printf("%lld ", arr[i]);
     }
 
-    bubble_sort(arr, ARR_SIZE);
+    merge_sort(arr, ARR_SIZE);
     printf("\n\t\tMerge Sorted Array: ");
     for (int i = 0; i < ARR_SIZE; i++) {
         printf("%lld ", arr[i]);
+        assert(i == 0 || arr[i - 1] <= arr[i]);
     }
 
+    /* Repeated sorts through one arena stop allocating after the first. */
+    assert(arena != NULL);
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 1000; i++) {
+            big[i] = expect[i] = (int64_t)(rand() % 2001) - 1000;
+        }
+        qsort(expect, 1000, sizeof(int64_t), qsort_compare_int64);
+        error = merge_sort_arena(big, 1000, arena);
+        assert(error == 0);
+        assert(memcmp(big, expect, sizeof(big)) == 0);
+        if (round == 0) {
+            chunks = arena->ar_num_chunks;
+        }
+        assert(arena->ar_num_chunks == chunks);
+        assert(arena->ar_chunk == NULL);
+    }
+    printf("\n\t\tMerge sorted 10 arrays of 1000 through one arena");
+    destroy_arena(arena);
+
     printf("\n");
 }
 
@@ -190,12 +227,148 @@ test_sorting(void)
     printf("\n");
 }
 
+static void
+test_selection(void)
+{
+    int ARR_SIZE = 1000;
+    int K = 10;
+    int64_t arr[ARR_SIZE];
+    int64_t sorted[ARR_SIZE];
+    int64_t out[ARR_SIZE];
+    topk_stream_t *s = NULL;
+    int count = 0;
+    int error = 0;
+
+    printf("\n\tTesting Selection Algorithms...");
+
+    for (int i = 0; i < ARR_SIZE; i++) {
+        arr[i] = (rand() % 2001) - 1000;
+        sorted[i] = arr[i];
+    }
+    qsort(sorted, ARR_SIZE, sizeof(int64_t), qsort_compare_int64);
+
+    error = top_k(arr, ARR_SIZE, K, out);
+    assert(error == 0);
+    printf("\n\t\tTop %d: ", K);
+    for (int i = 0; i < K; i++) {
+        assert(out[i] == sorted[ARR_SIZE - 1 - i]);
+        printf("%lld ", out[i]);
+    }
+
+    /* Streaming in uneven chunks must match the one shot result. */
+    s = create_topk_stream(K);
+    assert(s != NULL);
+    for (int i = 0; i < ARR_SIZE; i += 37) {
+        int n = (ARR_SIZE - i < 37) ? (ARR_SIZE - i) : 37;
+        topk_stream_push(s, &arr[i], n);
+    }
+    topk_stream_result(s, out, &count);
+    assert(count == K);
+    for (int i = 0; i < K; i++) {
+        assert(out[i] == sorted[ARR_SIZE - 1 - i]);
+    }
+    destroy_topk_stream(s);
+
+    error = partial_sort(arr, ARR_SIZE, K);
+    assert(error == 0);
+    printf("\n\t\tPartial sort, first %d: ", K);
+    for (int i = 0; i < K; i++) {
+        assert(arr[i] == sorted[i]);
+        printf("%lld ", arr[i]);
+    }
+
+    /* The rest of the array is still the rest of the values. */
+    qsort(arr, ARR_SIZE, sizeof(int64_t), qsort_compare_int64);
+    for (int i = 0; i < ARR_SIZE; i++) {
+        assert(arr[i] == sorted[i]);
+    }
+
+    error = top_k(arr, ARR_SIZE, ARR_SIZE + 1, out);
+    assert(error == EINVAL);
+    error = partial_sort(arr, ARR_SIZE, 0);
+    assert(error == EINVAL);
+
+    printf("\n");
+}
+
+static int
+failing_read(void *ctx, int64_t *buf, int max, int *count)
+{
+    *count = 0;
+    return EIO;
+}
+
+static void
+test_kway_merge(void)
+{
+    int NUM_RUNS = 13;
+    int MAX_RUN = 200;
+    int64_t runs[NUM_RUNS][MAX_RUN];
+    kway_array_run_t array_runs[NUM_RUNS];
+    kway_run_t sources[NUM_RUNS];
+    int64_t block[7];
+    kway_merge_t *m = NULL;
+    int64_t last = INT64_MIN;
+    int total = 0;
+    int merged = 0;
+    int count = 0;
+    int error = 0;
+
+    printf("\n\tTesting K-way Merge...");
+
+    /* Uneven run lengths, including empty runs, with duplicates. */
+    for (int i = 0; i < NUM_RUNS; i++) {
+        int len = (i % 4 == 0) ? 0 : rand() % MAX_RUN;
+
+        for (int j = 0; j < len; j++) {
+            runs[i][j] = (rand() % 1001) - 500;
+        }
+        qsort(runs[i], len, sizeof(int64_t), qsort_compare_int64);
+
+        array_runs[i].arr = runs[i];
+        array_runs[i].len = len;
+        array_runs[i].pos = 0;
+        sources[i].read = kway_array_read;
+        sources[i].ctx = &array_runs[i];
+        total += len;
+    }
+
+    m = create_kway_merge(sources, NUM_RUNS, 16);
+    assert(m != NULL);
+
+    printf("\n\t\tMerged head: ");
+    do {
+        error = kway_merge_next_block(m, block, 7, &count);
+        assert(error == 0);
+        for (int i = 0; i < count; i++) {
+            assert(block[i] >= last);
+            last = block[i];
+            if (merged + i < 10) {
+                printf("%lld ", block[i]);
+            }
+        }
+        merged += count;
+    } while (count > 0);
+    assert(merged == total);
+    printf("\n\t\tMerged %d values from %d runs", merged, NUM_RUNS);
+    destroy_kway_merge(m);
+
+    /* A failing reader aborts creation. */
+    sources[0].read = failing_read;
+    m = create_kway_merge(sources, NUM_RUNS, 16);
+    assert(m == NULL);
+
+    printf("\n");
+}
+
 int main(void)
 {
     printf("\nWelcome to Algorithms Driver Program!");
 
     test_search();
     test_sorting();
+    test_selection();
+    test_kway_merge();
 
     return 0;
 }
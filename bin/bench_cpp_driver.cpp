@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * DSA CPP benchmark driver program.
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+#include <getopt.h>
+#include <dary_heap.hpp>
+
+extern "C" {
+#include <heap.h>
+}
+
+using namespace std;
+
+static double
+now_sec()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void
+report(const char *name, uint64_t ops, double push_sec, double pop_sec)
+{
+    printf("\n\t\t%-16s push %8.2f Mops/s   pop %8.2f Mops/s",
+           name, ops / push_sec / 1e6, ops / pop_sec / 1e6);
+}
+
+static void
+bench_heap_t(const vector<uint64_t> &keys)
+{
+    uint64_t n = keys.size();
+    heap_t *h = create_heap(MIN_HEAP, n);
+    heap_elem_t *min = NULL;
+    uint64_t sum = 0;
+
+    if (h == NULL) {
+        printf("\n\t\tFailed to allocate heap_t");
+        return;
+    }
+
+    double start = now_sec();
+    for (uint64_t i = 0; i < n; i++) {
+        heap_elem_t elem = {keys[i]};
+        insert_heap(h, &elem);
+    }
+    double mid = now_sec();
+    for (uint64_t i = 0; i < n; i++) {
+        min = get_min(h);
+        sum += min->key;
+        delete_min(h, &min);
+    }
+    double end = now_sec();
+
+    report("heap_t", n, mid - start, end - mid);
+    destroy_heap(h);
+
+    if (sum == 0) {
+        printf(" ");
+    }
+}
+
+/*
+ * Loading a heap through N inserts against one Floyd heapify pass.
+ */
+static void
+bench_heap_t_build(const vector<uint64_t> &keys)
+{
+    uint64_t n = keys.size();
+    vector<heap_elem_t> elems(n);
+    heap_t *h = create_heap_flags(MIN_HEAP, 0, HEAP_F_GROW);
+
+    if (h == NULL) {
+        printf("\n\t\tFailed to allocate heap_t");
+        return;
+    }
+
+    for (uint64_t i = 0; i < n; i++) {
+        elems[i].key = keys[i];
+    }
+
+    double start = now_sec();
+    for (uint64_t i = 0; i < n; i++) {
+        insert_heap(h, &elems[i]);
+    }
+    double mid = now_sec();
+    destroy_heap(h);
+
+    h = create_heap_flags(MIN_HEAP, 0, HEAP_F_GROW);
+    if (h == NULL) {
+        printf("\n\t\tFailed to allocate heap_t");
+        return;
+    }
+
+    double build_start = now_sec();
+    heap_build_from_array(h, elems.data(), n);
+    double end = now_sec();
+    destroy_heap(h);
+
+    printf("\n\t\t%-16s inserts %8.3f s   heap_build_from_array %8.3f s",
+           "heap_t load", mid - start, end - build_start);
+}
+
+template <unsigned D>
+static void
+bench_dary_heap(const vector<uint64_t> &keys)
+{
+    uint64_t n = keys.size();
+    dary_min_heap<uint64_t, D> h(n);
+    uint64_t out = 0;
+    uint64_t sum = 0;
+    char name[32];
+
+    double start = now_sec();
+    for (uint64_t i = 0; i < n; i++) {
+        h.push(keys[i]);
+    }
+    double mid = now_sec();
+    while (h.pop(&out)) {
+        sum += out;
+    }
+    double end = now_sec();
+
+    snprintf(name, sizeof(name), "dary_heap<%u>", D);
+    report(name, n, mid - start, end - mid);
+
+    if (sum == 0) {
+        printf(" ");
+    }
+}
+
+static void
+bench_heaps(uint64_t n)
+{
+    vector<uint64_t> keys(n);
+
+    printf("\n\tBenchmarking heap push/pop with %llu random keys...",
+           (unsigned long long)n);
+
+    srand(1);
+    for (uint64_t i = 0; i < n; i++) {
+        keys[i] = ((uint64_t)rand() << 31) ^ rand();
+    }
+
+    bench_heap_t(keys);
+    bench_heap_t_build(keys);
+    bench_dary_heap<2>(keys);
+    bench_dary_heap<4>(keys);
+    bench_dary_heap<8>(keys);
+
+    printf("\n");
+}
+
+static void
+print_usage()
+{
+    printf("\nbench_cpp_driver -[H] [-n elements]");
+    printf("\n\t\t H - Benchmark heap_t against dary_heap");
+    printf("\n\t\t n - Number of elements (default 1000000)");
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int opt = 0;
+    uint64_t n = 1000000;
+    bool bench_heap_f = false;
+
+    printf("Welcome to DSA CPP Benchmark Driver Program!");
+
+    while ((opt = getopt(argc, argv, "hHn:")) != -1) {
+        switch (opt) {
+            case 'H':
+                bench_heap_f = true;
+                break;
+            case 'n':
+                n = strtoull(optarg, NULL, 10);
+                break;
+            case 'h':
+                print_usage();
+                break;
+            default:
+                printf("\nIncorrect option.");
+                print_usage();
+                goto done;
+        }
+    }
+
+    if (bench_heap_f) {
+        bench_heaps(n);
+    }
+
+done:
+    return 0;
+}
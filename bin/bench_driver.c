@@ -0,0 +1,2001 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * DSA benchmark driver program.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <getopt.h>
+#include <time.h>
+#include <heap.h>
+#include <pairing_heap.h>
+#include <multiqueue.h>
+#include <indexed_heap.h>
+#include <timing_wheel.h>
+#include <algos.h>
+#include <kway_merge.h>
+#include <spsc_ring.h>
+#include <mpmc_queue.h>
+#include <shm_queue.h>
+#include <treiber_stack.h>
+#include <Stack.h>
+#include <avl_tree.h>
+#include <bptree.h>
+#include <binary_tree.h>
+#include <stdatomic.h>
+#include <queue.h>
+#include <sched.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+static double
+now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint64_t
+bench_rand(void)
+{
+    return ((uint64_t)rand() << 31) ^ rand();
+}
+
+/*
+ * Dijkstra like trace over 'n' ids: pop the best id, then try to lower
+ * the key of 'fanout' random ids that are still queued. heap_t has no
+ * decrease-key, so it pushes a duplicate and skips stale entries on pop,
+ * which is what callers have to do with it today.
+ */
+#define DIJKSTRA_FANOUT     4
+#define DIJKSTRA_ID_BITS    24
+#define DIJKSTRA_ID_MASK    ((1ULL << DIJKSTRA_ID_BITS) - 1)
+
+static double
+bench_dijkstra_heap_t(uint64_t n, uint64_t *dist, bool *done)
+{
+    heap_t *h = create_heap_flags(MIN_HEAP, n, HEAP_F_GROW);
+    heap_elem_t *top = NULL;
+    heap_elem_t elem = {0};
+    double start = 0;
+
+    if (h == NULL) {
+        return 0;
+    }
+
+    srand(2);
+    start = now_sec();
+    for (uint64_t i = 0; i < n; i++) {
+        dist[i] = 1000000 + rand() % 1000000;
+        done[i] = false;
+        elem.key = (dist[i] << DIJKSTRA_ID_BITS) | i;
+        insert_heap(h, &elem);
+    }
+
+    while ((top = get_min(h)) != NULL) {
+        uint64_t id = top->key & DIJKSTRA_ID_MASK;
+        uint64_t d = top->key >> DIJKSTRA_ID_BITS;
+
+        delete_min(h, &top);
+        if (done[id] || d != dist[id]) {
+            continue;
+        }
+        done[id] = true;
+
+        for (int f = 0; f < DIJKSTRA_FANOUT; f++) {
+            uint64_t u = rand() % n;
+            uint64_t nd = d + 1 + rand() % 1000;
+            if (!done[u] && nd < dist[u]) {
+                dist[u] = nd;
+                elem.key = (nd << DIJKSTRA_ID_BITS) | u;
+                insert_heap(h, &elem);
+            }
+        }
+    }
+
+    destroy_heap(h);
+    return now_sec() - start;
+}
+
+static double
+bench_dijkstra_pairing_heap(uint64_t n, uint64_t *dist, bool *done)
+{
+    pairing_heap_t *h = create_pairing_heap(MIN_HEAP);
+    pairing_heap_node_t **nodes = NULL;
+    uint64_t key = 0;
+    void *payload = NULL;
+    double start = 0;
+
+    nodes = (pairing_heap_node_t **)malloc(n * sizeof(*nodes));
+    if (h == NULL || nodes == NULL) {
+        goto done;
+    }
+
+    srand(2);
+    start = now_sec();
+    for (uint64_t i = 0; i < n; i++) {
+        dist[i] = 1000000 + rand() % 1000000;
+        done[i] = false;
+        nodes[i] = pairing_heap_insert(h, dist[i], (void *)(uintptr_t)i);
+    }
+
+    while (pairing_heap_pop(h, &key, &payload) == 0) {
+        uint64_t id = (uintptr_t)payload;
+        done[id] = true;
+
+        for (int f = 0; f < DIJKSTRA_FANOUT; f++) {
+            uint64_t u = rand() % n;
+            uint64_t nd = key + 1 + rand() % 1000;
+            if (!done[u] && nd < dist[u]) {
+                dist[u] = nd;
+                pairing_heap_decrease_key(h, nodes[u], nd);
+            }
+        }
+    }
+
+done:
+    if (h) {
+        destroy_pairing_heap(h);
+    }
+    free(nodes);
+    return (start == 0) ? 0 : now_sec() - start;
+}
+
+/*
+ * Merge heavy trace: 'workers' queues of 'per_worker' entries are merged
+ * into one queue and drained, 'rounds' times over. Merge and drain times
+ * are reported separately.
+ */
+static void
+bench_merge_heap_t(uint64_t workers, uint64_t per_worker, int rounds,
+                   double *merge, double *drain)
+{
+    heap_t **heaps = (heap_t **)calloc(workers, sizeof(heap_t *));
+    heap_elem_t *top = NULL;
+
+    *merge = 0;
+    *drain = 0;
+    if (heaps == NULL) {
+        return;
+    }
+
+    srand(3);
+    for (int r = 0; r < rounds; r++) {
+        for (uint64_t w = 0; w < workers; w++) {
+            heaps[w] = create_heap_flags(MIN_HEAP, per_worker, HEAP_F_GROW);
+            for (uint64_t i = 0; i < per_worker; i++) {
+                heap_elem_t elem = {bench_rand()};
+                insert_heap(heaps[w], &elem);
+            }
+        }
+
+        double start = now_sec();
+        for (uint64_t w = 1; w < workers; w++) {
+            heap_push_batch(heaps[0], heaps[w]->h_arr, heaps[w]->h_curr_size);
+            destroy_heap(heaps[w]);
+        }
+        double mid = now_sec();
+        while ((top = get_min(heaps[0])) != NULL) {
+            delete_min(heaps[0], &top);
+        }
+        *merge += mid - start;
+        *drain += now_sec() - mid;
+        destroy_heap(heaps[0]);
+    }
+
+    free(heaps);
+}
+
+static void
+bench_merge_pairing_heap(uint64_t workers, uint64_t per_worker, int rounds,
+                         double *merge, double *drain)
+{
+    pairing_heap_t **heaps = NULL;
+
+    *merge = 0;
+    *drain = 0;
+    heaps = (pairing_heap_t **)calloc(workers, sizeof(pairing_heap_t *));
+    if (heaps == NULL) {
+        return;
+    }
+
+    srand(3);
+    for (int r = 0; r < rounds; r++) {
+        for (uint64_t w = 0; w < workers; w++) {
+            heaps[w] = create_pairing_heap(MIN_HEAP);
+            for (uint64_t i = 0; i < per_worker; i++) {
+                pairing_heap_insert(heaps[w], bench_rand(), NULL);
+            }
+        }
+
+        double start = now_sec();
+        for (uint64_t w = 1; w < workers; w++) {
+            pairing_heap_meld(heaps[0], heaps[w]);
+            destroy_pairing_heap(heaps[w]);
+        }
+        double mid = now_sec();
+        while (pairing_heap_pop(heaps[0], NULL, NULL) == 0) {
+        }
+        *merge += mid - start;
+        *drain += now_sec() - mid;
+        destroy_pairing_heap(heaps[0]);
+    }
+
+    free(heaps);
+}
+
+static void
+bench_pairing_heap(uint64_t n)
+{
+    uint64_t *dist = (uint64_t *)malloc(n * sizeof(uint64_t));
+    bool *done = (bool *)malloc(n * sizeof(bool));
+    const uint64_t workers = 64;
+    const int rounds = 4;
+    double merge = 0;
+    double drain = 0;
+
+    printf("\n\tBenchmarking pairing heap against heap_t...");
+
+    if (dist == NULL || done == NULL || n > DIJKSTRA_ID_MASK) {
+        printf("\n\t\tBad element count");
+        goto done;
+    }
+
+    printf("\n\t\tDijkstra trace, %llu ids, fanout %d:",
+           (unsigned long long)n, DIJKSTRA_FANOUT);
+    printf("\n\t\t\theap_t (lazy delete)  %8.3f s",
+           bench_dijkstra_heap_t(n, dist, done));
+    printf("\n\t\t\tpairing_heap          %8.3f s",
+           bench_dijkstra_pairing_heap(n, dist, done));
+
+    printf("\n\t\tMerge trace, %llu workers x %llu entries, %d rounds:",
+           (unsigned long long)workers, (unsigned long long)(n / workers),
+           rounds);
+    bench_merge_heap_t(workers, n / workers, rounds, &merge, &drain);
+    printf("\n\t\t\theap_t (batch push)   merge %8.4f s   drain %8.3f s",
+           merge, drain);
+    bench_merge_pairing_heap(workers, n / workers, rounds, &merge, &drain);
+    printf("\n\t\t\tpairing_heap (meld)   merge %8.4f s   drain %8.3f s",
+           merge, drain);
+
+done:
+    free(dist);
+    free(done);
+    printf("\n");
+}
+
+/*
+ * MultiQueue against a mutex protected heap_t. Every thread runs the
+ * same mix: alternate one insert and one delete-min on a prefilled queue.
+ */
+typedef struct mq_bench_arg_ {
+    multiqueue_t *mq;
+    heap_t *heap;
+    pthread_mutex_t *lock;
+    uint64_t ops;
+    uint64_t seed;
+} mq_bench_arg_t;
+
+static void *
+mq_bench_thread(void *arg)
+{
+    mq_bench_arg_t *t = (mq_bench_arg_t *)arg;
+    uint64_t x = t->seed;
+    heap_elem_t elem = {0};
+    heap_elem_t *top = NULL;
+
+    for (uint64_t i = 0; i < t->ops; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        elem.key = x >> 1;
+
+        if (t->mq) {
+            multiqueue_insert(t->mq, &elem);
+            multiqueue_delete_min(t->mq, &elem);
+        } else {
+            pthread_mutex_lock(t->lock);
+            insert_heap(t->heap, &elem);
+            top = get_min(t->heap);
+            delete_min(t->heap, &top);
+            pthread_mutex_unlock(t->lock);
+        }
+    }
+
+    return NULL;
+}
+
+static double
+bench_mq_run(int threads, uint64_t prefill, uint64_t ops, bool use_mq)
+{
+    pthread_t tids[threads];
+    mq_bench_arg_t args[threads];
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    multiqueue_t *mq = NULL;
+    heap_t *heap = NULL;
+    heap_elem_t elem = {0};
+    double start = 0;
+    double elapsed = 0;
+
+    if (use_mq) {
+        mq = create_multiqueue(threads, 2);
+    } else {
+        heap = create_heap_flags(MIN_HEAP, prefill * 2, HEAP_F_GROW);
+    }
+    if (mq == NULL && heap == NULL) {
+        return 0;
+    }
+
+    srand(4);
+    for (uint64_t i = 0; i < prefill; i++) {
+        elem.key = bench_rand();
+        if (mq) {
+            multiqueue_insert(mq, &elem);
+        } else {
+            insert_heap(heap, &elem);
+        }
+    }
+
+    start = now_sec();
+    for (int i = 0; i < threads; i++) {
+        args[i].mq = mq;
+        args[i].heap = heap;
+        args[i].lock = &lock;
+        args[i].ops = ops / threads;
+        args[i].seed = 0x9e3779b97f4a7c15ULL * (i + 1);
+        pthread_create(&tids[i], NULL, mq_bench_thread, &args[i]);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    elapsed = now_sec() - start;
+
+    if (mq) {
+        destroy_multiqueue(mq);
+    }
+    if (heap) {
+        destroy_heap(heap);
+    }
+
+    /* Each op is one insert plus one delete-min. */
+    return (2.0 * (ops / threads) * threads) / elapsed / 1e6;
+}
+
+/*
+ * Rank error: fill with keys 0..n-1, then pop everything and for each
+ * pop count how many smaller keys were still queued, using a Fenwick
+ * tree over the key space. This is a single threaded replay, so it
+ * measures the relaxation from pick-two sampling over c * P heaps and
+ * not the extra noise from thread interleaving.
+ */
+static void
+fenwick_add(int64_t *tree, uint64_t n, uint64_t i, int64_t delta)
+{
+    for (i++; i <= n; i += i & (~i + 1)) {
+        tree[i] += delta;
+    }
+}
+
+static int64_t
+fenwick_prefix(int64_t *tree, uint64_t i)
+{
+    int64_t sum = 0;
+
+    for (; i > 0; i -= i & (~i + 1)) {
+        sum += tree[i];
+    }
+    return sum;
+}
+
+static void
+bench_mq_rank_error(int threads, uint64_t n)
+{
+    multiqueue_t *mq = create_multiqueue(threads, 2);
+    int64_t *tree = (int64_t *)calloc(n + 1, sizeof(int64_t));
+    uint64_t *keys = (uint64_t *)malloc(n * sizeof(uint64_t));
+    heap_elem_t elem = {0};
+    double rank_sum = 0;
+    int64_t rank_max = 0;
+    uint64_t pops = 0;
+
+    if (mq == NULL || tree == NULL || keys == NULL) {
+        goto done;
+    }
+
+    for (uint64_t i = 0; i < n; i++) {
+        keys[i] = i;
+    }
+    srand(5);
+    for (uint64_t i = n - 1; i > 0; i--) {
+        uint64_t j = bench_rand() % (i + 1);
+        uint64_t temp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = temp;
+    }
+    for (uint64_t i = 0; i < n; i++) {
+        elem.key = keys[i];
+        multiqueue_insert(mq, &elem);
+        fenwick_add(tree, n, keys[i], 1);
+    }
+
+    while (multiqueue_delete_min(mq, &elem) == 0) {
+        int64_t rank = fenwick_prefix(tree, elem.key);
+        fenwick_add(tree, n, elem.key, -1);
+        rank_sum += rank;
+        if (rank > rank_max) {
+            rank_max = rank;
+        }
+        pops++;
+    }
+
+    printf("\n\t\t\tP=%-3d heaps=%-4llu mean rank error %8.2f   max %lld",
+           threads, (unsigned long long)multiqueue_num_heaps(mq),
+           rank_sum / pops, (long long)rank_max);
+
+done:
+    if (mq) {
+        destroy_multiqueue(mq);
+    }
+    free(tree);
+    free(keys);
+}
+
+static void
+bench_multiqueue(uint64_t n)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = (cpus > 1) ? (int)cpus * 2 : 8;
+
+    printf("\n\tBenchmarking MultiQueue against locked heap_t (%ld cpus)...",
+           cpus);
+    printf("\n\t\tThroughput, %llu prefilled, Mops/s:", (unsigned long long)n);
+
+    for (int t = 1; t <= max_threads; t *= 2) {
+        printf("\n\t\t\tthreads %-3d locked heap_t %8.2f   multiqueue %8.2f",
+               t, bench_mq_run(t, n, n, false), bench_mq_run(t, n, n, true));
+    }
+
+    printf("\n\t\tRank error over %llu pops (c = 2):", (unsigned long long)n);
+    for (int t = 1; t <= max_threads; t *= 2) {
+        bench_mq_rank_error(t, n);
+    }
+
+    printf("\n");
+}
+
+/*
+ * Timeout trace: schedule 'n' timers within TW_BENCH_HORIZON ticks,
+ * cancel every other one, then advance the clock until all expire. The
+ * indexed heap stands in for heap_t on cancel, since delete_heap is a
+ * linear scan; plain heap_t is timed on schedule and expiry only.
+ */
+#define TW_BENCH_HORIZON    (1ULL << 20)
+
+static void
+bench_tw_wheel(uint64_t n, uint64_t *expiry)
+{
+    timing_wheel_t *tw = create_timing_wheel(0);
+    tw_timer_t *timers = (tw_timer_t *)malloc(n * sizeof(tw_timer_t));
+    uint64_t fired = 0;
+
+    if (tw == NULL || timers == NULL) {
+        printf("\n\t\t\tFailed to allocate timing wheel");
+        goto done;
+    }
+
+    double start = now_sec();
+    for (uint64_t i = 0; i < n; i++) {
+        tw_timer_init(&timers[i], NULL);
+        timing_wheel_schedule(tw, &timers[i], expiry[i]);
+    }
+    double scheduled = now_sec();
+    for (uint64_t i = 0; i < n; i += 2) {
+        timing_wheel_cancel(tw, &timers[i]);
+    }
+    double cancelled = now_sec();
+    fired = timing_wheel_advance(tw, TW_BENCH_HORIZON, NULL);
+    double end = now_sec();
+
+    printf("\n\t\t\ttiming wheel   schedule %7.3f s  cancel %7.3f s  "
+           "expire %7.3f s  (%llu fired)", scheduled - start,
+           cancelled - scheduled, end - cancelled, (unsigned long long)fired);
+
+done:
+    if (tw) {
+        destroy_timing_wheel(tw);
+    }
+    free(timers);
+}
+
+static void
+bench_tw_idx_heap(uint64_t n, uint64_t *expiry)
+{
+    idx_heap_t *h = create_idx_heap(MIN_HEAP, n);
+    idx_heap_elem_t top = {0};
+    uint64_t fired = 0;
+
+    if (h == NULL) {
+        printf("\n\t\t\tFailed to allocate indexed heap");
+        return;
+    }
+
+    double start = now_sec();
+    for (uint64_t i = 0; i < n; i++) {
+        idx_heap_insert(h, i, expiry[i], NULL);
+    }
+    double scheduled = now_sec();
+    for (uint64_t i = 0; i < n; i += 2) {
+        idx_heap_remove(h, i, NULL);
+    }
+    double cancelled = now_sec();
+    for (uint64_t tick = 0; tick <= TW_BENCH_HORIZON; tick++) {
+        while (idx_heap_peek(h, &top) == 0 && top.priority <= tick) {
+            idx_heap_pop(h, NULL);
+            fired++;
+        }
+    }
+    double end = now_sec();
+
+    printf("\n\t\t\tindexed heap   schedule %7.3f s  cancel %7.3f s  "
+           "expire %7.3f s  (%llu fired)", scheduled - start,
+           cancelled - scheduled, end - cancelled, (unsigned long long)fired);
+    destroy_idx_heap(h);
+}
+
+static void
+bench_tw_heap_t(uint64_t n, uint64_t *expiry)
+{
+    heap_t *h = create_heap_flags(MIN_HEAP, n, HEAP_F_GROW);
+    heap_elem_t elem = {0};
+    heap_elem_t *top = NULL;
+    uint64_t fired = 0;
+
+    if (h == NULL) {
+        printf("\n\t\t\tFailed to allocate heap_t");
+        return;
+    }
+
+    double start = now_sec();
+    for (uint64_t i = 1; i < n; i += 2) {
+        elem.key = expiry[i];
+        insert_heap(h, &elem);
+    }
+    double scheduled = now_sec();
+    for (uint64_t tick = 0; tick <= TW_BENCH_HORIZON; tick++) {
+        while ((top = get_min(h)) != NULL && top->key <= tick) {
+            delete_min(h, &top);
+            fired++;
+        }
+    }
+    double end = now_sec();
+
+    printf("\n\t\t\theap_t         schedule %7.3f s  cancel     n/a    "
+           "expire %7.3f s  (%llu fired, survivors only)",
+           scheduled - start, end - scheduled, (unsigned long long)fired);
+    destroy_heap(h);
+}
+
+static void
+bench_timing_wheel(uint64_t n)
+{
+    uint64_t *expiry = (uint64_t *)malloc(n * sizeof(uint64_t));
+
+    printf("\n\tBenchmarking timing wheel against heaps...");
+
+    if (expiry == NULL) {
+        printf("\n\t\tFailed to allocate expiries");
+        return;
+    }
+
+    srand(6);
+    for (uint64_t i = 0; i < n; i++) {
+        expiry[i] = 1 + bench_rand() % (TW_BENCH_HORIZON - 1);
+    }
+
+    printf("\n\t\t%llu timers over %llu ticks, half cancelled:",
+           (unsigned long long)n, (unsigned long long)TW_BENCH_HORIZON);
+    bench_tw_wheel(n, expiry);
+    bench_tw_idx_heap(n, expiry);
+    bench_tw_heap_t(n, expiry);
+
+    free(expiry);
+    printf("\n");
+}
+
+/*
+ * Select the top TOPK_BENCH_K of 'n' random values: a full quick_sort,
+ * top_k, and partial_sort, against a plain summing pass over the same
+ * array as the memory bandwidth floor.
+ */
+#define TOPK_BENCH_K    100
+
+static void
+bench_top_k(uint64_t n)
+{
+    int64_t *arr = (int64_t *)malloc(n * sizeof(int64_t));
+    int64_t *work = (int64_t *)malloc(n * sizeof(int64_t));
+    int64_t out[TOPK_BENCH_K];
+    volatile int64_t sink = 0;
+    int64_t sum = 0;
+    double start = 0;
+
+    printf("\n\tBenchmarking top-K selection, K = %d...", TOPK_BENCH_K);
+
+    if (arr == NULL || work == NULL || n < TOPK_BENCH_K) {
+        printf("\n\t\tFailed to set up input");
+        goto done;
+    }
+
+    srand(7);
+    for (uint64_t i = 0; i < n; i++) {
+        arr[i] = (int64_t)bench_rand() - (1LL << 61);
+    }
+
+    start = now_sec();
+    for (uint64_t i = 0; i < n; i++) {
+        sum += arr[i];
+    }
+    sink = sum;
+    printf("\n\t\tscan          %8.3f s", now_sec() - start);
+
+    start = now_sec();
+    top_k(arr, (int)n, TOPK_BENCH_K, out);
+    printf("\n\t\ttop_k         %8.3f s  (max %lld)", now_sec() - start,
+           (long long)out[0]);
+
+    for (uint64_t i = 0; i < n; i++) {
+        work[i] = arr[i];
+    }
+    start = now_sec();
+    partial_sort(work, (int)n, TOPK_BENCH_K);
+    printf("\n\t\tpartial_sort  %8.3f s  (min %lld)", now_sec() - start,
+           (long long)work[0]);
+
+    for (uint64_t i = 0; i < n; i++) {
+        work[i] = arr[i];
+    }
+    start = now_sec();
+    quick_sort(work, (int)n);
+    printf("\n\t\tquick_sort    %8.3f s  (max %lld)", now_sec() - start,
+           (long long)work[n - 1]);
+
+done:
+    (void)sink;
+    free(arr);
+    free(work);
+    printf("\n");
+}
+
+/*
+ * Merge 'n' values spread over K sorted runs into 4096 value blocks, for
+ * K from 2 to 1024, against memcpy of the same data as the bandwidth
+ * ceiling.
+ */
+#define KWAY_BENCH_BLOCK    4096
+#define KWAY_BENCH_MAX_K    1024
+
+static int kway_bench_k[] = {2, 16, 128, KWAY_BENCH_MAX_K};
+
+static void
+bench_kway_merge(uint64_t n)
+{
+    int64_t *data = (int64_t *)malloc(n * sizeof(int64_t));
+    int64_t *copy = (int64_t *)malloc(n * sizeof(int64_t));
+    kway_array_run_t *array_runs = (kway_array_run_t *)
+        malloc(KWAY_BENCH_MAX_K * sizeof(kway_array_run_t));
+    kway_run_t *runs = (kway_run_t *)
+        malloc(KWAY_BENCH_MAX_K * sizeof(kway_run_t));
+    int64_t block[KWAY_BENCH_BLOCK];
+    double start = 0;
+    double memcpy_sec = 0;
+
+    printf("\n\tBenchmarking K-way merge of %llu values...",
+           (unsigned long long)n);
+
+    if (data == NULL || copy == NULL || array_runs == NULL || runs == NULL) {
+        printf("\n\t\tFailed to allocate runs");
+        goto done;
+    }
+
+    /* Fault both arrays in before timing the copy. */
+    memset(data, 0, n * sizeof(int64_t));
+    memset(copy, 0, n * sizeof(int64_t));
+    start = now_sec();
+    memcpy(copy, data, n * sizeof(int64_t));
+    memcpy_sec = now_sec() - start;
+    printf("\n\t\tmemcpy         %8.3f s", memcpy_sec);
+
+    for (int t = 0; t < sizeof(kway_bench_k) / sizeof(int); t++) {
+        int k = kway_bench_k[t];
+        uint64_t run_len = n / k;
+        uint64_t merged = 0;
+        int64_t checksum = 0;
+        kway_merge_t *m = NULL;
+        int count = 0;
+
+        /* Each run is an ascending random walk over its slice of data. */
+        srand(8);
+        for (int r = 0; r < k; r++) {
+            int64_t value = 0;
+            for (uint64_t i = 0; i < run_len; i++) {
+                value += rand() % 64;
+                data[r * run_len + i] = value;
+            }
+            array_runs[r].arr = &data[r * run_len];
+            array_runs[r].len = (int)run_len;
+            array_runs[r].pos = 0;
+            runs[r].read = kway_array_read;
+            runs[r].ctx = &array_runs[r];
+        }
+
+        start = now_sec();
+        m = create_kway_merge(runs, k, 0);
+        if (m == NULL) {
+            printf("\n\t\tFailed to create merge for K = %d", k);
+            continue;
+        }
+        do {
+            kway_merge_next_block(m, block, KWAY_BENCH_BLOCK, &count);
+            merged += count;
+            if (count) {
+                checksum += block[count - 1];
+            }
+        } while (count > 0);
+        double sec = now_sec() - start;
+        destroy_kway_merge(m);
+
+        printf("\n\t\tK = %4d       %8.3f s  %6.1f M values/s  "
+               "(%llu merged, check %lld)", k, sec, merged / sec / 1e6,
+               (unsigned long long)merged, (long long)checksum);
+    }
+
+done:
+    free(data);
+    free(copy);
+    free(array_runs);
+    free(runs);
+    printf("\n");
+}
+
+/*
+ * Hand 'n' uint64_t messages from a producer thread to the main thread,
+ * through a mutex wrapped simple_q, through the SPSC ring one message at
+ * a time, and through the SPSC ring in reserve/commit batches. Then
+ * bounce one message between two threads over a pair of rings to get
+ * the round trip latency. Threads are pinned to CPUs 0 and 1 when there
+ * are two.
+ */
+#define SPSC_BENCH_RING     4096
+#define SPSC_BENCH_BATCH    64
+
+typedef enum spsc_bench_mode_ {
+    SPSC_BENCH_LOCKED = 0,
+    SPSC_BENCH_SINGLE,
+    SPSC_BENCH_BATCH_MODE,
+} spsc_bench_mode_e;
+
+typedef struct spsc_bench_arg_ {
+    spsc_bench_mode_e mode;
+    spsc_ring_t *ring;
+    spsc_ring_t *reply;
+    simple_q *q;
+    pthread_mutex_t *lock;
+    uint64_t n;
+    int cpu;
+} spsc_bench_arg_t;
+
+/*
+ * Thread affinity is a glibc extension; elsewhere threads are left
+ * wherever the scheduler puts them.
+ */
+static void
+bench_pin_cpu(int cpu)
+{
+#ifdef __linux__
+    cpu_set_t set;
+
+    if (cpu < 0 || sysconf(_SC_NPROCESSORS_ONLN) < 2) {
+        return;
+    }
+
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+/*
+ * Back off after a failed attempt. Spinning is right when the other side
+ * runs on its own core; the periodic yield keeps a single CPU box from
+ * burning whole time slices.
+ */
+static void
+bench_backoff(uint64_t *spins)
+{
+    if ((++*spins % 64) == 0) {
+        sched_yield();
+    }
+}
+
+static void *
+spsc_bench_producer(void *arg)
+{
+    spsc_bench_arg_t *a = (spsc_bench_arg_t *)arg;
+    uint64_t spins = 0;
+    uint64_t got = 0;
+    uint64_t i = 0;
+
+    bench_pin_cpu(a->cpu);
+
+    while (i < a->n) {
+        int error = 0;
+
+        switch (a->mode) {
+            case SPSC_BENCH_LOCKED:
+                pthread_mutex_lock(a->lock);
+                error = simple_q_enqueue(a->q, i);
+                pthread_mutex_unlock(a->lock);
+                if (error == 0) {
+                    i++;
+                    continue;
+                }
+                break;
+            case SPSC_BENCH_SINGLE:
+                if (spsc_ring_push(a->ring, &i) == 0) {
+                    i++;
+                    continue;
+                }
+                break;
+            case SPSC_BENCH_BATCH_MODE: {
+                uint64_t want = a->n - i;
+                uint64_t *slots = NULL;
+
+                if (want > SPSC_BENCH_BATCH) {
+                    want = SPSC_BENCH_BATCH;
+                }
+                slots = spsc_ring_reserve(a->ring, want, &got);
+                for (uint64_t j = 0; j < got; j++) {
+                    slots[j] = i++;
+                }
+                if (got) {
+                    spsc_ring_commit(a->ring, got);
+                    continue;
+                }
+                break;
+            }
+        }
+        bench_backoff(&spins);
+    }
+
+    return NULL;
+}
+
+static double
+bench_spsc_throughput(spsc_bench_mode_e mode, uint64_t n)
+{
+    spsc_bench_arg_t arg = {0};
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    pthread_t producer;
+    uint64_t expected = 0;
+    uint64_t value = 0;
+    uint64_t spins = 0;
+    uint64_t got = 0;
+    double start = 0;
+    double elapsed = 0;
+
+    arg.mode = mode;
+    arg.n = n;
+    arg.cpu = 1;
+    arg.lock = &lock;
+    if (mode == SPSC_BENCH_LOCKED) {
+        arg.q = create_simple_q(SPSC_BENCH_RING);
+    } else {
+        arg.ring = create_spsc_ring(SPSC_BENCH_RING, sizeof(uint64_t));
+    }
+    if (arg.q == NULL && arg.ring == NULL) {
+        return 0;
+    }
+
+    bench_pin_cpu(0);
+    start = now_sec();
+    pthread_create(&producer, NULL, spsc_bench_producer, &arg);
+
+    while (expected < n) {
+        int error = 0;
+
+        if (mode == SPSC_BENCH_LOCKED) {
+            pthread_mutex_lock(&lock);
+            error = simple_q_dequeue(arg.q, &value);
+            pthread_mutex_unlock(&lock);
+            got = (error == 0);
+        } else if (mode == SPSC_BENCH_SINGLE) {
+            got = (spsc_ring_pop(arg.ring, &value) == 0);
+        } else {
+            uint64_t *slots = spsc_ring_peek(arg.ring, SPSC_BENCH_BATCH,
+                                             &got);
+            if (got) {
+                value = slots[got - 1];
+                spsc_ring_release(arg.ring, got);
+            }
+        }
+
+        if (got == 0) {
+            bench_backoff(&spins);
+            continue;
+        }
+        expected += got;
+        if (value != expected - 1) {
+            printf("\n\t\t\tOut of order: got %llu, expected %llu",
+                   (unsigned long long)value,
+                   (unsigned long long)(expected - 1));
+            break;
+        }
+    }
+
+    pthread_join(producer, NULL);
+    elapsed = now_sec() - start;
+
+    if (arg.q) {
+        destroy_simple_q(arg.q);
+    }
+    if (arg.ring) {
+        destroy_spsc_ring(arg.ring);
+    }
+    return elapsed;
+}
+
+static void *
+spsc_bench_pong(void *arg)
+{
+    spsc_bench_arg_t *a = (spsc_bench_arg_t *)arg;
+    uint64_t spins = 0;
+    uint64_t value = 0;
+
+    bench_pin_cpu(a->cpu);
+
+    for (uint64_t i = 0; i < a->n; i++) {
+        while (spsc_ring_pop(a->ring, &value) != 0) {
+            bench_backoff(&spins);
+        }
+        while (spsc_ring_push(a->reply, &value) != 0) {
+            bench_backoff(&spins);
+        }
+    }
+
+    return NULL;
+}
+
+static double
+bench_spsc_round_trip(uint64_t rounds)
+{
+    spsc_bench_arg_t arg = {0};
+    pthread_t pong;
+    uint64_t spins = 0;
+    uint64_t value = 0;
+    double start = 0;
+    double elapsed = 0;
+
+    arg.ring = create_spsc_ring(SPSC_BENCH_RING, sizeof(uint64_t));
+    arg.reply = create_spsc_ring(SPSC_BENCH_RING, sizeof(uint64_t));
+    arg.n = rounds;
+    arg.cpu = 1;
+    if (arg.ring == NULL || arg.reply == NULL) {
+        goto done;
+    }
+
+    bench_pin_cpu(0);
+    pthread_create(&pong, NULL, spsc_bench_pong, &arg);
+
+    start = now_sec();
+    for (uint64_t i = 0; i < rounds; i++) {
+        spsc_ring_push(arg.ring, &i);
+        while (spsc_ring_pop(arg.reply, &value) != 0) {
+            bench_backoff(&spins);
+        }
+    }
+    elapsed = now_sec() - start;
+
+    pthread_join(pong, NULL);
+
+done:
+    if (arg.ring) {
+        destroy_spsc_ring(arg.ring);
+    }
+    if (arg.reply) {
+        destroy_spsc_ring(arg.reply);
+    }
+    return elapsed;
+}
+
+static void
+bench_spsc(uint64_t n)
+{
+    const char *names[] = {"locked simple_q", "spsc push/pop", "spsc batched"};
+    uint64_t rounds = n / 10 ? n / 10 : 1;
+    double sec = 0;
+
+    printf("\n\tBenchmarking SPSC ring, %llu messages, %ld CPUs...",
+           (unsigned long long)n, sysconf(_SC_NPROCESSORS_ONLN));
+
+    for (int mode = SPSC_BENCH_LOCKED; mode <= SPSC_BENCH_BATCH_MODE;
+         mode++) {
+        sec = bench_spsc_throughput((spsc_bench_mode_e)mode, n);
+        printf("\n\t\t%-16s %8.3f s  %7.2f M msgs/s", names[mode], sec,
+               n / sec / 1e6);
+    }
+
+    sec = bench_spsc_round_trip(rounds);
+    printf("\n\t\tround trip       %8.3f s  %7.0f ns per round trip",
+           sec, sec / rounds * 1e9);
+    printf("\n");
+}
+
+/*
+ * Move 'n' messages from P producers to C consumers through a mutex
+ * wrapped simple_q, the MPMC queue one message at a time, and the MPMC
+ * queue in batches, for several producer/consumer ratios.
+ */
+#define MPMC_BENCH_QUEUE    4096
+#define MPMC_BENCH_BATCH    32
+
+typedef struct mpmc_bench_arg_ {
+    spsc_bench_mode_e mode;
+    mpmc_queue_t *q;
+    simple_q *sq;
+    pthread_mutex_t *lock;
+    _Atomic uint64_t *consumed;
+    uint64_t n;
+    uint64_t total;
+} mpmc_bench_arg_t;
+
+static void *
+mpmc_bench_producer(void *arg)
+{
+    mpmc_bench_arg_t *a = (mpmc_bench_arg_t *)arg;
+    uint64_t batch[MPMC_BENCH_BATCH];
+    uint64_t spins = 0;
+    uint64_t done = 0;
+    uint64_t i = 0;
+
+    for (int j = 0; j < MPMC_BENCH_BATCH; j++) {
+        batch[j] = j;
+    }
+
+    while (i < a->n) {
+        int error = 0;
+
+        if (a->mode == SPSC_BENCH_LOCKED) {
+            pthread_mutex_lock(a->lock);
+            error = simple_q_enqueue(a->sq, i);
+            pthread_mutex_unlock(a->lock);
+            done = (error == 0);
+        } else if (a->mode == SPSC_BENCH_SINGLE) {
+            done = (mpmc_queue_try_enqueue(a->q, &i) == 0);
+        } else {
+            uint64_t want = a->n - i;
+            if (want > MPMC_BENCH_BATCH) {
+                want = MPMC_BENCH_BATCH;
+            }
+            mpmc_queue_try_enqueue_batch(a->q, batch, want, &done);
+        }
+
+        if (done == 0) {
+            bench_backoff(&spins);
+            continue;
+        }
+        i += done;
+    }
+
+    return NULL;
+}
+
+static void *
+mpmc_bench_consumer(void *arg)
+{
+    mpmc_bench_arg_t *a = (mpmc_bench_arg_t *)arg;
+    uint64_t batch[MPMC_BENCH_BATCH];
+    uint64_t spins = 0;
+    uint64_t done = 0;
+
+    while (atomic_load_explicit(a->consumed, memory_order_relaxed) <
+           a->total) {
+        int error = 0;
+
+        if (a->mode == SPSC_BENCH_LOCKED) {
+            pthread_mutex_lock(a->lock);
+            error = simple_q_dequeue(a->sq, &batch[0]);
+            pthread_mutex_unlock(a->lock);
+            done = (error == 0);
+        } else if (a->mode == SPSC_BENCH_SINGLE) {
+            done = (mpmc_queue_try_dequeue(a->q, &batch[0]) == 0);
+        } else {
+            mpmc_queue_try_dequeue_batch(a->q, batch, MPMC_BENCH_BATCH,
+                                         &done);
+        }
+
+        if (done == 0) {
+            bench_backoff(&spins);
+            continue;
+        }
+        atomic_fetch_add_explicit(a->consumed, done, memory_order_relaxed);
+    }
+
+    return NULL;
+}
+
+static double
+bench_mpmc_run(spsc_bench_mode_e mode, int producers, int consumers,
+               uint64_t n)
+{
+    pthread_t tids[producers + consumers];
+    mpmc_bench_arg_t args[producers + consumers];
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    _Atomic uint64_t consumed = 0;
+    mpmc_queue_t *q = NULL;
+    simple_q *sq = NULL;
+    uint64_t per_producer = n / producers;
+    double start = 0;
+    double elapsed = 0;
+
+    if (mode == SPSC_BENCH_LOCKED) {
+        sq = create_simple_q(MPMC_BENCH_QUEUE);
+    } else {
+        q = create_mpmc_queue(MPMC_BENCH_QUEUE, sizeof(uint64_t));
+    }
+    if (q == NULL && sq == NULL) {
+        return 0;
+    }
+
+    start = now_sec();
+    for (int i = 0; i < producers + consumers; i++) {
+        args[i].mode = mode;
+        args[i].q = q;
+        args[i].sq = sq;
+        args[i].lock = &lock;
+        args[i].consumed = &consumed;
+        args[i].n = per_producer;
+        args[i].total = per_producer * producers;
+        pthread_create(&tids[i], NULL,
+                       (i < producers) ? mpmc_bench_producer :
+                                         mpmc_bench_consumer, &args[i]);
+    }
+    for (int i = 0; i < producers + consumers; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    elapsed = now_sec() - start;
+
+    if (q) {
+        destroy_mpmc_queue(q);
+    }
+    if (sq) {
+        destroy_simple_q(sq);
+    }
+    return elapsed;
+}
+
+static void
+bench_mpmc(uint64_t n)
+{
+    const char *names[] = {"locked simple_q", "mpmc single", "mpmc batched"};
+    const int ratios[][2] = {{1, 1}, {1, 3}, {3, 1}, {2, 2}, {4, 4}};
+
+    printf("\n\tBenchmarking MPMC queue, %llu messages, %ld CPUs...",
+           (unsigned long long)n, sysconf(_SC_NPROCESSORS_ONLN));
+
+    for (int r = 0; r < sizeof(ratios) / sizeof(ratios[0]); r++) {
+        printf("\n\t\t%d producers : %d consumers", ratios[r][0],
+               ratios[r][1]);
+        for (int mode = SPSC_BENCH_LOCKED; mode <= SPSC_BENCH_BATCH_MODE;
+             mode++) {
+            double sec = bench_mpmc_run((spsc_bench_mode_e)mode,
+                                        ratios[r][0], ratios[r][1], n);
+            printf("\n\t\t\t%-16s %8.3f s  %7.2f M msgs/s", names[mode],
+                   sec, n / sec / 1e6);
+        }
+    }
+    printf("\n");
+}
+
+/*
+ * Move 'n' 64 byte messages from producer processes to this one, over a
+ * pipe (a length word and the payload per message, as the pipeline does
+ * today) and over shm_q in its SPSC and MPSC modes.
+ */
+#define IPC_BENCH_MSG       64
+#define IPC_BENCH_RING      (1 << 20)
+
+typedef enum ipc_bench_mode_ {
+    IPC_BENCH_PIPE,
+    IPC_BENCH_SHM_SPSC,
+    IPC_BENCH_SHM_MPSC,
+} ipc_bench_mode_e;
+
+static bool
+bench_read_full(int fd, void *buf, size_t len)
+{
+    uint8_t *p = (uint8_t *)buf;
+
+    while (len) {
+        ssize_t got = read(fd, p, len);
+        if (got <= 0) {
+            return false;
+        }
+        p += got;
+        len -= (size_t)got;
+    }
+    return true;
+}
+
+static void
+bench_ipc_producer(ipc_bench_mode_e mode, const char *name, int fd,
+                   uint64_t first, uint64_t count)
+{
+    uint8_t buf[sizeof(uint32_t) + IPC_BENCH_MSG] = {0};
+    uint32_t len = IPC_BENCH_MSG;
+    shm_q *q = NULL;
+    uint64_t spins = 0;
+
+    if (mode != IPC_BENCH_PIPE) {
+        q = open_shm_q(name);
+        if (q == NULL) {
+            _exit(1);
+        }
+    }
+
+    memcpy(buf, &len, sizeof(len));
+    for (uint64_t seq = first; seq < first + count; seq++) {
+        if (mode == IPC_BENCH_PIPE) {
+            memcpy(buf + sizeof(len), &seq, sizeof(seq));
+            if (write(fd, buf, sizeof(buf)) != sizeof(buf)) {
+                _exit(1);
+            }
+            continue;
+        }
+
+        uint8_t *msg = NULL;
+        while ((msg = shm_q_reserve(q, IPC_BENCH_MSG)) == NULL) {
+            bench_backoff(&spins);
+        }
+        memcpy(msg, &seq, sizeof(seq));
+        shm_q_commit(q, msg);
+    }
+
+    if (q) {
+        destroy_shm_q(q);
+    }
+    _exit(0);
+}
+
+static double
+bench_ipc_run(ipc_bench_mode_e mode, int producers, uint64_t n)
+{
+    char name[64];
+    uint8_t buf[IPC_BENCH_MSG];
+    pid_t pids[4];
+    int fds[2] = {-1, -1};
+    shm_q *q = NULL;
+    uint64_t sum = 0;
+    uint64_t spins = 0;
+    uint32_t len = 0;
+    double start = 0;
+    double elapsed = -1;
+
+    snprintf(name, sizeof(name), "/dsa_ipc_bench_%d", (int)getpid());
+    if (mode == IPC_BENCH_PIPE) {
+        if (pipe(fds) != 0) {
+            goto done;
+        }
+    } else {
+        q = create_shm_q(name, IPC_BENCH_RING,
+                         mode == IPC_BENCH_SHM_SPSC ? SHM_Q_F_SPSC : 0);
+        if (q == NULL) {
+            goto done;
+        }
+    }
+
+    start = now_sec();
+    for (int p = 0; p < producers; p++) {
+        pids[p] = fork();
+        if (pids[p] == 0) {
+            bench_ipc_producer(mode, name, fds[1], p * (n / producers),
+                               n / producers);
+        }
+    }
+
+    for (uint64_t i = 0; i < n / producers * producers; i++) {
+        uint64_t seq = 0;
+
+        if (mode == IPC_BENCH_PIPE) {
+            if (!bench_read_full(fds[0], &len, sizeof(len)) ||
+                !bench_read_full(fds[0], buf, len)) {
+                break;
+            }
+            memcpy(&seq, buf, sizeof(seq));
+        } else {
+            uint8_t *msg = NULL;
+            while ((msg = shm_q_peek(q, &len)) == NULL) {
+                bench_backoff(&spins);
+            }
+            memcpy(&seq, msg, sizeof(seq));
+            shm_q_release(q);
+        }
+        sum += seq;
+    }
+    elapsed = now_sec() - start;
+
+    for (int p = 0; p < producers; p++) {
+        waitpid(pids[p], NULL, 0);
+    }
+
+    /* Keep the consumer honest about having read every payload. */
+    if (sum != (n / producers * producers) *
+               (n / producers * producers - 1) / 2) {
+        printf("\n\t\t\tchecksum mismatch");
+    }
+
+done:
+    if (fds[0] >= 0) {
+        close(fds[0]);
+        close(fds[1]);
+    }
+    if (q) {
+        destroy_shm_q(q);
+    }
+    return elapsed;
+}
+
+static void
+bench_ipc(uint64_t n)
+{
+    const struct {
+        const char *name;
+        ipc_bench_mode_e mode;
+        int producers;
+    } runs[] = {
+        {"pipe", IPC_BENCH_PIPE, 1},
+        {"shm_q spsc", IPC_BENCH_SHM_SPSC, 1},
+        {"shm_q mpsc x1", IPC_BENCH_SHM_MPSC, 1},
+        {"shm_q mpsc x2", IPC_BENCH_SHM_MPSC, 2},
+        {"shm_q mpsc x4", IPC_BENCH_SHM_MPSC, 4},
+    };
+
+    printf("\n\tBenchmarking shared memory IPC, %llu messages of %d bytes, "
+           "%ld CPUs...", (unsigned long long)n, IPC_BENCH_MSG,
+           sysconf(_SC_NPROCESSORS_ONLN));
+
+    for (int r = 0; r < sizeof(runs) / sizeof(runs[0]); r++) {
+        double sec = bench_ipc_run(runs[r].mode, runs[r].producers, n);
+        printf("\n\t\t%-16s %8.3f s  %7.2f M msgs/s", runs[r].name, sec,
+               n / sec / 1e6);
+    }
+    printf("\n");
+}
+
+/*
+ * Free list contention: every thread pops a buffer and pushes it back,
+ * 'n' times in total, against a mutex wrapped dsa_stack and the Treiber
+ * stack with and without elimination.
+ */
+#define FREELIST_BENCH_NODES    1024
+#define FREELIST_BENCH_MAX_THREADS  8
+
+typedef enum freelist_bench_mode_ {
+    FREELIST_BENCH_LOCKED,
+    FREELIST_BENCH_TREIBER,
+    FREELIST_BENCH_ELIMINATE,
+} freelist_bench_mode_e;
+
+typedef struct freelist_bench_arg_ {
+    freelist_bench_mode_e mode;
+    treiber_stack_t *ts;
+    dsa_stack_t *ds;
+    pthread_mutex_t *lock;
+    uint64_t ops;
+    int cpu;
+} freelist_bench_arg_t;
+
+static void *
+freelist_bench_worker(void *arg)
+{
+    freelist_bench_arg_t *a = (freelist_bench_arg_t *)arg;
+    uint64_t spins = 0;
+
+    bench_pin_cpu(a->cpu);
+
+    for (uint64_t i = 0; i < a->ops; i++) {
+        if (a->mode == FREELIST_BENCH_LOCKED) {
+            uint64_t buf = 0;
+
+            pthread_mutex_lock(a->lock);
+            dsa_stack_pop(a->ds, &buf);
+            pthread_mutex_unlock(a->lock);
+
+            pthread_mutex_lock(a->lock);
+            dsa_stack_push(a->ds, buf);
+            pthread_mutex_unlock(a->lock);
+        } else {
+            treiber_node_t *node = NULL;
+
+            while (treiber_stack_pop(a->ts, &node) != 0) {
+                bench_backoff(&spins);
+            }
+            treiber_stack_push(a->ts, node);
+        }
+    }
+
+    return NULL;
+}
+
+static double
+bench_freelist_run(freelist_bench_mode_e mode, int threads, uint64_t n,
+                   treiber_node_t *nodes)
+{
+    pthread_t tids[FREELIST_BENCH_MAX_THREADS];
+    freelist_bench_arg_t args[FREELIST_BENCH_MAX_THREADS];
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    treiber_stack_t *ts = NULL;
+    dsa_stack_t *ds = NULL;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    double start = 0;
+    double elapsed = -1;
+
+    if (mode == FREELIST_BENCH_LOCKED) {
+        ds = create_dsa_stack(FREELIST_BENCH_NODES);
+        if (ds == NULL) {
+            goto done;
+        }
+        for (int i = 0; i < FREELIST_BENCH_NODES; i++) {
+            dsa_stack_push(ds, (uint64_t)(uintptr_t)&nodes[i]);
+        }
+    } else {
+        ts = create_treiber_stack(mode == FREELIST_BENCH_ELIMINATE ?
+                                  TREIBER_F_ELIMINATE : 0);
+        if (ts == NULL) {
+            goto done;
+        }
+        for (int i = 0; i < FREELIST_BENCH_NODES; i++) {
+            treiber_stack_push(ts, &nodes[i]);
+        }
+    }
+
+    start = now_sec();
+    for (int t = 0; t < threads; t++) {
+        args[t] = (freelist_bench_arg_t){mode, ts, ds, &lock, n / threads,
+                                         (int)(t % (cpus > 0 ? cpus : 1))};
+        pthread_create(&tids[t], NULL, freelist_bench_worker, &args[t]);
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    elapsed = now_sec() - start;
+
+done:
+    if (ts) {
+        destroy_treiber_stack(ts);
+    }
+    if (ds) {
+        destroy_dsa_stack(ds);
+    }
+    return elapsed;
+}
+
+static void
+bench_freelist(uint64_t n)
+{
+    const char *names[] = {"locked dsa_stack", "treiber", "treiber elim"};
+    const int threads[] = {1, 2, 4, FREELIST_BENCH_MAX_THREADS};
+    treiber_node_t *nodes = NULL;
+
+    printf("\n\tBenchmarking shared free list, %llu pop/push pairs, "
+           "%ld CPUs...", (unsigned long long)n,
+           sysconf(_SC_NPROCESSORS_ONLN));
+
+    nodes = (treiber_node_t *)calloc(FREELIST_BENCH_NODES,
+                                     sizeof(treiber_node_t));
+    if (nodes == NULL) {
+        goto done;
+    }
+
+    for (int t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        printf("\n\t\t%d threads", threads[t]);
+        for (int mode = FREELIST_BENCH_LOCKED;
+             mode <= FREELIST_BENCH_ELIMINATE; mode++) {
+            double sec = bench_freelist_run((freelist_bench_mode_e)mode,
+                                            threads[t], n, nodes);
+            printf("\n\t\t\t%-16s %8.3f s  %7.2f M pairs/s", names[mode],
+                   sec, n / sec / 1e6);
+        }
+    }
+
+done:
+    free(nodes);
+    printf("\n");
+}
+
+/*
+ * Insert, find and delete 'n' keys in sorted, reverse sorted and random
+ * order. insert_to_bst runs on the same streams for comparison, capped
+ * at BST_BENCH_CAP keys for the ordered ones, where it degenerates into
+ * a list and costs O(n^2); each of those trees is then rebalanced. The
+ * sorted stream is also loaded with bst_build_from_sorted.
+ */
+#define BST_BENCH_CAP       10000
+
+static int
+bench_bst_depth(bt_node *n)
+{
+    int l = 0;
+    int r = 0;
+
+    if (n == NULL) {
+        return 0;
+    }
+    l = bench_bst_depth(n->left);
+    r = bench_bst_depth(n->right);
+    return 1 + (l > r ? l : r);
+}
+
+static bt_node *
+bench_bst_find(bt_node *n, uint64_t key)
+{
+    while (n && n->key != key) {
+        n = (key < n->key) ? n->left : n->right;
+    }
+    return n;
+}
+
+static void
+bench_balanced_tree(uint64_t n)
+{
+    const char *names[] = {"sorted", "reverse sorted", "random"};
+    uint64_t *keys = (uint64_t *)malloc(n * sizeof(uint64_t));
+    avl_tree_t *t = NULL;
+    uint64_t found = 0;
+    double start = 0;
+    int bound = 0;
+
+    /* 1.44 log2(n + 2), with log2 rounded up. */
+    for (uint64_t m = n + 2; m > 1; m = (m + 1) / 2) {
+        bound++;
+    }
+    bound = (bound * 144 + 99) / 100;
+
+    printf("\n\tBenchmarking AVL tree against insert_to_bst, %llu keys...",
+           (unsigned long long)n);
+
+    if (keys == NULL || n == 0) {
+        printf("\n\t\tFailed to set up input");
+        goto done;
+    }
+
+    for (int order = 0; order < 3; order++) {
+        uint64_t bst_n = (order == 2 || n < BST_BENCH_CAP) ? n :
+                                                             BST_BENCH_CAP;
+        bt_node *root = NULL;
+        double insert_sec, find_sec, delete_sec, bst_sec;
+        int bst_depth = 0;
+
+        for (uint64_t i = 0; i < n; i++) {
+            keys[i] = (order == 1) ? n - i : i + 1;
+        }
+        if (order == 2) {
+            srand(11);
+            for (uint64_t i = n - 1; i > 0; i--) {
+                uint64_t j = bench_rand() % (i + 1);
+                uint64_t tmp = keys[i];
+                keys[i] = keys[j];
+                keys[j] = tmp;
+            }
+        }
+
+        t = create_avl_tree();
+        if (t == NULL) {
+            goto done;
+        }
+
+        start = now_sec();
+        for (uint64_t i = 0; i < n; i++) {
+            avl_tree_insert(t, keys[i]);
+        }
+        insert_sec = now_sec() - start;
+
+        start = now_sec();
+        for (uint64_t i = 0; i < n; i++) {
+            found += (avl_tree_find(t, keys[(i * 7919) % n]) != NULL);
+        }
+        find_sec = now_sec() - start;
+
+        printf("\n\t\t%s", names[order]);
+        printf("\n\t\t\tavl   height %3d (bound %d)", avl_tree_height(t),
+               bound);
+
+        start = now_sec();
+        for (uint64_t i = 0; i < n; i++) {
+            avl_tree_delete(t, keys[i]);
+        }
+        delete_sec = now_sec() - start;
+        destroy_avl_tree(t);
+        t = NULL;
+
+        printf("\n\t\t\tavl   insert %7.2f M/s  find %7.2f M/s  "
+               "delete %7.2f M/s", n / insert_sec / 1e6, n / find_sec / 1e6,
+               n / delete_sec / 1e6);
+
+        start = now_sec();
+        for (uint64_t i = 0; i < bst_n; i++) {
+            insert_to_bst(&root, keys[i]);
+        }
+        bst_sec = now_sec() - start;
+        bst_depth = bench_bst_depth(root);
+        printf("\n\t\t\tbst   height %7d over %llu keys, insert %7.3f M/s",
+               bst_depth, (unsigned long long)bst_n,
+               bst_n / bst_sec / 1e6);
+
+        start = now_sec();
+        bst_rebalance(&root);
+        bst_sec = now_sec() - start;
+        printf("\n\t\t\tbst   rebalance to height %d, %7.2f M keys/s",
+               bench_bst_depth(root), bst_n / bst_sec / 1e6);
+        for (uint64_t i = 0; i < bst_n; i++) {
+            delete_from_bst(&root, keys[i]);
+        }
+
+        if (order == 0) {
+            start = now_sec();
+            root = bst_build_from_sorted(keys, n);
+            bst_sec = now_sec() - start;
+            if (root == NULL) {
+                goto done;
+            }
+
+            start = now_sec();
+            for (uint64_t i = 0; i < n; i++) {
+                found += (bench_bst_find(root, keys[(i * 7919) % n]) != NULL);
+            }
+            find_sec = now_sec() - start;
+            printf("\n\t\t\tbst   build from sorted %7.2f M keys/s, "
+                   "height %d, find %7.2f M/s", n / bst_sec / 1e6,
+                   bench_bst_depth(root), n / find_sec / 1e6);
+            destroy_bt(&root);
+        }
+    }
+
+    if (found != 4 * n) {
+        printf("\n\t\tfind missed keys");
+    }
+
+done:
+    free(keys);
+    printf("\n");
+}
+
+/*
+ * Point lookups and 100 key range scans over 'n' keys in a B+tree and in
+ * the AVL tree, plus build throughput. The AVL tree costs about 48
+ * bytes a key against the B+tree's 20, so it is capped at
+ * BPTREE_BENCH_AVL_CAP keys to stay in memory.
+ */
+#define BPTREE_BENCH_AVL_CAP    (32ULL * 1000 * 1000)
+#define BPTREE_BENCH_PROBES     (10ULL * 1000 * 1000)
+#define BPTREE_BENCH_SCAN       100
+
+static uint64_t
+bench_avl_scan(avl_tree_t *t, uint64_t lo, uint64_t count)
+{
+    avl_node_t *stack[AVL_MAX_HEIGHT];
+    avl_node_t *n = t->at_root;
+    uint64_t sum = 0;
+    int depth = 0;
+
+    /* Stack the nodes >= lo on the search path; they come next in order. */
+    while (n) {
+        if (n->key >= lo) {
+            stack[depth++] = n;
+            n = n->left;
+        } else {
+            n = n->right;
+        }
+    }
+
+    while (depth > 0 && count-- > 0) {
+        n = stack[--depth];
+        sum += n->key;
+        for (n = n->right; n; n = n->left) {
+            stack[depth++] = n;
+        }
+    }
+
+    return sum;
+}
+
+/*
+ * keys[i] = 2i + 1 for i < n, shuffled if 'shuffle'; probes are keys
+ * picked at random, so every lookup hits.
+ */
+static void
+bench_bptree_keys(uint64_t *keys, uint64_t n, bool shuffle, uint64_t *probes,
+                  uint64_t num_probes)
+{
+    for (uint64_t i = 0; i < n; i++) {
+        keys[i] = 2 * i + 1;
+    }
+    for (uint64_t i = 0; i < num_probes; i++) {
+        probes[i] = 2 * (bench_rand() % n) + 1;
+    }
+    for (uint64_t i = n - 1; shuffle && i > 0; i--) {
+        uint64_t j = bench_rand() % (i + 1);
+        uint64_t tmp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = tmp;
+    }
+}
+
+static void
+bench_bptree(uint64_t n)
+{
+    uint64_t m = (n < BPTREE_BENCH_AVL_CAP) ? n : BPTREE_BENCH_AVL_CAP;
+    uint64_t num_probes = (n < BPTREE_BENCH_PROBES) ? n : BPTREE_BENCH_PROBES;
+    uint64_t num_scans = num_probes / BPTREE_BENCH_SCAN;
+    uint64_t *keys = (uint64_t *)malloc(n * sizeof(uint64_t));
+    uint64_t *probes = (uint64_t *)malloc(num_probes * sizeof(uint64_t));
+    bptree_t *bp = NULL;
+    avl_tree_t *avl = NULL;
+    uint64_t found = 0;
+    uint64_t sum = 0;
+    double start = 0;
+    double sec = 0;
+
+    printf("\n\tBenchmarking B+tree against AVL tree, %llu keys...",
+           (unsigned long long)n);
+
+    if (keys == NULL || probes == NULL || num_scans == 0) {
+        printf("\n\t\tFailed to set up input");
+        goto done;
+    }
+
+    srand(13);
+    bench_bptree_keys(keys, n, false, probes, num_probes);
+
+    bp = create_bptree();
+    if (bp == NULL) {
+        goto done;
+    }
+    start = now_sec();
+    if (bptree_bulk_load(bp, keys, NULL, n) != 0) {
+        printf("\n\t\tbptree_bulk_load failed");
+        goto done;
+    }
+    sec = now_sec() - start;
+    printf("\n\t\tbptree  bulk load      %8.2f M keys/s, height %u",
+           n / sec / 1e6, bptree_height(bp));
+
+    start = now_sec();
+    for (uint64_t i = 0; i < num_probes; i++) {
+        found += (bptree_find(bp, probes[i], NULL) == 0);
+    }
+    sec = now_sec() - start;
+    printf("\n\t\tbptree  lookup         %8.2f M/s", num_probes / sec / 1e6);
+
+    start = now_sec();
+    for (uint64_t i = 0; i < num_scans; i++) {
+        bptree_cursor_t c;
+        uint64_t key = 0;
+
+        bptree_seek(bp, probes[i], &c);
+        for (int j = 0; j < BPTREE_BENCH_SCAN && bptree_next(&c, &key, NULL);
+             j++) {
+            sum += key;
+        }
+    }
+    sec = now_sec() - start;
+    printf("\n\t\tbptree  range scan     %8.2f M keys/s",
+           num_scans * BPTREE_BENCH_SCAN / sec / 1e6);
+
+    destroy_bptree(bp);
+    bp = NULL;
+
+    /* The same keys again, inserted one at a time in random order. */
+    bench_bptree_keys(keys, n, true, probes, 0);
+    bp = create_bptree();
+    if (bp == NULL) {
+        goto done;
+    }
+    start = now_sec();
+    for (uint64_t i = 0; i < n; i++) {
+        bptree_insert(bp, keys[i], keys[i]);
+    }
+    sec = now_sec() - start;
+    printf("\n\t\tbptree  random insert  %8.2f M/s, height %u",
+           n / sec / 1e6, bptree_height(bp));
+    destroy_bptree(bp);
+    bp = NULL;
+
+    bench_bptree_keys(keys, m, true, probes, num_probes);
+    avl = create_avl_tree();
+    if (avl == NULL) {
+        goto done;
+    }
+    start = now_sec();
+    for (uint64_t i = 0; i < m; i++) {
+        avl_tree_insert(avl, keys[i]);
+    }
+    sec = now_sec() - start;
+    printf("\n\t\tavl     random insert  %8.2f M/s, height %d over %llu keys",
+           m / sec / 1e6, avl_tree_height(avl), (unsigned long long)m);
+
+    start = now_sec();
+    for (uint64_t i = 0; i < num_probes; i++) {
+        found += (avl_tree_find(avl, probes[i]) != NULL);
+    }
+    sec = now_sec() - start;
+    printf("\n\t\tavl     lookup         %8.2f M/s", num_probes / sec / 1e6);
+
+    start = now_sec();
+    for (uint64_t i = 0; i < num_scans; i++) {
+        sum += bench_avl_scan(avl, probes[i], BPTREE_BENCH_SCAN);
+    }
+    sec = now_sec() - start;
+    printf("\n\t\tavl     range scan     %8.2f M keys/s",
+           num_scans * BPTREE_BENCH_SCAN / sec / 1e6);
+
+    if (found != 2 * num_probes) {
+        printf("\n\t\tlookups missed keys");
+    }
+    if (sum == 0) {
+        printf("\n\t\tscans found nothing");
+    }
+
+done:
+    if (bp) {
+        destroy_bptree(bp);
+    }
+    if (avl) {
+        destroy_avl_tree(avl);
+    }
+    free(keys);
+    free(probes);
+    printf("\n");
+}
+
+static void
+print_usage(void)
+{
+    printf("\nbench_driver -[PMWKRSQIFTB] [-n elements]");
+    printf("\n\t\t P - Benchmark pairing heap against heap_t");
+    printf("\n\t\t M - Benchmark MultiQueue against locked heap_t");
+    printf("\n\t\t W - Benchmark timing wheel against heaps");
+    printf("\n\t\t K - Benchmark top-K selection against quick_sort");
+    printf("\n\t\t R - Benchmark K-way merge of sorted runs");
+    printf("\n\t\t S - Benchmark SPSC ring against locked simple_q");
+    printf("\n\t\t Q - Benchmark MPMC queue against locked simple_q");
+    printf("\n\t\t I - Benchmark shared memory queue against a pipe");
+    printf("\n\t\t F - Benchmark Treiber stack free list against a lock");
+    printf("\n\t\t T - Benchmark AVL tree against insert_to_bst");
+    printf("\n\t\t B - Benchmark B+tree against AVL tree");
+    printf("\n\t\t n - Number of elements (default 1000000)");
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int opt = 0;
+    uint64_t n = 1000000;
+    bool bench_pairing_f = false;
+    bool bench_multiqueue_f = false;
+    bool bench_timing_wheel_f = false;
+    bool bench_top_k_f = false;
+    bool bench_kway_merge_f = false;
+    bool bench_spsc_f = false;
+    bool bench_mpmc_f = false;
+    bool bench_ipc_f = false;
+    bool bench_freelist_f = false;
+    bool bench_tree_f = false;
+    bool bench_bptree_f = false;
+
+    printf("Welcome to DSA Benchmark Driver Program!");
+
+    while ((opt = getopt(argc, argv, "hPMWKRSQIFTBn:")) != -1) {
+        switch (opt) {
+            case 'P':
+                bench_pairing_f = true;
+                break;
+            case 'M':
+                bench_multiqueue_f = true;
+                break;
+            case 'W':
+                bench_timing_wheel_f = true;
+                break;
+            case 'K':
+                bench_top_k_f = true;
+                break;
+            case 'R':
+                bench_kway_merge_f = true;
+                break;
+            case 'S':
+                bench_spsc_f = true;
+                break;
+            case 'Q':
+                bench_mpmc_f = true;
+                break;
+            case 'I':
+                bench_ipc_f = true;
+                break;
+            case 'F':
+                bench_freelist_f = true;
+                break;
+            case 'T':
+                bench_tree_f = true;
+                break;
+            case 'B':
+                bench_bptree_f = true;
+                break;
+            case 'n':
+                n = strtoull(optarg, NULL, 10);
+                break;
+            case 'h':
+                print_usage();
+                break;
+            default:
+                printf("\nIncorrect option.");
+                print_usage();
+                goto done;
+        }
+    }
+
+    if (bench_pairing_f) {
+        bench_pairing_heap(n);
+    }
+
+    if (bench_multiqueue_f) {
+        bench_multiqueue(n);
+    }
+
+    if (bench_timing_wheel_f) {
+        bench_timing_wheel(n);
+    }
+
+    if (bench_top_k_f) {
+        bench_top_k(n);
+    }
+
+    if (bench_kway_merge_f) {
+        bench_kway_merge(n);
+    }
+
+    if (bench_spsc_f) {
+        bench_spsc(n);
+    }
+
+    if (bench_mpmc_f) {
+        bench_mpmc(n);
+    }
+
+    if (bench_ipc_f) {
+        bench_ipc(n);
+    }
+
+    if (bench_freelist_f) {
+        bench_freelist(n);
+    }
+
+    if (bench_tree_f) {
+        bench_balanced_tree(n);
+    }
+
+    if (bench_bptree_f) {
+        bench_bptree(n);
+    }
+
+done:
+    return 0;
+}
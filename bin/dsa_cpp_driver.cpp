@@ -6,6 +6,9 @@
 
 #include <iostream>
 #include <dsa_map.hpp>
+#include <dary_heap.hpp>
+#include <cassert>
+#include <cstdlib>
 using namespace std;
 
 void
@@ -33,11 +36,59 @@ test_map()
     destroy_map(m);
 }
 
+template <unsigned D>
+void
+test_dary_heap_arity()
+{
+    const int num_elems = 1000;
+    dary_min_heap<uint64_t, D> min_h;
+    dary_max_heap<uint64_t, D> max_h(16);
+    uint64_t prev = 0;
+    uint64_t out = 0;
+
+    for (int i = 0; i < num_elems; i++) {
+        uint64_t key = rand() % 500;
+        min_h.push(key);
+        max_h.push(key);
+    }
+    assert(min_h.size() == num_elems);
+
+    cout << "\n\t\t" << D << "-ary MIN heap first pops: ";
+    for (int i = 0; min_h.pop(&out); i++) {
+        assert(i == 0 || prev <= out);
+        if (i < 10) {
+            cout << out << " ";
+        }
+        prev = out;
+    }
+
+    cout << "\n\t\t" << D << "-ary MAX heap first pops: ";
+    for (int i = 0; max_h.pop(&out); i++) {
+        assert(i == 0 || prev >= out);
+        if (i < 10) {
+            cout << out << " ";
+        }
+        prev = out;
+    }
+    assert(max_h.empty());
+    (void)prev;
+}
+
+void
+test_dary_heap()
+{
+    cout << "\n\tTesting D-ary Heap";
+    test_dary_heap_arity<2>();
+    test_dary_heap_arity<4>();
+    test_dary_heap_arity<8>();
+}
+
 int main(void)
 {
     cout << "Welcome to DSA CPP Driver Program!";
 
     test_map();
+    test_dary_heap();
 
     cout << "\n";
 
@@ -9,14 +9,36 @@
 #include <hashmap.h>
 #include <linked_list.h>
 #include <binary_tree.h>
+#include <avl_tree.h>
+#include <bptree.h>
 #include <queue.h>
+#include <spsc_ring.h>
+#include <mpmc_queue.h>
+#include <ws_deque.h>
+#include <blocking_queue.h>
+#include <shm_queue.h>
 #include <Stack.h>
+#include <treiber_stack.h>
+#include <arena.h>
 #include <heap.h>
+#include <indexed_heap.h>
+#include <pairing_heap.h>
+#include <radix_heap.h>
+#include <minmax_heap.h>
+#include <multiqueue.h>
+#include <timing_wheel.h>
 #include <graph.h>
 #include <getopt.h>
 #include <assert.h>
 #include <stdbool.h>
 #include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
 
 static void
 print_bt_node(bt_node *node)
@@ -91,6 +113,9 @@ test_simple_q(void)
     int error = 0;
     const uint64_t max_size = 5;
     uint64_t dequeue_elem = -1;
+    uint64_t ptr_elems[max_size];
+    void *dequeue_ptr = NULL;
+    simple_q *growq = NULL;
     simple_q *q = create_simple_q(max_size);
     if (q == NULL) {
         goto done;
@@ -134,6 +159,37 @@ test_simple_q(void)
         printf("\n\t\tFailed to Dequeue.");
     }
 
+    printf("\n\t\tTesting Growth Across Wraparound...");
+    growq = create_simple_q_flags(4, SIMPLE_Q_F_GROW);
+    if (growq == NULL) {
+        goto done;
+    }
+
+    /* Leave front mid-array so the ring is wrapped when it first grows. */
+    for (uint64_t i = 0; i < 3; i++) {
+        simple_q_enqueue(growq, i);
+        simple_q_dequeue(growq, &dequeue_elem);
+    }
+    for (uint64_t i = 0; i < 1000; i++) {
+        error = simple_q_enqueue(growq, i);
+        assert(error == 0);
+    }
+    for (uint64_t i = 0; i < 1000; i++) {
+        error = simple_q_dequeue(growq, &dequeue_elem);
+        assert(error == 0 && dequeue_elem == i);
+    }
+    printf("\n\t\tGrew to capacity %llu in order", growq->mask + 1);
+
+    printf("\n\t\tTesting Pointer Payloads...");
+    for (int i = 0; i < max_size; i++) {
+        simple_q_enqueue_ptr(growq, &ptr_elems[i]);
+    }
+    for (int i = 0; i < max_size; i++) {
+        simple_q_dequeue_ptr(growq, &dequeue_ptr);
+        assert(dequeue_ptr == &ptr_elems[i]);
+    }
+    assert(simple_q_is_empty(growq));
+
 
 done:
     if (q) {
@@ -143,8 +199,1311 @@ done:
         print_simple_q_info(q);
         destroy_simple_q(q);
     }
+    if (growq) {
+        destroy_simple_q(growq);
+    }
+    printf("\n");
+    return;
+}
+
+#define SPSC_TEST_COUNT     200000
+#define SPSC_TEST_BATCH     32
+
+/*
+ * Producer half of the SPSC test: alternates single pushes with
+ * reserve/commit batches, yielding when the ring is full.
+ */
+static void *
+spsc_test_producer(void *arg)
+{
+    spsc_ring_t *r = (spsc_ring_t *)arg;
+    uint64_t next = 0;
+    uint64_t got = 0;
+
+    while (next < SPSC_TEST_COUNT) {
+        if ((next / SPSC_TEST_BATCH) % 2) {
+            uint64_t *slots = spsc_ring_reserve(r, SPSC_TEST_BATCH, &got);
+            if (got > SPSC_TEST_COUNT - next) {
+                got = SPSC_TEST_COUNT - next;
+            }
+            for (uint64_t i = 0; i < got; i++) {
+                slots[i] = next++;
+            }
+            if (got) {
+                spsc_ring_commit(r, got);
+                continue;
+            }
+        } else if (spsc_ring_push(r, &next) == 0) {
+            next++;
+            continue;
+        }
+        sched_yield();
+    }
+
+    return NULL;
+}
+
+static void
+test_spsc_ring(void)
+{
+    spsc_ring_t *r = create_spsc_ring(100, sizeof(uint64_t));
+    pthread_t producer;
+    uint64_t expected = 0;
+    uint64_t value = 0;
+    uint64_t got = 0;
+    uint64_t peeks = 0;
+    int error = 0;
+
+    printf("\n\tTesting SPSC Ring...");
+
+    if (r == NULL) {
+        printf("\n\t\tFailed to allocate SPSC ring");
+        goto done;
+    }
+    assert(r->sr_mask + 1 == 128);
+    error = spsc_ring_pop(r, &value);
+    assert(error == EAGAIN);
+
+    pthread_create(&producer, NULL, spsc_test_producer, r);
+
+    /* Consume with pops and peek/release runs, checking order. */
+    while (expected < SPSC_TEST_COUNT) {
+        if (expected % 3) {
+            if (spsc_ring_pop(r, &value) == 0) {
+                assert(value == expected);
+                expected++;
+                continue;
+            }
+        } else {
+            uint64_t *slots = spsc_ring_peek(r, SPSC_TEST_BATCH, &got);
+            for (uint64_t i = 0; i < got; i++) {
+                assert(slots[i] == expected + i);
+            }
+            if (got) {
+                spsc_ring_release(r, got);
+                expected += got;
+                peeks++;
+                continue;
+            }
+        }
+        sched_yield();
+    }
+
+    pthread_join(producer, NULL);
+    assert(spsc_ring_size(r) == 0);
+    printf("\n\t\tPassed %d values in order, %llu zero copy batches",
+           SPSC_TEST_COUNT, peeks);
+
+done:
+    if (r) {
+        destroy_spsc_ring(r);
+    }
+    printf("\n");
+}
+
+#define MPMC_TEST_PRODUCERS     3
+#define MPMC_TEST_CONSUMERS     3
+#define MPMC_TEST_PER_PRODUCER  100000
+#define MPMC_TEST_BATCH         16
+
+typedef struct mpmc_test_arg_ {
+    mpmc_queue_t *q;
+    uint64_t id;
+    uint64_t sum;
+    uint64_t count;
+} mpmc_test_arg_t;
+
+static _Atomic uint64_t mpmc_test_consumed;
+
+/*
+ * Values carry the producer id in the high half and a per producer
+ * sequence number in the low half.
+ */
+static void *
+mpmc_test_producer(void *arg)
+{
+    mpmc_test_arg_t *a = (mpmc_test_arg_t *)arg;
+    uint64_t batch[MPMC_TEST_BATCH];
+    uint64_t seq = 0;
+    uint64_t done = 0;
+
+    while (seq < MPMC_TEST_PER_PRODUCER) {
+        if (seq % 2) {
+            uint64_t value = (a->id << 32) | seq++;
+            mpmc_queue_enqueue(a->q, &value);
+            continue;
+        }
+
+        uint64_t n = MPMC_TEST_PER_PRODUCER - seq;
+        if (n > MPMC_TEST_BATCH) {
+            n = MPMC_TEST_BATCH;
+        }
+        for (uint64_t i = 0; i < n; i++) {
+            batch[i] = (a->id << 32) | (seq + i);
+        }
+        if (mpmc_queue_try_enqueue_batch(a->q, batch, n, &done) == 0) {
+            seq += done;
+        } else {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void *
+mpmc_test_consumer(void *arg)
+{
+    mpmc_test_arg_t *a = (mpmc_test_arg_t *)arg;
+    const uint64_t total = MPMC_TEST_PRODUCERS * MPMC_TEST_PER_PRODUCER;
+    uint64_t last[MPMC_TEST_PRODUCERS];
+    uint64_t batch[MPMC_TEST_BATCH];
+    uint64_t done = 0;
+
+    for (int i = 0; i < MPMC_TEST_PRODUCERS; i++) {
+        last[i] = UINT64_MAX;
+    }
+
+    while (atomic_load(&mpmc_test_consumed) < total) {
+        if (a->count % 2) {
+            done = (mpmc_queue_try_dequeue(a->q, batch) == 0);
+        } else {
+            mpmc_queue_try_dequeue_batch(a->q, batch, MPMC_TEST_BATCH, &done);
+        }
+        if (done == 0) {
+            sched_yield();
+            continue;
+        }
+
+        /* Each consumer sees any one producer's values in order. */
+        for (uint64_t i = 0; i < done; i++) {
+            uint64_t producer = batch[i] >> 32;
+            uint64_t seq = batch[i] & 0xffffffffULL;
+
+            assert(producer < MPMC_TEST_PRODUCERS);
+            assert(last[producer] == UINT64_MAX || seq > last[producer]);
+            last[producer] = seq;
+            a->sum += seq;
+        }
+        a->count += done;
+        atomic_fetch_add(&mpmc_test_consumed, done);
+    }
+
+    return NULL;
+}
+
+static void
+test_mpmc_queue(void)
+{
+    mpmc_queue_t *q = create_mpmc_queue(60, sizeof(uint64_t));
+    pthread_t producers[MPMC_TEST_PRODUCERS];
+    pthread_t consumers[MPMC_TEST_CONSUMERS];
+    mpmc_test_arg_t pargs[MPMC_TEST_PRODUCERS];
+    mpmc_test_arg_t cargs[MPMC_TEST_CONSUMERS];
+    uint64_t value = 0;
+    uint64_t sum = 0;
+    uint64_t count = 0;
+    int error = 0;
+
+    printf("\n\tTesting MPMC Queue...");
+
+    if (q == NULL) {
+        printf("\n\t\tFailed to allocate MPMC queue");
+        goto done;
+    }
+    error = mpmc_queue_try_dequeue(q, &value);
+    assert(error == EAGAIN);
+    for (uint64_t i = 0; i < 64; i++) {
+        error = mpmc_queue_try_enqueue(q, &i);
+        assert(error == 0);
+    }
+    error = mpmc_queue_try_enqueue(q, &value);
+    assert(error == EAGAIN);
+    for (uint64_t i = 0; i < 64; i++) {
+        error = mpmc_queue_try_dequeue(q, &value);
+        assert(error == 0 && value == i);
+    }
+
+    atomic_store(&mpmc_test_consumed, 0);
+    for (uint64_t i = 0; i < MPMC_TEST_CONSUMERS; i++) {
+        cargs[i] = (mpmc_test_arg_t){q, i, 0, 0};
+        pthread_create(&consumers[i], NULL, mpmc_test_consumer, &cargs[i]);
+    }
+    for (uint64_t i = 0; i < MPMC_TEST_PRODUCERS; i++) {
+        pargs[i] = (mpmc_test_arg_t){q, i, 0, 0};
+        pthread_create(&producers[i], NULL, mpmc_test_producer, &pargs[i]);
+    }
+    for (int i = 0; i < MPMC_TEST_PRODUCERS; i++) {
+        pthread_join(producers[i], NULL);
+    }
+    for (int i = 0; i < MPMC_TEST_CONSUMERS; i++) {
+        pthread_join(consumers[i], NULL);
+        sum += cargs[i].sum;
+        count += cargs[i].count;
+    }
+
+    assert(count == MPMC_TEST_PRODUCERS * MPMC_TEST_PER_PRODUCER);
+    assert(sum == MPMC_TEST_PRODUCERS * (MPMC_TEST_PER_PRODUCER *
+                                         (MPMC_TEST_PER_PRODUCER - 1ULL) / 2));
+    printf("\n\t\t%d producers, %d consumers moved %llu values",
+           MPMC_TEST_PRODUCERS, MPMC_TEST_CONSUMERS, count);
+
+done:
+    if (q) {
+        destroy_mpmc_queue(q);
+    }
+    printf("\n");
+}
+
+#define WS_TEST_THIEVES     3
+#define WS_TEST_ITEMS       200000
+
+static _Atomic uint8_t ws_test_seen[WS_TEST_ITEMS];
+static _Atomic uint64_t ws_test_taken;
+static _Atomic uint64_t ws_test_stolen;
+
+/*
+ * Items are 1 based indexes cast to pointers, so NULL never shows up
+ * as a valid item.
+ */
+static void
+ws_test_take(void *item)
+{
+    uint64_t index = (uint64_t)(uintptr_t)item - 1;
+    uint8_t seen = 0;
+
+    assert(index < WS_TEST_ITEMS);
+    seen = atomic_fetch_add(&ws_test_seen[index], 1);
+    assert(seen == 0);
+    atomic_fetch_add(&ws_test_taken, 1);
+}
+
+static void *
+ws_test_thief(void *arg)
+{
+    ws_deque_t *d = (ws_deque_t *)arg;
+    void *item = NULL;
+
+    while (atomic_load(&ws_test_taken) < WS_TEST_ITEMS) {
+        int error = ws_deque_steal(d, &item);
+        if (error == 0) {
+            ws_test_take(item);
+            atomic_fetch_add(&ws_test_stolen, 1);
+        } else if (error == ENOENT) {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void
+test_ws_deque(void)
+{
+    ws_deque_t *d = create_ws_deque(4);
+    pthread_t thieves[WS_TEST_THIEVES];
+    void *item = NULL;
+    uint64_t next = 0;
+    int error = 0;
+
+    printf("\n\tTesting Work Stealing Deque...");
+
+    if (d == NULL) {
+        printf("\n\t\tFailed to allocate deque");
+        goto done;
+    }
+
+    /* Single threaded: LIFO for the owner, FIFO for a thief. */
+    for (uintptr_t i = 1; i <= 100; i++) {
+        ws_deque_push(d, (void *)i);
+    }
+    assert(ws_deque_size(d) == 100);
+    error = ws_deque_pop(d, &item);
+    assert(error == 0 && item == (void *)100);
+    error = ws_deque_steal(d, &item);
+    assert(error == 0 && item == (void *)1);
+    while (ws_deque_pop(d, &item) == 0) {
+    }
+    assert(ws_deque_size(d) == 0);
+    error = ws_deque_steal(d, &item);
+    assert(error == ENOENT);
+
+    for (int i = 0; i < WS_TEST_ITEMS; i++) {
+        atomic_init(&ws_test_seen[i], 0);
+    }
+    atomic_store(&ws_test_taken, 0);
+    atomic_store(&ws_test_stolen, 0);
+
+    for (int i = 0; i < WS_TEST_THIEVES; i++) {
+        pthread_create(&thieves[i], NULL, ws_test_thief, d);
+    }
+
+    /* Owner pushes in bursts and pops part of each burst back. */
+    while (next < WS_TEST_ITEMS) {
+        for (int i = 0; i < 64 && next < WS_TEST_ITEMS; i++) {
+            next++;
+            error = ws_deque_push(d, (void *)(uintptr_t)next);
+            assert(error == 0);
+        }
+        for (int i = 0; i < 16; i++) {
+            if (ws_deque_pop(d, &item) == 0) {
+                ws_test_take(item);
+            }
+        }
+    }
+    while (ws_deque_pop(d, &item) == 0) {
+        ws_test_take(item);
+    }
+
+    for (int i = 0; i < WS_TEST_THIEVES; i++) {
+        pthread_join(thieves[i], NULL);
+    }
+
+    assert(atomic_load(&ws_test_taken) == WS_TEST_ITEMS);
+    printf("\n\t\t%d items taken exactly once, %llu by %d thieves",
+           WS_TEST_ITEMS, (unsigned long long)atomic_load(&ws_test_stolen),
+           WS_TEST_THIEVES);
+
+done:
+    if (d) {
+        destroy_ws_deque(d);
+    }
+    printf("\n");
+}
+
+#define BQ_TEST_PRODUCERS   2
+#define BQ_TEST_CONSUMERS   3
+#define BQ_TEST_PER_PRODUCER 50000
+#define BQ_TEST_BATCH       8
+
+typedef struct bq_test_arg_ {
+    blocking_q *q;
+    uint64_t sum;
+    uint64_t count;
+} bq_test_arg_t;
+
+static void *
+bq_test_producer(void *arg)
+{
+    bq_test_arg_t *a = (bq_test_arg_t *)arg;
+    uint64_t batch[BQ_TEST_BATCH];
+    int error = 0;
+
+    for (uint64_t i = 1; i <= BQ_TEST_PER_PRODUCER; ) {
+        if (i % 3 || i + BQ_TEST_BATCH > BQ_TEST_PER_PRODUCER + 1) {
+            error = blocking_q_enqueue(a->q, i);
+            assert(error == 0);
+            i++;
+            continue;
+        }
+        for (int j = 0; j < BQ_TEST_BATCH; j++) {
+            batch[j] = i++;
+        }
+        error = blocking_q_enqueue_batch(a->q, batch, BQ_TEST_BATCH);
+        assert(error == 0);
+    }
+
+    return NULL;
+}
+
+/*
+ * Consume until the queue reports closed and drained.
+ */
+static void *
+bq_test_consumer(void *arg)
+{
+    bq_test_arg_t *a = (bq_test_arg_t *)arg;
+    uint64_t batch[BQ_TEST_BATCH];
+    uint64_t got = 0;
+    int error = 0;
+
+    for (;;) {
+        error = blocking_q_dequeue_batch(a->q, batch, BQ_TEST_BATCH, &got,
+                                         -1);
+        if (error == EPIPE) {
+            break;
+        }
+        assert(error == 0 && got > 0);
+        for (uint64_t i = 0; i < got; i++) {
+            a->sum += batch[i];
+        }
+        a->count += got;
+    }
+
+    return NULL;
+}
+
+static void
+test_blocking_q(void)
+{
+    blocking_q *q = create_blocking_q(16, 0);
+    pthread_t producers[BQ_TEST_PRODUCERS];
+    pthread_t consumers[BQ_TEST_CONSUMERS];
+    bq_test_arg_t pargs[BQ_TEST_PRODUCERS];
+    bq_test_arg_t cargs[BQ_TEST_CONSUMERS];
+    struct timespec start, end;
+    uint64_t value = 0;
+    uint64_t sum = 0;
+    uint64_t count = 0;
+    double waited_ms = 0;
+    int error = 0;
+
+    printf("\n\tTesting Blocking Queue...");
+
+    if (q == NULL) {
+        printf("\n\t\tFailed to allocate blocking queue");
+        goto done;
+    }
+
+    error = blocking_q_dequeue(q, &value, 0);
+    assert(error == ETIMEDOUT);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    error = blocking_q_dequeue(q, &value, 20000000);
+    assert(error == ETIMEDOUT);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    waited_ms = (end.tv_sec - start.tv_sec) * 1e3 +
+                (end.tv_nsec - start.tv_nsec) / 1e6;
+    assert(waited_ms >= 19.0);
+    printf("\n\t\tTimed dequeue on empty gave up after %.1f ms", waited_ms);
+
+    for (int i = 0; i < BQ_TEST_CONSUMERS; i++) {
+        cargs[i] = (bq_test_arg_t){q, 0, 0};
+        pthread_create(&consumers[i], NULL, bq_test_consumer, &cargs[i]);
+    }
+    for (int i = 0; i < BQ_TEST_PRODUCERS; i++) {
+        pargs[i] = (bq_test_arg_t){q, 0, 0};
+        pthread_create(&producers[i], NULL, bq_test_producer, &pargs[i]);
+    }
+    for (int i = 0; i < BQ_TEST_PRODUCERS; i++) {
+        pthread_join(producers[i], NULL);
+    }
+
+    /* Consumers drain what is left after close and then exit. */
+    blocking_q_close(q);
+    for (int i = 0; i < BQ_TEST_CONSUMERS; i++) {
+        pthread_join(consumers[i], NULL);
+        sum += cargs[i].sum;
+        count += cargs[i].count;
+    }
+
+    assert(count == BQ_TEST_PRODUCERS * BQ_TEST_PER_PRODUCER);
+    assert(sum == BQ_TEST_PRODUCERS * (BQ_TEST_PER_PRODUCER *
+                                       (BQ_TEST_PER_PRODUCER + 1ULL) / 2));
+    error = blocking_q_enqueue(q, 1);
+    assert(error == EPIPE);
+    error = blocking_q_dequeue(q, &value, -1);
+    assert(error == EPIPE);
+    printf("\n\t\t%d producers, %d consumers moved %llu keys through 16 "
+           "slots, then closed", BQ_TEST_PRODUCERS, BQ_TEST_CONSUMERS,
+           count);
+
+done:
+    if (q) {
+        destroy_blocking_q(q);
+    }
+    printf("\n");
+}
+
+#define SHMQ_TEST_PRODUCERS     2
+#define SHMQ_TEST_PER_PRODUCER  20000
+#define SHMQ_TEST_MAX_LEN       200
+
+/*
+ * Message 'seq' from 'producer': a small header followed by bytes that
+ * depend on both, with a length that cycles so frames wrap at every
+ * possible offset.
+ */
+static uint32_t
+shmq_test_fill(uint8_t *buf, uint32_t producer, uint32_t seq)
+{
+    uint32_t len = 8 + seq % (SHMQ_TEST_MAX_LEN - 8);
+
+    memcpy(buf, &producer, sizeof(producer));
+    memcpy(buf + 4, &seq, sizeof(seq));
+    for (uint32_t i = 8; i < len; i++) {
+        buf[i] = (uint8_t)(producer * 31 + seq + i);
+    }
+    return len;
+}
+
+/*
+ * Child process: map the queue by name and send through the zero copy
+ * path. An assert here shows up as a failed exit status in the parent.
+ */
+static void
+shmq_test_producer(const char *name, uint32_t producer)
+{
+    shm_q *q = open_shm_q(name);
+    uint8_t buf[SHMQ_TEST_MAX_LEN];
+    int error = 0;
+
+    assert(q != NULL);
+    for (uint32_t seq = 0; seq < SHMQ_TEST_PER_PRODUCER; seq++) {
+        uint32_t len = shmq_test_fill(buf, producer, seq);
+        void *msg = NULL;
+
+        while ((msg = shm_q_reserve(q, len)) == NULL) {
+            assert(errno == EAGAIN);
+            sched_yield();
+        }
+        memcpy(msg, buf, len);
+        error = shm_q_commit(q, msg);
+        assert(error == 0);
+    }
+    destroy_shm_q(q);
+    _exit(0);
+}
+
+static void
+test_shm_q(void)
+{
+    char name[64];
+    shm_q *q = NULL;
+    shm_q *dup = NULL;
+    void *peeked = NULL;
+    uint8_t buf[SHMQ_TEST_MAX_LEN];
+    uint8_t expect[SHMQ_TEST_MAX_LEN];
+    uint32_t next[SHMQ_TEST_PRODUCERS] = {0};
+    pid_t pids[SHMQ_TEST_PRODUCERS];
+    uint64_t received = 0;
+    uint32_t len = 0;
+    pid_t waited = 0;
+    int status = 0;
+    int error = 0;
+
+    printf("\n\tTesting Shared Memory Queue...");
+
+    snprintf(name, sizeof(name), "/dsa_shmq_test_%d", (int)getpid());
+    q = create_shm_q(name, 4096, 0);
+    if (q == NULL) {
+        printf("\n\t\tFailed to create shared memory queue");
+        goto done;
+    }
+    dup = create_shm_q(name, 4096, 0);
+    assert(dup == NULL && errno == EEXIST);
+
+    /* Single process: framing, wrap, and the error paths. */
+    peeked = shm_q_peek(q, &len);
+    assert(peeked == NULL && errno == EAGAIN);
+    error = shm_q_release(q);
+    assert(error == EAGAIN);
+    peeked = shm_q_reserve(q, q->sq_max_msg + 1);
+    assert(peeked == NULL && errno == EMSGSIZE);
+    for (uint32_t seq = 0; seq < 1000; seq++) {
+        uint32_t n = shmq_test_fill(expect, 0, seq);
+
+        error = shm_q_send(q, expect, n);
+        assert(error == 0);
+        error = shm_q_recv(q, buf, 4, &len);
+        assert(error == EMSGSIZE && len == n);
+        error = shm_q_recv(q, buf, sizeof(buf), &len);
+        assert(error == 0 && len == n);
+        assert(memcmp(buf, expect, n) == 0);
+    }
+    error = shm_q_send(q, NULL, 0);
+    assert(error == 0);
+    peeked = shm_q_peek(q, &len);
+    assert(peeked != NULL && len == 0);
+    error = shm_q_release(q);
+    assert(error == 0);
+    while (shm_q_send(q, expect, 64) == 0) {
+        received++;
+    }
+    assert(received == 4096 / 72);
+    while (shm_q_recv(q, buf, sizeof(buf), &len) == 0) {
+        received--;
+    }
+    assert(received == 0);
+    printf("\n\t\tFramed, wrapped and filled a 4 KB ring in one process");
+
+    /* Several producer processes, one consumer. */
+    for (uint32_t p = 0; p < SHMQ_TEST_PRODUCERS; p++) {
+        pids[p] = fork();
+        assert(pids[p] >= 0);
+        if (pids[p] == 0) {
+            shmq_test_producer(name, p);
+        }
+    }
+
+    while (received < SHMQ_TEST_PRODUCERS * SHMQ_TEST_PER_PRODUCER) {
+        uint32_t producer = 0;
+        uint32_t seq = 0;
+        uint32_t expect_len = 0;
+        uint8_t *msg = shm_q_peek(q, &len);
+
+        if (msg == NULL) {
+            sched_yield();
+            continue;
+        }
+
+        /* Each producer's messages arrive whole and in order. */
+        memcpy(&producer, msg, sizeof(producer));
+        memcpy(&seq, msg + 4, sizeof(seq));
+        assert(producer < SHMQ_TEST_PRODUCERS && seq == next[producer]);
+        expect_len = shmq_test_fill(expect, producer, seq);
+        assert(len == expect_len);
+        assert(memcmp(msg, expect, len) == 0);
+        error = shm_q_release(q);
+        assert(error == 0);
+        next[producer]++;
+        received++;
+    }
+
+    for (uint32_t p = 0; p < SHMQ_TEST_PRODUCERS; p++) {
+        waited = waitpid(pids[p], &status, 0);
+        assert(waited == pids[p]);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+    peeked = shm_q_peek(q, &len);
+    assert(peeked == NULL);
+    printf("\n\t\t%d producer processes sent %llu messages of 8 to %d "
+           "bytes", SHMQ_TEST_PRODUCERS, received, SHMQ_TEST_MAX_LEN - 1);
+
+done:
+    if (q) {
+        destroy_shm_q(q);
+    }
+    printf("\n");
+}
+
+static uint64_t bt_visit_count = 0;
+
+static void
+count_bt_node(bt_node *node)
+{
+    bt_visit_count++;
+}
+
+/*
+ * Complete tree of 1000 nodes, whose last level holds well over the
+ * 100 entries the traversal queue used to be limited to.
+ */
+static void
+test_binary_tree_large()
+{
+    const int num_tree_elements = 1000;
+    bt_node *root = NULL;
+
+    printf("\n\tTesting Large Binary Tree...");
+
+    for (int i = 0; i < num_tree_elements; i++) {
+        insert_to_bt(&root, i);
+    }
+
+    bt_visit_count = 0;
+    level_order_traversal(root, count_bt_node);
+    assert(bt_visit_count == num_tree_elements);
+    printf("\n\t\tLevel order visited %llu nodes", bt_visit_count);
+
+    for (int i = 0; i < num_tree_elements; i++) {
+        delete_from_bt(&root, i);
+    }
+    assert(root == NULL);
+    printf("\n");
+}
+
+#define AVL_TEST_KEYS       10000
+
+/*
+ * Check ordering, stored heights and balance below 'n' and return its
+ * height. Recursion depth is bounded by the tree height.
+ */
+static int32_t
+avl_test_check(avl_node_t *n, uint64_t lo, uint64_t hi, uint64_t *count)
+{
+    int32_t l = 0;
+    int32_t r = 0;
+
+    if (n == NULL) {
+        return 0;
+    }
+
+    assert(n->key >= lo && n->key <= hi);
+    l = avl_test_check(n->left, lo, n->key - 1, count);
+    r = avl_test_check(n->right, n->key + 1, hi, count);
+    assert(l - r <= 1 && r - l <= 1);
+    assert(n->height == 1 + (l > r ? l : r));
+    (*count)++;
+    return n->height;
+}
+
+static void
+avl_test_validate(avl_tree_t *t)
+{
+    uint64_t count = 0;
+
+    avl_test_check(t->at_root, 0, UINT64_MAX - 1, &count);
+    assert(count == avl_tree_size(t));
+}
+
+static void
+test_avl_tree()
+{
+    static uint64_t keys[AVL_TEST_KEYS];
+    const char *names[] = {"sorted", "reverse sorted", "random"};
+    avl_tree_t *t = NULL;
+    int error = 0;
+
+    printf("\n\tTesting AVL Tree...");
+
+    for (int order = 0; order < 3; order++) {
+        t = create_avl_tree();
+        if (t == NULL) {
+            printf("\n\t\tFailed to allocate AVL tree");
+            goto done;
+        }
+
+        for (uint64_t i = 0; i < AVL_TEST_KEYS; i++) {
+            keys[i] = (order == 1) ? AVL_TEST_KEYS - i : i + 1;
+        }
+        if (order == 2) {
+            for (uint64_t i = AVL_TEST_KEYS - 1; i > 0; i--) {
+                uint64_t j = rand() % (i + 1);
+                uint64_t tmp = keys[i];
+                keys[i] = keys[j];
+                keys[j] = tmp;
+            }
+        }
+
+        for (uint64_t i = 0; i < AVL_TEST_KEYS; i++) {
+            error = avl_tree_insert(t, keys[i]);
+            assert(error == 0);
+        }
+        error = avl_tree_insert(t, keys[0]);
+        assert(error == EEXIST);
+        avl_test_validate(t);
+
+        /* 1.44 log2(10001) is about 19.1. */
+        assert(avl_tree_height(t) <= 19);
+        printf("\n\t\t%llu %s keys, height %d", avl_tree_size(t),
+               names[order], avl_tree_height(t));
+
+        /* Delete every other key, then the rest. */
+        for (uint64_t i = 0; i < AVL_TEST_KEYS; i += 2) {
+            error = avl_tree_delete(t, keys[i]);
+            assert(error == 0);
+        }
+        error = avl_tree_delete(t, keys[0]);
+        assert(error == ENOENT);
+        avl_test_validate(t);
+        for (uint64_t i = 0; i < AVL_TEST_KEYS; i++) {
+            avl_node_t *n = avl_tree_find(t, keys[i]);
+            assert((n != NULL) == (i % 2 == 1));
+            assert(n == NULL || n->key == keys[i]);
+        }
+        for (uint64_t i = 1; i < AVL_TEST_KEYS; i += 2) {
+            error = avl_tree_delete(t, keys[i]);
+            assert(error == 0);
+        }
+        assert(avl_tree_size(t) == 0 && t->at_root == NULL);
+
+        /* Leave some nodes behind for destroy to free. */
+        for (uint64_t i = 0; i < 100; i++) {
+            error = avl_tree_insert(t, keys[i]);
+            assert(error == 0);
+        }
+        destroy_avl_tree(t);
+        t = NULL;
+    }
+
+done:
+    if (t) {
+        destroy_avl_tree(t);
+    }
+    printf("\n");
+}
+
+#define BPTREE_TEST_KEYS    20000
+
+/*
+ * Check key order, padding, fill and separator bounds below 'n', and
+ * that every leaf is at level 0. Returns the number of keys.
+ */
+static uint64_t
+bptree_test_check(bptree_hdr_t *n, uint64_t lo, uint64_t hi, bool root)
+{
+    uint64_t count = 0;
+
+    assert(n->bh_count <= BPTREE_MAX_KEYS);
+    assert(root || n->bh_count >= BPTREE_MIN_KEYS);
+
+    if (n->bh_level == 0) {
+        bptree_leaf_t *l = (bptree_leaf_t *)n;
+
+        for (uint32_t i = 0; i < BPTREE_KEY_SLOTS; i++) {
+            if (i >= n->bh_count) {
+                assert(l->bl_keys[i] == UINT64_MAX);
+                continue;
+            }
+            assert(l->bl_keys[i] >= lo && l->bl_keys[i] < hi);
+            assert(i == 0 || l->bl_keys[i - 1] < l->bl_keys[i]);
+            assert(l->bl_values[i] == l->bl_keys[i] * 3);
+        }
+        return n->bh_count;
+    }
+
+    bptree_inner_t *in = (bptree_inner_t *)n;
+
+    assert(n->bh_count >= 1);
+    for (uint32_t i = n->bh_count; i < BPTREE_KEY_SLOTS; i++) {
+        assert(in->bi_keys[i] == UINT64_MAX);
+    }
+    for (uint32_t i = 0; i <= n->bh_count; i++) {
+        uint64_t clo = (i == 0) ? lo : in->bi_keys[i - 1];
+        uint64_t chi = (i == n->bh_count) ? hi : in->bi_keys[i];
+
+        assert(clo <= chi && chi <= hi && clo >= lo);
+        assert(in->bi_children[i]->bh_level == n->bh_level - 1);
+        count += bptree_test_check(in->bi_children[i], clo, chi, false);
+    }
+    return count;
+}
+
+static void
+bptree_test_validate(bptree_t *t)
+{
+    bptree_cursor_t c;
+    uint64_t key = 0;
+    uint64_t prev = 0;
+    uint64_t count = 0;
+
+    if (t->bp_root == NULL) {
+        assert(bptree_size(t) == 0 && t->bp_first == NULL);
+        return;
+    }
+
+    assert(bptree_test_check(t->bp_root, 0, UINT64_MAX, true) ==
+           bptree_size(t));
+
+    /* The leaf chain visits every key once, in order. */
+    bptree_seek(t, 0, &c);
+    assert(c.bc_leaf == t->bp_first);
+    while (bptree_next(&c, &key, NULL)) {
+        assert(count == 0 || prev < key);
+        prev = key;
+        count++;
+    }
+    assert(count == bptree_size(t));
+}
+
+static void
+test_bptree()
+{
+    static uint64_t keys[BPTREE_TEST_KEYS];
+    static uint64_t sorted[BPTREE_TEST_KEYS];
+    static uint64_t values[BPTREE_TEST_KEYS];
+    bptree_t *t = NULL;
+    bptree_cursor_t c;
+    uint64_t key = 0;
+    uint64_t value = 0;
+    uint64_t n = 0;
+    bool more = false;
+    int error = 0;
+
+    printf("\n\tTesting B+tree...");
+
+    t = create_bptree();
+    if (t == NULL) {
+        printf("\n\t\tFailed to allocate B+tree");
+        goto done;
+    }
+
+    /* Even keys 2..2N in random order, so odd keys are known misses. */
+    for (uint64_t i = 0; i < BPTREE_TEST_KEYS; i++) {
+        keys[i] = 2 * (i + 1);
+    }
+    for (uint64_t i = BPTREE_TEST_KEYS - 1; i > 0; i--) {
+        uint64_t j = rand() % (i + 1);
+        uint64_t tmp = keys[i];
+        keys[i] = keys[j];
+        keys[j] = tmp;
+    }
+
+    error = bptree_find(t, 2, NULL);
+    assert(error == ENOENT);
+    error = bptree_delete(t, 2);
+    assert(error == ENOENT);
+    for (uint64_t i = 0; i < BPTREE_TEST_KEYS; i++) {
+        error = bptree_insert(t, keys[i], keys[i] * 3);
+        assert(error == 0);
+    }
+    error = bptree_insert(t, keys[0], 0);
+    assert(error == EEXIST);
+    bptree_test_validate(t);
+    printf("\n\t\t%llu random keys, height %u", bptree_size(t),
+           bptree_height(t));
+
+    for (uint64_t i = 1; i <= 2 * BPTREE_TEST_KEYS + 1; i++) {
+        error = bptree_find(t, i, &value);
+        assert(error == ((i % 2 == 0) ? 0 : ENOENT));
+        assert(error || value == i * 3);
+    }
+
+    /* Range scan from a missing key starts at the next one. */
+    bptree_seek(t, 1001, &c);
+    for (uint64_t i = 0; i < 100; i++) {
+        more = bptree_next(&c, &key, &value);
+        assert(more);
+        assert(key == 1002 + 2 * i && value == key * 3);
+    }
+    bptree_seek(t, 2 * BPTREE_TEST_KEYS + 1, &c);
+    more = bptree_next(&c, &key, &value);
+    assert(!more);
+
+    /* Delete every other key, then the rest, checking as leaves merge. */
+    for (uint64_t i = 0; i < BPTREE_TEST_KEYS; i += 2) {
+        error = bptree_delete(t, keys[i]);
+        assert(error == 0);
+    }
+    error = bptree_delete(t, keys[0]);
+    assert(error == ENOENT);
+    bptree_test_validate(t);
+    for (uint64_t i = 0; i < BPTREE_TEST_KEYS; i++) {
+        error = bptree_find(t, keys[i], NULL);
+        assert((error == 0) == (i % 2 == 1));
+    }
+    for (uint64_t i = 1; i < BPTREE_TEST_KEYS; i += 2) {
+        error = bptree_delete(t, keys[i]);
+        assert(error == 0);
+        if (i % 1000 == 1) {
+            bptree_test_validate(t);
+        }
+    }
+    assert(bptree_size(t) == 0 && bptree_height(t) == 0);
+
+    /* Bulk load, for each size up to a couple of levels. */
+    for (n = 0; n < BPTREE_TEST_KEYS; n = n * 2 + 1) {
+        for (uint64_t i = 0; i < n; i++) {
+            sorted[i] = 2 * (i + 1);
+            values[i] = sorted[i] * 3;
+        }
+        error = bptree_bulk_load(t, sorted, values, n);
+        assert(error == 0);
+        bptree_test_validate(t);
+        assert(bptree_size(t) == n);
+        if (n >= 2) {
+            error = bptree_bulk_load(t, sorted, values, n);
+            assert(error == EINVAL);
+        }
+
+        /* Keep inserting and deleting in the loaded tree. */
+        error = bptree_insert(t, 1, 3);
+        assert(error == 0);
+        error = bptree_insert(t, 2 * n + 3, 3 * (2 * n + 3));
+        assert(error == 0);
+        for (uint64_t i = 0; i < n; i += 3) {
+            error = bptree_delete(t, sorted[i]);
+            assert(error == 0);
+        }
+        bptree_test_validate(t);
+
+        destroy_bptree(t);
+        t = create_bptree();
+        if (t == NULL) {
+            goto done;
+        }
+    }
+    printf("\n\t\tbulk loads of up to %llu keys", (n - 1) / 2);
+
+    sorted[0] = 5;
+    sorted[1] = 5;
+    error = bptree_bulk_load(t, sorted, NULL, 2);
+    assert(error == EINVAL);
+    assert(bptree_size(t) == 0);
+
+done:
+    if (t) {
+        destroy_bptree(t);
+    }
+    printf("\n");
+}
+
+#define BT_ITER_CHAIN       1000000
+
+static uint64_t bt_iter_ref[64];
+static uint64_t bt_iter_ref_len = 0;
+
+static void
+bt_iter_ref_in(bt_node *n)
+{
+    if (n) {
+        bt_iter_ref_in(n->left);
+        bt_iter_ref[bt_iter_ref_len++] = n->key;
+        bt_iter_ref_in(n->right);
+    }
+}
+
+static void
+bt_iter_ref_pre(bt_node *n)
+{
+    if (n) {
+        bt_iter_ref[bt_iter_ref_len++] = n->key;
+        bt_iter_ref_pre(n->left);
+        bt_iter_ref_pre(n->right);
+    }
+}
+
+static void
+bt_iter_ref_post(bt_node *n)
+{
+    if (n) {
+        bt_iter_ref_post(n->left);
+        bt_iter_ref_post(n->right);
+        bt_iter_ref[bt_iter_ref_len++] = n->key;
+    }
+}
+
+static bool
+bt_iter_stop_after(bt_node *node, void *arg)
+{
+    uint64_t *left = (uint64_t *)arg;
+
+    return --(*left) > 0;
+}
+
+/*
+ * Check all four iterator orders against recursive references on a
+ * small BST, then walk a left leaning chain far deeper than a recursive
+ * traversal could go, and stop walks early.
+ */
+static void
+test_bt_iterators()
+{
+    uint64_t keys[] = {50, 30, 20, 67, 54, 23, 87, 10, 99, 60, 55, 31};
+    const uint64_t num_keys = sizeof(keys) / sizeof(keys[0]);
+    void (*refs[])(bt_node *) = {bt_iter_ref_in, bt_iter_ref_pre,
+                                 bt_iter_ref_post};
+    bt_node *root = NULL;
+    bt_node *chain = NULL;
+    bt_node *node = NULL;
+    bt_iter_t it;
+    uint64_t i = 0;
+    uint64_t left = 0;
+    int error = 0;
+
+    printf("\n\tTesting Binary Tree Iterators...");
+
+    for (i = 0; i < num_keys; i++) {
+        insert_to_bst(&root, keys[i]);
+    }
+
+    for (int order = BT_ORDER_IN; order <= BT_ORDER_POST; order++) {
+        bt_iter_ref_len = 0;
+        refs[order](root);
+        assert(bt_iter_ref_len == num_keys);
+
+        error = bt_iter_begin(&it, root, (bt_order_e)order);
+        assert(error == 0);
+        for (i = 0; (node = bt_iter_next(&it)) != NULL; i++) {
+            assert(node->key == bt_iter_ref[i]);
+        }
+        assert(i == num_keys && it.error == 0);
+        bt_iter_end(&it);
+    }
+
+    /* Level order of this BST, worked out by hand. */
+    {
+        uint64_t level[] = {50, 30, 67, 20, 31, 54, 87, 10, 23, 60, 99, 55};
+
+        error = bt_iter_begin(&it, root, BT_ORDER_LEVEL);
+        assert(error == 0);
+        for (i = 0; (node = bt_iter_next(&it)) != NULL; i++) {
+            assert(node->key == level[i]);
+        }
+        assert(i == num_keys);
+        bt_iter_end(&it);
+    }
+
+    error = bt_iter_begin(&it, NULL, BT_ORDER_IN);
+    assert(error == 0);
+    node = bt_iter_next(&it);
+    assert(node == NULL);
+    bt_iter_end(&it);
+    error = bt_iter_begin(&it, root, (bt_order_e)7);
+    assert(error == EINVAL);
+
+    /* Early exit, leaving work on the stack and queue. */
+    for (int order = BT_ORDER_IN; order <= BT_ORDER_LEVEL; order++) {
+        left = 5;
+        error = bt_traverse(root, (bt_order_e)order, bt_iter_stop_after,
+                            &left);
+        assert(error == 0);
+        assert(left == 0);
+    }
+
+    for (i = 0; i < num_keys; i++) {
+        delete_from_bst(&root, keys[i]);
+    }
+
+    /* chain[i] has key BT_ITER_CHAIN - 1 - i and left child chain[i + 1]. */
+    chain = (bt_node *)calloc(BT_ITER_CHAIN, sizeof(bt_node));
+    if (chain == NULL) {
+        printf("\n\t\tFailed to allocate chain");
+        goto done;
+    }
+    for (i = 0; i < BT_ITER_CHAIN; i++) {
+        chain[i].key = BT_ITER_CHAIN - 1 - i;
+        chain[i].left = (i + 1 < BT_ITER_CHAIN) ? &chain[i + 1] : NULL;
+    }
+
+    for (int order = BT_ORDER_IN; order <= BT_ORDER_LEVEL; order++) {
+        bool ascending = (order == BT_ORDER_IN || order == BT_ORDER_POST);
+
+        error = bt_iter_begin(&it, chain, (bt_order_e)order);
+        assert(error == 0);
+        for (i = 0; (node = bt_iter_next(&it)) != NULL; i++) {
+            assert(node->key == (ascending ? i : BT_ITER_CHAIN - 1 - i));
+        }
+        assert(i == BT_ITER_CHAIN && it.error == 0);
+        bt_iter_end(&it);
+    }
+    printf("\n\t\tWalked a %d deep chain in all four orders", BT_ITER_CHAIN);
+
+done:
+    free(chain);
+    printf("\n");
+}
+
+static int
+bst_test_height(bt_node *n)
+{
+    int l = 0;
+    int r = 0;
+
+    if (n == NULL) {
+        return 0;
+    }
+    l = bst_test_height(n->left);
+    r = bst_test_height(n->right);
+    return 1 + (l > r ? l : r);
+}
+
+/*
+ * Height of a perfectly balanced tree of 'n' nodes, ceil(log2(n + 1)).
+ */
+static int
+bst_test_min_height(uint64_t n)
+{
+    int h = 0;
+
+    while (n) {
+        h++;
+        n >>= 1;
+    }
+    return h;
+}
+
+/*
+ * In order walk must give 'n' ascending keys.
+ */
+static void
+bst_test_check_sorted(bt_node *root, uint64_t n)
+{
+    bt_iter_t it;
+    bt_node *node = NULL;
+    uint64_t count = 0;
+    uint64_t prev = 0;
+    int error = 0;
+
+    error = bt_iter_begin(&it, root, BT_ORDER_IN);
+    assert(error == 0);
+    while ((node = bt_iter_next(&it)) != NULL) {
+        assert(count == 0 || prev <= node->key);
+        prev = node->key;
+        count++;
+    }
+    bt_iter_end(&it);
+    assert(count == n);
+}
+
+static void
+test_bst_build()
+{
+    const uint64_t max_keys = 100000;
+    uint64_t *keys = NULL;
+    bt_node *root = NULL;
+    bt_node *node = NULL;
+    bt_iter_t it;
+    uint64_t i = 0;
+    uint64_t largest = 0;
+    int error = 0;
+
+    printf("\n\tTesting Balanced BST Build and Rebalance...");
+
+    keys = (uint64_t *)malloc(max_keys * sizeof(uint64_t));
+    if (keys == NULL) {
+        printf("\n\t\tFailed to allocate keys");
+        goto done;
+    }
+    for (i = 0; i < max_keys; i++) {
+        keys[i] = 3 * i;
+    }
+
+    for (uint64_t n = 1; n <= max_keys; n = n * 2 + (n % 3)) {
+        root = bst_build_from_sorted(keys, n);
+        assert(root != NULL);
+        bst_test_check_sorted(root, n);
+        assert(bst_test_height(root) == bst_test_min_height(n));
+
+        /* Level order visits the middle key first. */
+        error = bt_iter_begin(&it, root, BT_ORDER_LEVEL);
+        assert(error == 0);
+        for (i = 0; (node = bt_iter_next(&it)) != NULL; i++) {
+            assert(i != 0 || node->key == keys[n / 2]);
+        }
+        bt_iter_end(&it);
+        assert(i == n);
+
+        /* The nodes are ordinary: insert, rebalance, delete, destroy. */
+        insert_to_bst(&root, 1);
+        insert_to_bst(&root, 3 * n + 1);
+        bst_test_check_sorted(root, n + 2);
+        error = bst_rebalance(&root);
+        assert(error == 0);
+        bst_test_check_sorted(root, n + 2);
+        assert(bst_test_height(root) == bst_test_min_height(n + 2));
+        for (i = 0; i < n; i += 2) {
+            delete_from_bst(&root, keys[i]);
+        }
+        bst_test_check_sorted(root, n + 2 - (n + 1) / 2);
+        error = destroy_bt(&root);
+        assert(error == 0 && root == NULL);
+        largest = n;
+    }
+    printf("\n\t\tBuilt trees of up to %llu keys at minimum height",
+           largest);
+
+    node = bst_build_from_sorted(keys, 0);
+    assert(node == NULL);
+    keys[1] = 0;
+    keys[0] = 1;
+    node = bst_build_from_sorted(keys, 2);
+    assert(node == NULL);
+
+    /* insert_to_bst on sorted keys gives a list; rebalance it in place. */
+    root = NULL;
+    for (i = 0; i < 2000; i++) {
+        insert_to_bst(&root, i);
+    }
+    assert(bst_test_height(root) == 2000);
+    node = root;
+    error = bst_rebalance(&root);
+    assert(error == 0 && root == node);
+    assert(bst_test_height(root) == bst_test_min_height(2000));
+    bst_test_check_sorted(root, 2000);
+    for (i = 0; i < 2000; i++) {
+        node = delete_from_bst(&root, i);
+        assert(node == root);
+    }
+    assert(root == NULL);
+    error = bst_rebalance(&root);
+    assert(error == 0 && root == NULL);
+    printf("\n\t\tRebalanced a 2000 node list to height %d",
+           bst_test_min_height(2000));
+
+done:
+    free(keys);
     printf("\n");
-    return;
 }
 
 static void
@@ -165,9 +1524,9 @@ test_binary_tree_wrapper() {
      * NULL  23
      */
     const int num_tree_elements = 7;
-    uint64_t tree_elements[num_tree_elements] = {50, 30, 20, 67, 54, 23, 87};
-    uint64_t tree_elements_skewed_1[num_tree_elements] = {1, 2, 3, 4, 5, 6, 7};
-    uint64_t tree_elements_skewed_2[num_tree_elements] = {7, 6, 5, 4, 3, 2, 1};
+    uint64_t tree_elements[] = {50, 30, 20, 67, 54, 23, 87};
+    uint64_t tree_elements_skewed_1[] = {1, 2, 3, 4, 5, 6, 7};
+    uint64_t tree_elements_skewed_2[] = {7, 6, 5, 4, 3, 2, 1};
 
     test_binary_tree(tree_elements, num_tree_elements, false);
     test_binary_tree(tree_elements, num_tree_elements, true);
@@ -177,6 +1536,12 @@ test_binary_tree_wrapper() {
 
     test_binary_tree(tree_elements_skewed_2, num_tree_elements, false);
     test_binary_tree(tree_elements_skewed_2, num_tree_elements, true);
+
+    test_binary_tree_large();
+    test_bt_iterators();
+    test_bst_build();
+    test_avl_tree();
+    test_bptree();
 }
 
 static void
@@ -187,6 +1552,7 @@ test_stack()
     const uint64_t stack_capacity = 15;
     const uint64_t run_capacity = 10;
     uint64_t elem = -1;
+    int error = 0;
     dsa_stack_t *s = create_dsa_stack(stack_capacity);
     if (s == NULL) {
         printf("\n\t\tFailed to allocate stack");
@@ -217,6 +1583,14 @@ test_stack()
         printf("\n\t\tStack is empty.");
     }
 
+    for (int i = 0; i < stack_capacity; i++) {
+        error = dsa_stack_push(s, i);
+        assert(error == 0);
+    }
+    assert(dsa_stack_is_full(s));
+    error = dsa_stack_push(s, 0);
+    assert(error == EFAULT);
+
 done:
     if (s) {
         destroy_dsa_stack(s);
@@ -225,6 +1599,300 @@ done:
     return;
 }
 
+#define STACK_TEST_DEEP     (3 * DSA_STACK_CHUNK_SIZE + 7)
+
+static void
+test_stack_segmented(void)
+{
+    dsa_stack_t local;
+    dsa_stack_t *s = create_dsa_stack_flags(0, DSA_STACK_F_GROW);
+    uint64_t elem = 0;
+    int error = 0;
+
+    printf("\n\tTesting Segmented Stack...");
+
+    if (s == NULL) {
+        printf("\n\t\tFailed to allocate stack");
+        goto done;
+    }
+
+    /* Fill the inline array and several chunks, then drain. */
+    for (uint64_t i = 0; i < STACK_TEST_DEEP; i++) {
+        error = dsa_stack_push(s, i);
+        assert(error == 0);
+        error = dsa_stack_top(s, &elem);
+        assert(error == 0 && elem == i);
+    }
+    assert(!dsa_stack_is_full(s));
+    for (uint64_t i = STACK_TEST_DEEP; i-- > 0; ) {
+        error = dsa_stack_top(s, &elem);
+        assert(error == 0 && elem == i);
+        error = dsa_stack_pop(s, &elem);
+        assert(error == 0 && elem == i);
+    }
+    assert(dsa_stack_is_empty(s));
+    error = dsa_stack_pop(s, &elem);
+    assert(error == EFAULT);
+    assert(s->chunk == NULL && s->spare != NULL);
+    printf("\n\t\tPushed and popped %d keys across chunks of %d",
+           STACK_TEST_DEEP, DSA_STACK_CHUNK_SIZE);
+
+    /* Hovering on a chunk boundary reuses the spare chunk. */
+    for (uint64_t i = 0; i < DSA_STACK_INLINE_SIZE; i++) {
+        error = dsa_stack_push(s, i);
+        assert(error == 0);
+    }
+    for (int i = 0; i < 1000; i++) {
+        dsa_stack_chunk_t *spare = s->spare;
+
+        error = dsa_stack_push(s, i);
+        assert(error == 0 && s->chunk == spare);
+        error = dsa_stack_pop(s, &elem);
+        assert(error == 0 && elem == i);
+        assert(s->chunk == NULL && s->spare == spare);
+    }
+    printf("\n\t\tBoundary push/pop reused the spare chunk");
+
+    /* A shallow stack in local storage never allocates. */
+    dsa_stack_init(&local, 0, DSA_STACK_F_GROW);
+    for (uint64_t i = 0; i < DSA_STACK_INLINE_SIZE; i++) {
+        error = dsa_stack_push(&local, i);
+        assert(error == 0);
+    }
+    assert(local.chunk == NULL && local.spare == NULL);
+    dsa_stack_fini(&local);
+
+done:
+    if (s) {
+        destroy_dsa_stack(s);
+    }
+    printf("\n");
+}
+
+#define TREIBER_TEST_THREADS    4
+#define TREIBER_TEST_NODES      256
+#define TREIBER_TEST_ROUNDS     20000
+#define TREIBER_TEST_BATCH      4
+
+typedef struct treiber_test_node_ {
+    treiber_node_t node;        // First, so a popped node casts back.
+    _Atomic int in_use;
+} treiber_test_node_t;
+
+/*
+ * Pop a few nodes, check no other thread holds them, and push them back
+ * one at a time or as a batch.
+ */
+static void *
+treiber_test_worker(void *arg)
+{
+    treiber_stack_t *s = (treiber_stack_t *)arg;
+    treiber_node_t *held[TREIBER_TEST_BATCH];
+    int in_use = 0;
+    int error = 0;
+
+    for (int r = 0; r < TREIBER_TEST_ROUNDS; r++) {
+        int n = 1 + r % TREIBER_TEST_BATCH;
+        int got = 0;
+
+        while (got < n) {
+            if (treiber_stack_pop(s, &held[got]) != 0) {
+                sched_yield();
+                continue;
+            }
+            in_use = atomic_exchange(
+                &((treiber_test_node_t *)held[got])->in_use, 1);
+            assert(in_use == 0);
+            got++;
+        }
+
+        for (int i = 0; i < n; i++) {
+            atomic_store(&((treiber_test_node_t *)held[i])->in_use, 0);
+        }
+        if (r & 1) {
+            error = treiber_stack_push_batch(s, held, n);
+            assert(error == 0);
+        } else {
+            for (int i = 0; i < n; i++) {
+                error = treiber_stack_push(s, held[i]);
+                assert(error == 0);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void
+test_treiber_stack(void)
+{
+    static treiber_test_node_t nodes[TREIBER_TEST_NODES];
+    uint32_t modes[] = {0, TREIBER_F_ELIMINATE};
+    treiber_node_t *batch[3] = {&nodes[0].node, &nodes[1].node,
+                                &nodes[2].node};
+    treiber_node_t *out = NULL;
+    treiber_stack_t *s = NULL;
+    int error = 0;
+
+    printf("\n\tTesting Treiber Stack...");
+
+    for (int m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        pthread_t threads[TREIBER_TEST_THREADS];
+        uint64_t count = 0;
+
+        s = create_treiber_stack(modes[m]);
+        if (s == NULL) {
+            printf("\n\t\tFailed to allocate Treiber stack");
+            goto done;
+        }
+
+        /* Single threaded order checks. */
+        error = treiber_stack_pop(s, &out);
+        assert(error == ENOENT);
+        out = treiber_stack_pop_all(s);
+        assert(out == NULL);
+        error = treiber_stack_push_batch(s, batch, 3);
+        assert(error == 0);
+        error = treiber_stack_push(s, &nodes[3].node);
+        assert(error == 0);
+        error = treiber_stack_pop(s, &out);
+        assert(error == 0 && out == &nodes[3].node);
+        out = treiber_stack_pop_all(s);
+        for (int i = 2; i >= 0; i--) {
+            assert(out == &nodes[i].node);
+            out = atomic_load(&out->next);
+        }
+        assert(out == NULL && treiber_stack_is_empty(s));
+
+        for (int i = 0; i < TREIBER_TEST_NODES; i++) {
+            atomic_init(&nodes[i].in_use, 0);
+            error = treiber_stack_push(s, &nodes[i].node);
+            assert(error == 0);
+        }
+        for (int i = 0; i < TREIBER_TEST_THREADS; i++) {
+            pthread_create(&threads[i], NULL, treiber_test_worker, s);
+        }
+        for (int i = 0; i < TREIBER_TEST_THREADS; i++) {
+            pthread_join(threads[i], NULL);
+        }
+
+        /* Nothing lost or duplicated. */
+        for (out = treiber_stack_pop_all(s); out;
+             out = atomic_load(&out->next)) {
+            assert(atomic_load(&((treiber_test_node_t *)out)->in_use) == 0);
+            count++;
+        }
+        assert(count == TREIBER_TEST_NODES);
+        printf("\n\t\t%d threads cycled %d nodes%s", TREIBER_TEST_THREADS,
+               TREIBER_TEST_NODES, modes[m] ? " with elimination" : "");
+
+        destroy_treiber_stack(s);
+        s = NULL;
+    }
+
+done:
+    if (s) {
+        destroy_treiber_stack(s);
+    }
+    printf("\n");
+}
+
+static void *
+arena_test_thread(void *arg)
+{
+    arena_t **out = (arena_t **)arg;
+
+    void *p = NULL;
+
+    *out = arena_thread();
+    assert(*out != NULL);
+    p = arena_alloc(*out, 100);
+    assert(p != NULL);
+    return NULL;
+}
+
+static void
+test_arena(void)
+{
+    arena_t *a = create_arena(1024);
+    arena_t *mine = NULL;
+    arena_t *other = NULL;
+    arena_mark_t outer, inner;
+    pthread_t thread;
+    uint8_t *p = NULL;
+    uint8_t *q = NULL;
+    void *r = NULL;
+    uint64_t chunks = 0;
+    int error = 0;
+
+    printf("\n\tTesting Arena Allocator...");
+
+    if (a == NULL) {
+        printf("\n\t\tFailed to allocate arena");
+        goto done;
+    }
+
+    /* Bump allocation is aligned and contiguous within a chunk. */
+    p = arena_alloc(a, 1);
+    q = arena_alloc(a, 1);
+    assert(p && q && q == p + ARENA_ALIGN);
+    assert(((uintptr_t)p % ARENA_ALIGN) == 0);
+    r = arena_calloc(a, SIZE_MAX / 2, 4);
+    assert(r == NULL);
+    r = arena_alloc(a, SIZE_MAX - 3);
+    assert(r == NULL);
+    r = arena_calloc(a, 1, SIZE_MAX - 3);
+    assert(r == NULL);
+
+    /* Nested marks, each released back to exactly where it was taken. */
+    outer = arena_mark(a);
+    p = arena_alloc(a, 600);
+    inner = arena_mark(a);
+    q = arena_alloc(a, 600);            // Does not fit: second chunk.
+    assert(q && a->ar_num_chunks == 2);
+    r = arena_alloc(a, 5000);           // Oversized: its own chunk.
+    assert(r != NULL);
+    error = arena_release(a, inner);
+    assert(error == 0);
+    r = arena_alloc(a, 16);
+    assert(r == (void *)(p + 608));
+    error = arena_release(a, outer);
+    assert(error == 0);
+    error = arena_release(a, inner);
+    assert(error == EINVAL);
+    r = arena_alloc(a, 600);
+    assert(r == p);
+
+    /* Released chunks are reused: a repeat allocates nothing. */
+    chunks = a->ar_num_chunks;
+    for (int i = 0; i < 100; i++) {
+        outer = arena_mark(a);
+        p = arena_alloc(a, 600);
+        q = arena_alloc(a, 5000);
+        assert(p && q);
+        error = arena_release(a, outer);
+        assert(error == 0);
+    }
+    assert(a->ar_num_chunks == chunks);
+    arena_reset(a);
+    assert(a->ar_chunk == NULL);
+    printf("\n\t\tMarks nest and released chunks are reused (%llu chunks)",
+           chunks);
+
+    /* One arena per thread. */
+    mine = arena_thread();
+    assert(mine != NULL && mine == arena_thread());
+    pthread_create(&thread, NULL, arena_test_thread, &other);
+    pthread_join(thread, NULL);
+    assert(other != NULL && other != mine);
+
+done:
+    if (a) {
+        destroy_arena(a);
+    }
+    printf("\n");
+}
+
 static void
 delete_heap_min_max(heap_t *h)
 {
@@ -264,74 +1932,554 @@ print_heap_min_max(heap_t *h)
 }
 
 static void
-test_heap_common(heap_type_e type)
+test_heap_common(heap_type_e type)
+{
+    const uint64_t heap_size = 15;
+
+    heap_t *h = create_heap(type, heap_size);
+    if (h == NULL) {
+        printf("\n\t\tFailed to allocate heap");
+        goto done;
+    }
+
+    for (int i = 0 ; i < heap_size; i++) {
+        heap_elem_t elem = {0};
+        elem.key = i + 10;
+        printf("\n\t\tInserting Element %llu to heap", elem.key);
+        insert_heap(h, &elem);
+        print_heap_min_max(h);
+        printf("\n\t\t\tHeap after insert: ");
+        print_heap(h);
+    }
+
+    for (int i = 0 ; i < heap_size; i++) {
+        printf("\n\t\tDeleting root %d time from heap", i + 1);
+        delete_heap_min_max(h);
+        print_heap_min_max(h);
+        printf("\n\t\t\tHeap after delete: ");
+        print_heap(h);
+    }
+
+    for (int i = 0 ; i < heap_size; i++) {
+        heap_elem_t elem = {0};
+        elem.key = i + 10;
+        printf("\n\t\tInserting Element %llu to heap", elem.key);
+        insert_heap(h, &elem);
+        print_heap_min_max(h);
+        printf("\n\t\t\tHeap after insert: ");
+        print_heap(h);
+    }
+
+    for (int i = 0 ; i < heap_size; i++) {
+        heap_elem_t elem = {0};
+        elem.key = i + 10;
+        printf("\n\t\tDeleting element %d time from heap", i + 10);
+        delete_heap(h, &elem);
+        print_heap_min_max(h);
+        printf("\n\t\t\tHeap after delete: ");
+        print_heap(h);
+    }
+
+
+done:
+    if (h) {
+        destroy_heap(h);
+    }
+    printf("\n");
+}
+
+static void
+test_min_heap()
+{
+    printf("\n\tTesting MIN Heap...");
+    test_heap_common(MIN_HEAP);
+}
+
+static void
+test_max_heap()
+{
+    printf("\n\tTesting MAX Heap...");
+    test_heap_common(MAX_HEAP);
+}
+
+static void
+test_heap_bulk_common(heap_type_e type)
+{
+    const uint64_t num_elems = 1000;
+    const uint64_t batch = 100;
+    heap_elem_t *elems = NULL;
+    heap_elem_t *out = NULL;
+    heap_elem_t extra = {0};
+    heap_elem_t last = {0};
+    uint64_t popped = 0;
+    uint64_t total = 0;
+    uint64_t peak_capacity = 0;
+    int error = 0;
+
+    heap_t *fixed = create_heap(type, 4);
+    heap_t *h = create_heap_flags(type, 0, HEAP_F_GROW | HEAP_F_SHRINK);
+    elems = (heap_elem_t *)malloc(num_elems * sizeof(heap_elem_t));
+    out = (heap_elem_t *)malloc(batch * sizeof(heap_elem_t));
+    if (fixed == NULL || h == NULL || elems == NULL || out == NULL) {
+        printf("\n\t\tFailed to allocate heap");
+        goto done;
+    }
+
+    for (uint64_t i = 0; i < num_elems; i++) {
+        elems[i].key = rand() % 5000;
+    }
+
+    printf("\n\t\tFixed heap rejects bulk load past capacity...");
+    error = heap_build_from_array(fixed, elems, 5);
+    assert(error == EFAULT);
+    error = heap_build_from_array(fixed, elems, 4);
+    assert(error == 0);
+    error = insert_heap(fixed, &extra);
+    assert(error == EFAULT);
+
+    printf("\n\t\tBuilding growable heap from %llu elements...", num_elems);
+    error = heap_build_from_array(h, elems, num_elems / 2);
+    assert(error == 0);
+    error = heap_push_batch(h, &elems[num_elems / 2], num_elems / 4);
+    assert(error == 0);
+    error = heap_push_batch(h, &elems[num_elems / 2 + num_elems / 4],
+                            num_elems - num_elems / 2 - num_elems / 4);
+    assert(error == 0);
+    assert(h->h_curr_size == num_elems);
+    peak_capacity = h->h_capacity;
+    printf("\n\t\tCapacity after build: %llu", peak_capacity);
+
+    printf("\n\t\tFirst popped batch: ");
+    while (h->h_curr_size != 0) {
+        error = heap_pop_batch(h, out, batch, &popped);
+        assert(error == 0 && popped > 0);
+        for (uint64_t i = 0; i < popped; i++) {
+            if (total == 0 && i < 10) {
+                printf("%llu ", out[i].key);
+            }
+            /* Compare against the previous key, even across batches. */
+            if (total + i > 0) {
+                assert((type == MIN_HEAP) ? (last.key <= out[i].key) :
+                                            (last.key >= out[i].key));
+            }
+            last = out[i];
+        }
+        total += popped;
+    }
+    assert(total == num_elems);
+    assert(h->h_capacity < peak_capacity);
+    printf("\n\t\tCapacity after draining: %llu", h->h_capacity);
+
+done:
+    if (fixed) {
+        destroy_heap(fixed);
+    }
+    if (h) {
+        destroy_heap(h);
+    }
+    free(elems);
+    free(out);
+    printf("\n");
+}
+
+static void
+test_heap_bulk()
+{
+    printf("\n\tTesting Growable MIN Heap Bulk Operations...");
+    test_heap_bulk_common(MIN_HEAP);
+    printf("\n\tTesting Growable MAX Heap Bulk Operations...");
+    test_heap_bulk_common(MAX_HEAP);
+}
+
+static void
+test_indexed_heap_common(heap_type_e type)
+{
+    const uint64_t max_ids = 16;
+    idx_heap_elem_t top = {0};
+    uint64_t prev = 0;
+    int error = 0;
+
+    idx_heap_t *h = create_idx_heap(type, max_ids);
+    if (h == NULL) {
+        printf("\n\t\tFailed to allocate indexed heap");
+        goto done;
+    }
+
+    for (uint64_t id = 0; id < max_ids; id++) {
+        error = idx_heap_insert(h, id, 100 + (id * 37) % max_ids,
+                                (void *)(uintptr_t)(id * 10));
+        assert(error == 0);
+    }
+    printf("\n\t\tIndexed heap after insert: ");
+    print_idx_heap(h);
+
+    error = idx_heap_insert(h, 3, 1, NULL);
+    assert(error == EEXIST);
+    error = idx_heap_insert(h, max_ids, 1, NULL);
+    assert(error == ERANGE);
+
+    /* Move id 5 to the top and id 7 to the bottom. */
+    if (type == MIN_HEAP) {
+        error = idx_heap_decrease_key(h, 5, 1);
+        assert(error == 0);
+        error = idx_heap_increase_key(h, 7, 1000);
+        assert(error == 0);
+        error = idx_heap_increase_key(h, 5, 0);
+        assert(error == EINVAL);
+    } else {
+        error = idx_heap_increase_key(h, 5, 1000);
+        assert(error == 0);
+        error = idx_heap_decrease_key(h, 7, 1);
+        assert(error == 0);
+        error = idx_heap_decrease_key(h, 5, 2000);
+        assert(error == EINVAL);
+    }
+    idx_heap_peek(h, &top);
+    assert(top.id == 5);
+    printf("\n\t\tIndexed heap after key changes: ");
+    print_idx_heap(h);
+
+    error = idx_heap_remove(h, 11, &top);
+    assert(error == 0 && top.id == 11);
+    assert(!idx_heap_contains(h, 11));
+    error = idx_heap_remove(h, 11, &top);
+    assert(error == ENOENT);
+    printf("\n\t\tIndexed heap after removing id 11: ");
+    print_idx_heap(h);
+
+    printf("\n\t\tPopping: ");
+    for (uint64_t i = 0; !idx_heap_is_empty(h); i++) {
+        idx_heap_pop(h, &top);
+        assert((uintptr_t)top.payload == top.id * 10);
+        if (i > 0) {
+            assert((type == MIN_HEAP) ? (prev <= top.priority) :
+                                        (prev >= top.priority));
+        }
+        prev = top.priority;
+        printf("%llu(id %llu) ", top.priority, top.id);
+    }
+    assert(top.id == 7);
+
+done:
+    if (h) {
+        destroy_idx_heap(h);
+    }
+    printf("\n");
+}
+
+static void
+test_indexed_heap()
+{
+    printf("\n\tTesting Indexed MIN Heap...");
+    test_indexed_heap_common(MIN_HEAP);
+    printf("\n\tTesting Indexed MAX Heap...");
+    test_indexed_heap_common(MAX_HEAP);
+}
+
+static void
+test_pairing_heap_common(heap_type_e type)
+{
+    const uint64_t num_elems = 200;
+    pairing_heap_node_t *nodes[num_elems];
+    pairing_heap_t *h = create_pairing_heap(type);
+    pairing_heap_t *other = create_pairing_heap(type);
+    uint64_t key = 0;
+    uint64_t prev = 0;
+    void *payload = NULL;
+    uint64_t count = 0;
+    int error = 0;
+
+    if (h == NULL || other == NULL) {
+        printf("\n\t\tFailed to allocate pairing heap");
+        goto done;
+    }
+
+    for (uint64_t i = 0; i < num_elems; i++) {
+        pairing_heap_t *target = (i % 2) ? h : other;
+        nodes[i] = pairing_heap_insert(target, 1000 + rand() % 1000,
+                                       (void *)(uintptr_t)i);
+        assert(nodes[i] != NULL);
+    }
+
+    printf("\n\t\tMelding two heaps of %llu elements...", num_elems / 2);
+    error = pairing_heap_meld(h, other);
+    assert(error == 0);
+    assert(h->ph_size == num_elems && pairing_heap_is_empty(other));
+
+    /* Node 7 becomes the top, node 9 the bottom, node 11 goes away. */
+    if (type == MIN_HEAP) {
+        error = pairing_heap_decrease_key(h, nodes[7], 1);
+        assert(error == 0);
+        error = pairing_heap_increase_key(h, nodes[9], 5000);
+        assert(error == 0);
+        error = pairing_heap_decrease_key(h, nodes[9], 6000);
+        assert(error == EINVAL);
+    } else {
+        error = pairing_heap_increase_key(h, nodes[7], 5000);
+        assert(error == 0);
+        error = pairing_heap_decrease_key(h, nodes[9], 1);
+        assert(error == 0);
+        error = pairing_heap_increase_key(h, nodes[9], 0);
+        assert(error == EINVAL);
+    }
+    assert(pairing_heap_top(h) == nodes[7]);
+    error = pairing_heap_remove(h, nodes[11]);
+    assert(error == 0);
+
+    printf("\n\t\tFirst pops: ");
+    while (pairing_heap_pop(h, &key, &payload) == 0) {
+        if (count > 0) {
+            assert((type == MIN_HEAP) ? (prev <= key) : (prev >= key));
+        }
+        assert((uintptr_t)payload != 11);
+        if (count < 10) {
+            printf("%llu ", key);
+        }
+        prev = key;
+        count++;
+    }
+    assert(count == num_elems - 1);
+    assert((uintptr_t)payload == 9);
+
+done:
+    if (h) {
+        destroy_pairing_heap(h);
+    }
+    if (other) {
+        destroy_pairing_heap(other);
+    }
+    printf("\n");
+}
+
+static void
+test_pairing_heap()
+{
+    printf("\n\tTesting Pairing MIN Heap...");
+    test_pairing_heap_common(MIN_HEAP);
+    printf("\n\tTesting Pairing MAX Heap...");
+    test_pairing_heap_common(MAX_HEAP);
+}
+
+static void
+test_radix_heap()
+{
+    radix_heap_t *h = create_radix_heap();
+    heap_elem_t elem = {0};
+    heap_elem_t *min = NULL;
+    uint64_t last = 0;
+    uint64_t count = 0;
+    int error = 0;
+
+    printf("\n\tTesting Radix Heap...");
+
+    if (h == NULL) {
+        printf("\n\t\tFailed to allocate radix heap");
+        goto done;
+    }
+
+    for (int i = 0; i < 50; i++) {
+        elem.key = rand() % 1000;
+        insert_radix_heap(h, &elem);
+    }
+    elem.key = UINT64_MAX;
+    insert_radix_heap(h, &elem);
+
+    /*
+     * Dijkstra style: every pop pushes a couple of keys at or above the
+     * popped key, never below it.
+     */
+    printf("\n\t\tMonotone pops: ");
+    while ((min = get_radix_heap_min(h)) != NULL) {
+        assert(min->key >= last);
+        error = delete_radix_heap_min(h, &elem);
+        assert(error == 0 && elem.key == min->key);
+        last = elem.key;
+        if (count < 15) {
+            printf("%llu ", last);
+        }
+        if (count < 100 && last != UINT64_MAX) {
+            heap_elem_t near = {last + rand() % 50};
+            heap_elem_t far = {last + rand() % 5000};
+            insert_radix_heap(h, &near);
+            insert_radix_heap(h, &far);
+        }
+        count++;
+    }
+    assert(last == UINT64_MAX);
+    printf("\n\t\tPopped %llu keys, last %llu", count, last);
+
+    elem.key = 5;
+    error = insert_radix_heap(h, &elem);
+    assert(error == EINVAL);
+    error = delete_radix_heap_min(h, &elem);
+    assert(error == EFAULT);
+
+done:
+    if (h) {
+        destroy_radix_heap(h);
+    }
+    printf("\n");
+}
+
+static int
+cmp_heap_keys(const void *a, const void *b)
+{
+    uint64_t x = ((const heap_elem_t *)a)->key;
+    uint64_t y = ((const heap_elem_t *)b)->key;
+
+    return (x > y) - (x < y);
+}
+
+static void
+test_minmax_heap()
 {
-    const uint64_t heap_size = 15;
+    minmax_heap_t *h = create_minmax_heap(4, HEAP_F_GROW | HEAP_F_SHRINK);
+    heap_elem_t ref[500];
+    heap_elem_t elem = {0};
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+    int num = sizeof(ref) / sizeof(ref[0]);
+    int error = 0;
+
+    printf("\n\tTesting Min-Max Heap...");
 
-    heap_t *h = create_heap(type, heap_size);
     if (h == NULL) {
-        printf("\n\t\tFailed to allocate heap");
+        printf("\n\t\tFailed to allocate min-max heap");
         goto done;
     }
 
-    for (int i = 0 ; i < heap_size; i++) {
-        heap_elem_t elem = {0};
-        elem.key = i + 10;
-        printf("\n\t\tInserting Element %llu to heap", elem.key);
-        insert_heap(h, &elem);
-        print_heap_min_max(h);
-        printf("\n\t\t\tHeap after insert: ");
-        print_heap(h);
+    for (int i = 0; i < num; i++) {
+        ref[i].key = rand() % 1000;
+        insert_minmax_heap(h, &ref[i]);
     }
+    qsort(ref, num, sizeof(ref[0]), cmp_heap_keys);
 
-    for (int i = 0 ; i < heap_size; i++) {
-        printf("\n\t\tDeleting root %d time from heap", i + 1);
-        delete_heap_min_max(h);
-        print_heap_min_max(h);
-        printf("\n\t\t\tHeap after delete: ");
-        print_heap(h);
+    /* Drain from alternating ends against the sorted copy. */
+    hi = num;
+    printf("\n\t\tAlternating min/max: ");
+    while (!minmax_heap_is_empty(h)) {
+        assert(get_minmax_heap_min(h)->key == ref[lo].key);
+        assert(get_minmax_heap_max(h)->key == ref[hi - 1].key);
+        if ((lo + hi) % 2) {
+            error = delete_minmax_heap_min(h, &elem);
+            assert(elem.key == ref[lo].key);
+            lo++;
+        } else {
+            error = delete_minmax_heap_max(h, &elem);
+            hi--;
+            assert(elem.key == ref[hi].key);
+        }
+        assert(error == 0);
+        if (lo + (num - hi) <= 10) {
+            printf("%llu ", elem.key);
+        }
     }
+    assert(lo == hi);
 
-    for (int i = 0 ; i < heap_size; i++) {
-        heap_elem_t elem = {0};
-        elem.key = i + 10;
-        printf("\n\t\tInserting Element %llu to heap", elem.key);
-        insert_heap(h, &elem);
-        print_heap_min_max(h);
-        printf("\n\t\t\tHeap after insert: ");
-        print_heap(h);
-    }
+    error = delete_minmax_heap_min(h, &elem);
+    assert(error == EFAULT);
+    error = delete_minmax_heap_max(h, &elem);
+    assert(error == EFAULT);
 
-    for (int i = 0 ; i < heap_size; i++) {
-        heap_elem_t elem = {0};
-        elem.key = i + 10;
-        printf("\n\t\tDeleting element %d time from heap", i + 10);
-        delete_heap(h, &elem);
-        print_heap_min_max(h);
-        printf("\n\t\t\tHeap after delete: ");
-        print_heap(h);
+    /* Bounded window keeping the 10 smallest keys seen so far. */
+    for (int i = 0; i < num; i++) {
+        elem.key = rand() % 100000;
+        insert_minmax_heap(h, &elem);
+        if (minmax_heap_size(h) > 10) {
+            delete_minmax_heap_max(h, NULL);
+        }
     }
-
+    printf("\n\t\tBottom 10 window: ");
+    print_minmax_heap(h);
+    assert(minmax_heap_size(h) == 10);
 
 done:
     if (h) {
-        destroy_heap(h);
+        destroy_minmax_heap(h);
     }
     printf("\n");
 }
 
-static void
-test_min_heap()
+#define MQ_TEST_THREADS     4
+#define MQ_TEST_KEYS        20000
+
+typedef struct mq_test_arg_ {
+    multiqueue_t *mq;
+    uint64_t id;
+    uint8_t *seen;
+    uint64_t popped;
+} mq_test_arg_t;
+
+static void *
+multiqueue_test_thread(void *arg)
 {
-    printf("\n\tTesting MIN Heap...");
-    test_heap_common(MIN_HEAP);
+    mq_test_arg_t *t = (mq_test_arg_t *)arg;
+    heap_elem_t elem = {0};
+
+    for (uint64_t k = t->id; k < MQ_TEST_KEYS; k += MQ_TEST_THREADS) {
+        elem.key = k;
+        multiqueue_insert(t->mq, &elem);
+    }
+
+    while (multiqueue_delete_min(t->mq, &elem) == 0) {
+        __atomic_fetch_add(&t->seen[elem.key], 1, __ATOMIC_RELAXED);
+        t->popped++;
+    }
+
+    return NULL;
 }
 
 static void
-test_max_heap()
+test_multiqueue()
 {
-    printf("\n\tTesting MAX Heap...");
-    test_heap_common(MAX_HEAP);
+    pthread_t threads[MQ_TEST_THREADS];
+    mq_test_arg_t args[MQ_TEST_THREADS];
+    uint8_t *seen = (uint8_t *)calloc(MQ_TEST_KEYS, sizeof(uint8_t));
+    multiqueue_t *mq = create_multiqueue(MQ_TEST_THREADS, 2);
+    heap_elem_t elem = {0};
+    uint64_t total = 0;
+    int error = 0;
+
+    printf("\n\tTesting MultiQueue...");
+
+    if (mq == NULL || seen == NULL) {
+        printf("\n\t\tFailed to allocate MultiQueue");
+        goto done;
+    }
+
+    for (uint64_t i = 0; i < MQ_TEST_THREADS; i++) {
+        args[i].mq = mq;
+        args[i].id = i;
+        args[i].seen = seen;
+        args[i].popped = 0;
+        pthread_create(&threads[i], NULL, multiqueue_test_thread, &args[i]);
+    }
+    for (int i = 0; i < MQ_TEST_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        total += args[i].popped;
+    }
+
+    /* Each thread drained after its own inserts, so nothing is left. */
+    error = multiqueue_delete_min(mq, &elem);
+    assert(error == ENOENT);
+
+    for (uint64_t k = 0; k < MQ_TEST_KEYS; k++) {
+        assert(seen[k] == 1);
+    }
+    assert(total == MQ_TEST_KEYS);
+    printf("\n\t\t%d threads over %llu heaps popped %llu keys exactly once.",
+           MQ_TEST_THREADS, multiqueue_num_heaps(mq), total);
+
+    elem.key = UINT64_MAX;
+    error = multiqueue_insert(mq, &elem);
+    assert(error == EINVAL);
+
+done:
+    if (mq) {
+        destroy_multiqueue(mq);
+    }
+    free(seen);
+    printf("\n");
 }
 
 static void
@@ -465,11 +2613,224 @@ test_doubly_linked_list()
     printf("\n");
 }
 
+static void
+test_singly_linked_list_bulk()
+{
+    int error = 0;
+    slist_node_t *head = NULL;
+    slist_node_t *other = NULL;
+    slist_node_t *rest = NULL;
+    slist_node_t *temp = NULL;
+    uint64_t count = 0;
+
+    printf("\n\tTesting Singly Linked List Bulk Operations...");
+
+    for (int i = 0; i < 20; i++) {
+        insert_slist_head(&head, (i * 7) % 10, 0);
+    }
+    printf("\n\t\tSLL before sort: ");
+    slist_foreach(head, print_slist_node);
+
+    slist_sort(&head);
+    printf("\n\t\tSLL after sort: ");
+    slist_foreach(head, print_slist_node);
+    for (temp = head; temp && temp->next; temp = temp->next) {
+        assert(temp->key_node.key <= temp->next->key_node.key);
+    }
+
+    slist_dedupe(&head);
+    printf("\n\t\tSLL after dedupe: ");
+    slist_foreach(head, print_slist_node);
+
+    for (int i = 20; i >= 10; i -= 2) {
+        insert_slist_head(&other, i, 0);
+    }
+    slist_merge(&head, other);
+    printf("\n\t\tSLL after merge with 10..20 step 2: ");
+    slist_foreach(head, print_slist_node);
+    for (temp = head; temp && temp->next; temp = temp->next) {
+        assert(temp->key_node.key <= temp->next->key_node.key);
+    }
+
+    slist_reverse(&head);
+    printf("\n\t\tSLL after reverse: ");
+    slist_foreach(head, print_slist_node);
+
+    error = slist_split_at(&head, 5, &rest);
+    assert(error == 0);
+    printf("\n\t\tSLL split at 5, first: ");
+    slist_foreach(head, print_slist_node);
+    printf("\n\t\tSLL split at 5, rest: ");
+    slist_foreach(rest, print_slist_node);
+    for (temp = head, count = 0; temp; temp = temp->next) {
+        count++;
+    }
+    assert(count == 5);
+
+    error = slist_split_at(&rest, 100, &temp);
+    assert(error == ERANGE);
+
+    slist_merge(&head, rest);
+    slist_destroy(&head);
+
+    printf("\n");
+}
+
+static void
+test_doubly_linked_list_bulk()
+{
+    int error = 0;
+    dlist_node_t *head = NULL;
+    dlist_node_t *other = NULL;
+    dlist_node_t *rest = NULL;
+    dlist_node_t *temp = NULL;
+
+    printf("\n\tTesting Doubly Linked List Bulk Operations...");
+
+    for (int i = 0; i < 20; i++) {
+        insert_dlist_head(&head, (i * 7) % 10);
+    }
+    printf("\n\t\tDLL before sort: ");
+    dlist_foreach(head, print_dlist_node);
+
+    dlist_sort(&head);
+    printf("\n\t\tDLL after sort: ");
+    dlist_foreach(head, print_dlist_node);
+    assert(head->prev == NULL);
+    for (temp = head; temp && temp->next; temp = temp->next) {
+        assert(temp->key_node.key <= temp->next->key_node.key);
+        assert(temp->next->prev == temp);
+    }
+
+    dlist_dedupe(&head);
+    printf("\n\t\tDLL after dedupe: ");
+    dlist_foreach(head, print_dlist_node);
+
+    for (int i = 20; i >= 10; i -= 2) {
+        insert_dlist_head(&other, i);
+    }
+    dlist_merge(&head, other);
+    printf("\n\t\tDLL after merge with 10..20 step 2: ");
+    dlist_foreach(head, print_dlist_node);
+
+    dlist_reverse(&head);
+    printf("\n\t\tDLL after reverse: ");
+    dlist_foreach(head, print_dlist_node);
+    assert(head->prev == NULL);
+    for (temp = head; temp && temp->next; temp = temp->next) {
+        assert(temp->key_node.key >= temp->next->key_node.key);
+        assert(temp->next->prev == temp);
+    }
+
+    error = dlist_split_at(&head, 5, &rest);
+    assert(error == 0);
+    assert(rest == NULL || rest->prev == NULL);
+    printf("\n\t\tDLL split at 5, first: ");
+    dlist_foreach(head, print_dlist_node);
+    printf("\n\t\tDLL split at 5, rest: ");
+    dlist_foreach(rest, print_dlist_node);
+
+    dlist_merge(&head, rest);
+    dlist_destroy(&head);
+
+    printf("\n");
+}
+
+#define NODE_CACHE_TEST_THREADS     4
+#define NODE_CACHE_TEST_NODES       10000
+#define NODE_CACHE_TEST_ROUNDS      20
+
+/*
+ * Each producer builds lists and hands them to the next thread to free,
+ * so nodes allocated on one thread are recycled through another one.
+ */
+static slist_node_t *node_cache_handoff[NODE_CACHE_TEST_THREADS];
+
+/*
+ * pthread_barrier_t is not available everywhere (macOS lacks it), so the
+ * rounds are kept in step with a mutex and condition variable. The
+ * generation count lets a thread tell its own round's release from the
+ * next one.
+ */
+static pthread_mutex_t node_cache_barrier_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t node_cache_barrier_cv = PTHREAD_COND_INITIALIZER;
+static int node_cache_barrier_waiting = 0;
+static uint64_t node_cache_barrier_gen = 0;
+
+static void
+node_cache_barrier_wait(void)
+{
+    pthread_mutex_lock(&node_cache_barrier_lock);
+    if (++node_cache_barrier_waiting == NODE_CACHE_TEST_THREADS) {
+        node_cache_barrier_waiting = 0;
+        node_cache_barrier_gen++;
+        pthread_cond_broadcast(&node_cache_barrier_cv);
+    } else {
+        uint64_t gen = node_cache_barrier_gen;
+
+        while (gen == node_cache_barrier_gen) {
+            pthread_cond_wait(&node_cache_barrier_cv,
+                              &node_cache_barrier_lock);
+        }
+    }
+    pthread_mutex_unlock(&node_cache_barrier_lock);
+}
+
+static void *
+node_cache_test_thread(void *arg)
+{
+    uint64_t id = (uint64_t)arg;
+    uint64_t peer = (id + 1) % NODE_CACHE_TEST_THREADS;
+
+    for (int round = 0; round < NODE_CACHE_TEST_ROUNDS; round++) {
+        slist_node_t *head = NULL;
+        for (uint64_t i = 0; i < NODE_CACHE_TEST_NODES; i++) {
+            insert_slist_head(&head, i, id);
+        }
+        node_cache_handoff[id] = head;
+        node_cache_barrier_wait();
+
+        head = node_cache_handoff[peer];
+        for (uint64_t i = NODE_CACHE_TEST_NODES; i > 0; i--) {
+            assert(head->key_node.key == i - 1);
+            assert(head->key_node.val == peer);
+            head = head->next;
+        }
+        slist_destroy(&node_cache_handoff[peer]);
+        node_cache_barrier_wait();
+    }
+
+    return NULL;
+}
+
+static void
+test_linked_list_threads()
+{
+    pthread_t threads[NODE_CACHE_TEST_THREADS];
+
+    printf("\n\tTesting Linked List Node Cache Across Threads...");
+
+    for (uint64_t i = 0; i < NODE_CACHE_TEST_THREADS; i++) {
+        pthread_create(&threads[i], NULL, node_cache_test_thread, (void *)i);
+    }
+    for (int i = 0; i < NODE_CACHE_TEST_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    printf("\n\t\t%d threads recycled %d nodes each over %d rounds.",
+           NODE_CACHE_TEST_THREADS, NODE_CACHE_TEST_NODES,
+           NODE_CACHE_TEST_ROUNDS);
+    printf("\n");
+}
+
 static void
 test_linked_list()
 {
     test_singly_linked_list();
     test_doubly_linked_list();
+    test_singly_linked_list_bulk();
+    test_doubly_linked_list_bulk();
+    test_linked_list_threads();
 }
 
 static void
@@ -617,7 +2978,7 @@ test_graph_adjm_to_adjlist()
     const int rows = 5;
     const int cols = 5;
     bool isdirected = false;
-    int stackadjm[rows][cols] = {
+    int stackadjm[][5] = {
                         {0, 0, 1, 0 ,0},
                         {0, 0, 0, 1, 1},
                         {1, 0, 0, 1, 0},
@@ -875,7 +3236,7 @@ test_graph_cycle_undirected_no()
     const int cols = 5;
     bool cycle = false;
     bool isdirected = false;
-    int stackadjm[rows][cols] = {
+    int stackadjm[][5] = {
                         {0, 0, 1, 0 ,0},
                         {0, 0, 0, 1, 1},
                         {1, 0, 0, 1, 0},
@@ -927,7 +3288,7 @@ test_graph_cycle_undirected_yes()
     const int cols = 5;
     bool cycle = false;
     bool isdirected = false;
-    int stackadjm[rows][cols] = {
+    int stackadjm[][5] = {
                         {0, 0, 1, 0 ,0},
                         {0, 0, 0, 1, 1},
                         {1, 0, 0, 1, 0},
@@ -980,7 +3341,7 @@ test_graph_cycle_directed_no()
     const int cols = 5;
     bool cycle = false;
     bool isdirected = true;
-    int stackadjm[rows][cols] = {
+    int stackadjm[][5] = {
                         {0, 0, 1, 0 ,0},
                         {0, 0, 0, 1, 0},
                         {0, 0, 0, 0, 0},
@@ -1032,7 +3393,7 @@ test_graph_cycle_directed_yes()
     const int cols = 5;
     bool cycle = false;
     bool isdirected = true;
-    int stackadjm[rows][cols] = {
+    int stackadjm[][5] = {
                         {0, 0, 1, 0 ,0},
                         {0, 0, 0, 1, 0},
                         {0, 0, 0, 0, 0},
@@ -1259,6 +3620,131 @@ done:
     printf("\n");
 }
 
+static uint64_t graph_dense_visits = 0;
+
+static void
+graph_dense_visit(graph_vertex_t *v)
+{
+    graph_dense_visits++;
+}
+
+/*
+ * A complete graph makes DFS push far more entries than there are
+ * vertices, since every edge to a vertex not yet visited is pushed.
+ */
+static void
+test_graph_dfs_dense()
+{
+    const uint64_t NUM_VERTICES = 200;
+    graph_t *g = NULL;
+    bool cycle = false;
+    int error = 0;
+
+    printf("\n\tTesting DFS on a Dense Graph...");
+
+    g = create_graph(NUM_VERTICES, true);
+    if (g == NULL) {
+        printf("\n\t\tFailed to create graph!");
+        goto done;
+    }
+
+    for (uint64_t i = 0; i < NUM_VERTICES; i++) {
+        error = add_vertex(g, i);
+        assert(error == 0);
+    }
+    for (uint64_t i = 0; i < NUM_VERTICES; i++) {
+        for (uint64_t j = 0; j < NUM_VERTICES; j++) {
+            if (i != j) {
+                error = add_edge(g, i, j, 0);
+                assert(error == 0);
+            }
+        }
+    }
+
+    graph_dense_visits = 0;
+    error = graph_dfs(g, 0, &cycle, graph_dense_visit);
+    assert(error == 0);
+    assert(graph_dense_visits == NUM_VERTICES);
+    assert(cycle);
+    printf("\n\t\tVisited all %llu vertices over %llu edges",
+           NUM_VERTICES, NUM_VERTICES * (NUM_VERTICES - 1));
+
+done:
+    if (g) {
+        delete_graph(g);
+    }
+    printf("\n");
+}
+
+/*
+ * Repeated queries through one arena: after the first, no chunk is
+ * allocated and each call leaves the arena where it found it.
+ */
+static void
+test_graph_arena()
+{
+    const uint64_t NUM_VERTICES = 6;
+    graph_t *g = NULL;
+    arena_t *arena = create_arena(0);
+    arena_mark_t mark;
+    void *held = NULL;
+    uint64_t chunks = 0;
+    int error = 0;
+
+    printf("\n\tTesting Graph Queries with an Arena...");
+
+    g = create_graph(NUM_VERTICES, false);
+    if (g == NULL || arena == NULL) {
+        printf("\n\t\tFailed to create graph or arena!");
+        goto done;
+    }
+
+    for (uint64_t i = 0; i < NUM_VERTICES; i++) {
+        error = add_vertex(g, i);
+        assert(error == 0);
+    }
+    for (uint64_t i = 0; i + 1 < NUM_VERTICES; i++) {
+        error = add_edge(g, i, i + 1, 1);
+        assert(error == 0);
+    }
+    error = add_edge(g, 0, 5, 10);
+    assert(error == 0);
+
+    /* Hold something so the queries release to a non empty mark. */
+    held = arena_alloc(arena, 64);
+    assert(held != NULL);
+    mark = arena_mark(arena);
+
+    for (int round = 0; round < 3; round++) {
+        error = shortest_path_dijkstra_arena(g, 0, 5, arena);
+        assert(error == 0);
+        error = shortest_path_bellmanford_arena(g, 0, 5, arena);
+        assert(error == 0);
+        error = shortest_path_undirected_arena(g, 0, 5, arena);
+        assert(error == 0);
+        error = graph_dfs_arena(g, 0, NULL, NULL, arena);
+        assert(error == 0);
+        error = graph_bfs_arena(g, 0, NULL, arena);
+        assert(error == 0);
+        if (round == 0) {
+            chunks = arena->ar_num_chunks;
+        }
+        assert(arena->ar_num_chunks == chunks);
+        assert(arena->ar_chunk == mark.am_chunk &&
+               arena->ar_ptr == mark.am_ptr);
+    }
+    printf("\n\t\tThree rounds of queries used %llu arena chunk(s)", chunks);
+
+done:
+    if (g) {
+        delete_graph(g);
+    }
+    if (arena) {
+        destroy_arena(arena);
+    }
+    printf("\n");
+}
+
 void
 test_graph()
 {
@@ -1268,12 +3754,107 @@ test_graph()
     test_graph_cycle();
     test_graph_shortest_path();
     test_graph_shortest_path_neg();
+    test_graph_dfs_dense();
+    test_graph_arena();
+}
+
+#define TW_TEST_TIMERS  5000
+
+static timing_wheel_t *tw_test_wheel;
+static tw_timer_t *tw_test_rearm;
+
+static void
+tw_test_expired(tw_timer_t *t)
+{
+    /* The wheel has already stepped past the tick being expired. */
+    uint64_t tick = tw_test_wheel->tw_now - 1;
+
+    /* Every timer fires exactly on its tick, past ones on the first. */
+    assert(t->expires == tick || (t->expires < 100 && tick == 100));
+    assert(t->payload != (void *)1);
+
+    if (t == tw_test_rearm) {
+        timing_wheel_schedule(tw_test_wheel, t, tick + 70000);
+    }
+}
+
+static void
+test_timing_wheel()
+{
+    timing_wheel_t *tw = NULL;
+    tw_timer_t *timers = NULL;
+    uint64_t cancelled = 0;
+    uint64_t fired = 0;
+    uint64_t max_expiry = 0;
+    int error = 0;
+
+    printf("\n\tTesting Timing Wheel...");
+
+    tw = create_timing_wheel(100);
+    timers = (tw_timer_t *)malloc(TW_TEST_TIMERS * sizeof(tw_timer_t));
+    if (tw == NULL || timers == NULL) {
+        printf("\n\t\tFailed to allocate timing wheel");
+        goto done;
+    }
+    tw_test_wheel = tw;
+
+    /* Spread expiries over every level, including past ones. */
+    for (int i = 0; i < TW_TEST_TIMERS; i++) {
+        uint64_t expires = 0;
+        switch (i % 4) {
+            case 0: expires = 100 + rand() % 256; break;
+            case 1: expires = 100 + rand() % 65536; break;
+            case 2: expires = 100 + ((uint64_t)rand() % (1ULL << 22)); break;
+            default: expires = rand() % 100; break;
+        }
+        if (expires > max_expiry) {
+            max_expiry = expires;
+        }
+        tw_timer_init(&timers[i], NULL);
+        timing_wheel_schedule(tw, &timers[i], expires);
+    }
+    assert(tw->tw_count == TW_TEST_TIMERS);
+
+    /* Cancel every 7th timer; it must never fire. */
+    for (int i = 0; i < TW_TEST_TIMERS; i += 7) {
+        error = timing_wheel_cancel(tw, &timers[i]);
+        assert(error == 0);
+        timers[i].payload = (void *)1;
+        cancelled++;
+    }
+    error = timing_wheel_cancel(tw, &timers[0]);
+    assert(error == ENOENT);
+
+    printf("\n\t\tScheduled %d timers up to tick %llu, cancelled %llu",
+           TW_TEST_TIMERS, max_expiry, cancelled);
+
+    for (uint64_t now = 100; now <= max_expiry; now += rand() % 1000) {
+        fired += timing_wheel_advance(tw, now, tw_test_expired);
+    }
+    fired += timing_wheel_advance(tw, max_expiry, tw_test_expired);
+    assert(fired == TW_TEST_TIMERS - cancelled);
+    assert(tw->tw_count == 0);
+    printf("\n\t\tFired %llu timers by tick %llu", fired, max_expiry);
+
+    /* A timer re-armed from its own callback keeps firing. */
+    tw_test_rearm = &timers[1];
+    timing_wheel_schedule(tw, tw_test_rearm, tw->tw_now);
+    fired = timing_wheel_advance(tw, tw->tw_now + 70000 * 3, tw_test_expired);
+    assert(fired == 4 && tw_timer_pending(tw_test_rearm));
+    printf("\n\t\tRe-armed timer fired %llu times", fired);
+
+done:
+    if (tw) {
+        destroy_timing_wheel(tw);
+    }
+    free(timers);
+    printf("\n");
 }
 
 static void
 print_usage()
 {
-    printf("\ndsa_driver -[LMQSBHG]");
+    printf("\ndsa_driver -[LMQSBHGT]");
     printf("\n\t\t L - Test Linked Lists");
     printf("\n\t\t M - Test Hash Map");
     printf("\n\t\t Q - Test Queue");
@@ -1281,6 +3862,7 @@ print_usage()
     printf("\n\t\t B - Test Binary Trees and BST");
     printf("\n\t\t H - Test Heap");
     printf("\n\t\t G - Test Graphs");
+    printf("\n\t\t T - Test Timing Wheel");
     printf("\n");
 }
 
@@ -1295,10 +3877,11 @@ int main(int argc, char *argv[])
     bool test_binary_trees_f = false;
     bool test_heap_f = false;
     bool test_graph_f = false;
+    bool test_timing_wheel_f = false;
 
     printf("Welcome to DSA Driver Program!");
 
-    while ((opt = getopt(argc, argv, "hLMQSBHG")) != -1) {
+    while ((opt = getopt(argc, argv, "hLMQSBHGT")) != -1) {
         switch (opt) {
             case 'L':
                 test_ll_f = true;
@@ -1321,6 +3904,9 @@ int main(int argc, char *argv[])
             case 'G':
                 test_graph_f = true;
                 break;
+            case 'T':
+                test_timing_wheel_f = true;
+                break;
             case 'h':
                 print_usage();
                 break;
@@ -1341,10 +3927,18 @@ int main(int argc, char *argv[])
 
     if (test_queue_f) {
         test_simple_q();
+        test_spsc_ring();
+        test_mpmc_queue();
+        test_ws_deque();
+        test_blocking_q();
+        test_shm_q();
     }
 
     if (test_stack_f) {
         test_stack();
+        test_stack_segmented();
+        test_treiber_stack();
+        test_arena();
     }
 
     if (test_binary_trees_f) {
@@ -1354,12 +3948,22 @@ int main(int argc, char *argv[])
     if (test_heap_f) {
         test_min_heap();
         test_max_heap();
+        test_heap_bulk();
+        test_indexed_heap();
+        test_pairing_heap();
+        test_radix_heap();
+        test_minmax_heap();
+        test_multiqueue();
     }
 
     if (test_graph_f) {
         test_graph();
     }
 
+    if (test_timing_wheel_f) {
+        test_timing_wheel();
+    }
+
 done:
     return 0;
 }
@@ -2,22 +2,77 @@
  * Copyright (c) 2024 Vedant Mathur
  *
  * Stack Data Structure Operations
+ *
+ * A segmented stack. The first DSA_STACK_INLINE_SIZE elements live in
+ * the stack structure itself, so shallow use never allocates; beyond
+ * that, fixed size chunks are chained on demand. Elements never move
+ * once pushed, and growing costs one allocation per chunk rather than a
+ * copy of everything below.
+ *
+ * When pops empty a chunk it is kept as a spare instead of being freed,
+ * so a stack that hovers around a chunk boundary does not allocate and
+ * free on every push and pop. Only one spare is kept; chunks further up
+ * are freed as the stack shrinks past them.
  */
 
+#pragma once
+
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
 
+#define DSA_STACK_INLINE_SIZE   32
+#define DSA_STACK_CHUNK_SIZE    1024
+
+/*
+ * Stack creation flags.
+ *
+ *      DSA_STACK_F_GROW - No bound on the number of elements; capacity
+ *                         is ignored.
+ */
+#define DSA_STACK_F_GROW        0x1
+
+typedef struct dsa_stack_chunk_ {
+    struct dsa_stack_chunk_ *prev;
+    uint64_t elements[DSA_STACK_CHUNK_SIZE];
+} dsa_stack_chunk_t;
+
+/*
+ *      capacity - Bound on curr_size for stacks that do not grow.
+ *      next - Slot the next push writes, within [base, limit].
+ *      base, limit - Bounds of the current segment: the inline array
+ *                    or the current chunk.
+ *      chunk - Current chunk, NULL while in the inline array.
+ *      spare - Emptied chunk kept for the next push past limit.
+ */
 typedef struct dsa_stack_ {
     uint64_t capacity;
     uint64_t curr_size;
-    uint64_t *top;
-    uint64_t *elements;
+    uint64_t *next;
+    uint64_t *base;
+    uint64_t *limit;
+    dsa_stack_chunk_t *chunk;
+    dsa_stack_chunk_t *spare;
+    uint32_t flags;
+    uint64_t inline_elements[DSA_STACK_INLINE_SIZE];
 } dsa_stack_t;
 
 dsa_stack_t *create_dsa_stack(uint64_t capacity);
+dsa_stack_t *create_dsa_stack_flags(uint64_t capacity, uint32_t flags);
 int destroy_dsa_stack(dsa_stack_t *s);
 
+/*
+ * Set up or tear down a stack in caller provided memory, typically a
+ * local variable, so that a shallow stack needs no allocation at all.
+ */
+void dsa_stack_init(dsa_stack_t *s, uint64_t capacity, uint32_t flags);
+void dsa_stack_fini(dsa_stack_t *s);
+
+/*
+ * push returns EFAULT when a bounded stack is full and ENOMEM when a
+ * new chunk cannot be allocated; pop and top return EFAULT when the
+ * stack is empty.
+ */
 int dsa_stack_push(dsa_stack_t *s, uint64_t key);
 int dsa_stack_pop(dsa_stack_t *s, uint64_t *key);
 int dsa_stack_top(dsa_stack_t *s, uint64_t *key);
@@ -7,6 +7,8 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <heap.h>
+#include <arena.h>
 
 int linear_search_arr(uint64_t *arr, int arr_len,  uint64_t target);
 int binary_search_arr(uint64_t *arr, int arr_len, uint64_t target);
@@ -17,4 +19,39 @@ void insertion_sort(int64_t *arr, int len);
 void quick_sort(int64_t *arr, int len);
 void merge_sort(int64_t *arr, int len);
 
+/*
+ * merge_sort with its scratch buffer (half the input) taken from
+ * 'arena' and released before returning, or from malloc when 'arena'
+ * is NULL. Returns ENOMEM if the buffer cannot be allocated.
+ */
+int merge_sort_arena(int64_t *arr, int len, arena_t *arena);
+
+/*
+ * Heap based selection, O(n log k) with a bounded heap_t of k entries.
+ * Once the heap is full, input is scanned in blocks against the current
+ * k-th best value and blocks with nothing better are skipped without
+ * touching the heap, so small k runs close to a plain pass over memory.
+ *
+ * top_k writes the 'k' largest values of 'arr' to 'out' in descending
+ * order. partial_sort reorders 'arr' so that its first 'k' slots hold
+ * the k smallest values in ascending order; the order of the rest is
+ * unspecified. Both return EINVAL unless 0 < k <= len.
+ */
+int top_k(int64_t *arr, int len, int k, int64_t *out);
+int partial_sort(int64_t *arr, int len, int k);
+
+/*
+ * Streaming top-K: keeps the 'k' largest values pushed so far.
+ * topk_stream_result copies them to 'out' in descending order without
+ * consuming them and reports how many through 'count', which is less
+ * than k until k values have been pushed.
+ */
+typedef struct topk_stream_ {
+    heap_t *ts_heap;
+    uint64_t ts_k;
+} topk_stream_t;
 
+topk_stream_t *create_topk_stream(int k);
+int destroy_topk_stream(topk_stream_t *s);
+int topk_stream_push(topk_stream_t *s, int64_t *arr, int len);
+int topk_stream_result(topk_stream_t *s, int64_t *out, int *count);
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Arena Allocator
+ *
+ * A stack style scratch allocator. Allocation bumps a pointer through
+ * the current chunk and takes a new chunk only when that one is used
+ * up. There is no per allocation free: arena_mark records the current
+ * position and arena_release frees everything allocated since, in one
+ * step. Marks nest like stack frames, so a routine can take a mark on
+ * entry and release it on exit without knowing what its caller holds.
+ *
+ * Released chunks are kept on a free list rather than returned to
+ * malloc, so once an arena has grown to the size a workload needs,
+ * repeating that workload allocates nothing.
+ *
+ * An arena is not thread safe. arena_thread returns one per thread,
+ * created on first use and freed when the thread exits.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Alignment of every allocation. */
+#define ARENA_ALIGN             16
+
+/* Chunk size used by arena_thread and when 0 is passed to create. */
+#define ARENA_DEFAULT_CHUNK     (64 * 1024)
+
+typedef struct arena_chunk_ {
+    struct arena_chunk_ *prev;
+    size_t size;
+    uint8_t data[] __attribute__((aligned(ARENA_ALIGN)));
+} arena_chunk_t;
+
+/*
+ *      ar_chunk - Chunk being bumped through, NULL before the first
+ *                 allocation.
+ *      ar_ptr, ar_end - Free space left in ar_chunk.
+ *      ar_free - Released chunks, reused before calling malloc.
+ *      ar_num_chunks - Chunks obtained from malloc so far.
+ */
+typedef struct arena_ {
+    arena_chunk_t *ar_chunk;
+    uint8_t *ar_ptr;
+    uint8_t *ar_end;
+    arena_chunk_t *ar_free;
+    size_t ar_chunk_size;
+    uint64_t ar_num_chunks;
+} arena_t;
+
+typedef struct arena_mark_ {
+    arena_chunk_t *am_chunk;
+    uint8_t *am_ptr;
+} arena_mark_t;
+
+/*
+ * 'chunk_size' is the usual chunk size; a larger request gets a chunk
+ * of its own size.
+ */
+arena_t *create_arena(size_t chunk_size);
+int destroy_arena(arena_t *a);
+
+/*
+ * Returns NULL when a needed chunk cannot be allocated, including for
+ * sizes so close to SIZE_MAX that no chunk could hold them. arena_calloc
+ * zeroes the memory and also fails if 'count * size' overflows.
+ */
+void *arena_alloc(arena_t *a, size_t size);
+void *arena_calloc(arena_t *a, size_t count, size_t size);
+
+/*
+ * arena_release frees everything allocated after 'mark' was taken and
+ * invalidates any marks taken after it. Returns EINVAL for a mark that
+ * is not live in this arena. arena_reset releases everything.
+ */
+arena_mark_t arena_mark(arena_t *a);
+int arena_release(arena_t *a, arena_mark_t mark);
+void arena_reset(arena_t *a);
+
+/*
+ * This thread's arena, or NULL if it could not be created.
+ */
+arena_t *arena_thread(void);
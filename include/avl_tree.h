@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * AVL Tree
+ *
+ * A height balanced binary search tree of unique keys. The heights of
+ * any node's two subtrees differ by at most one, which keeps the tree
+ * no deeper than about 1.44 log2(n) whatever order keys arrive in.
+ *
+ * Insert, delete and find are iterative. Insert and delete record the
+ * links they walk through on a fixed size path array and then rebalance
+ * bottom up along it, stopping at the first node whose height did not
+ * change. AVL_MAX_HEIGHT bounds the path; an AVL tree that deep would
+ * need more nodes than fit in memory.
+ *
+ * Nodes come from the per-thread node cache, like bt_node.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define AVL_MAX_HEIGHT      96
+
+/*
+ *      height - Levels in the subtree rooted here; a leaf has height 1.
+ */
+typedef struct avl_node_ {
+    uint64_t key;
+    struct avl_node_ *left;
+    struct avl_node_ *right;
+    int32_t height;
+} avl_node_t;
+
+typedef struct avl_tree_ {
+    avl_node_t *at_root;
+    uint64_t at_count;
+} avl_tree_t;
+
+avl_tree_t *create_avl_tree(void);
+int destroy_avl_tree(avl_tree_t *t);
+
+/*
+ * insert returns EEXIST if 'key' is already present and ENOMEM if a node
+ * cannot be allocated; delete returns ENOENT if 'key' is absent.
+ */
+int avl_tree_insert(avl_tree_t *t, uint64_t key);
+int avl_tree_delete(avl_tree_t *t, uint64_t key);
+
+/*
+ * Node holding 'key', or NULL. The node stays valid until the next
+ * insert or delete.
+ */
+avl_node_t *avl_tree_find(avl_tree_t *t, uint64_t key);
+
+uint64_t avl_tree_size(avl_tree_t *t);
+int32_t avl_tree_height(avl_tree_t *t);
@@ -2,9 +2,19 @@
  * Copyright (c) 2024 Vedant Mathur
  *
  * Binary Tree Data Structure Operations
+ *
+ * All traversals are iterative. Depth first orders keep their path on
+ * a segmented dsa_stack_t and level order uses a growable simple_q, so
+ * neither a deep nor a wide tree can overflow anything. Children are
+ * prefetched as they are put on the stack or queue, ahead of the visit.
  */
 
+#pragma once
+
 #include <stdint.h>
+#include <stdbool.h>
+#include <Stack.h>
+#include <queue.h>
 
 typedef struct bt_node_ {
     uint64_t key;
@@ -14,12 +24,62 @@ typedef struct bt_node_ {
 
 typedef void (*bt_traversalcb)(bt_node *node);
 
+/*
+ * Visit callback for bt_traverse; return false to stop the walk.
+ */
+typedef bool (*bt_visitcb)(bt_node *node, void *arg);
+
+typedef enum bt_order_ {
+    BT_ORDER_IN = 0,
+    BT_ORDER_PRE,
+    BT_ORDER_POST,
+    BT_ORDER_LEVEL,
+} bt_order_e;
+
+/*
+ * Iterator over a tree in one of the four orders.
+ *
+ *      cur - In and post order: subtree whose left spine is still to be
+ *            pushed.
+ *      last - Post order: node returned last, to tell whether the node
+ *             on top of the stack is reached from its left or right.
+ *      stack - Path for the depth first orders. Its first elements are
+ *              stored inline, so the iterator must not be copied or
+ *              moved between begin and end.
+ *      queue - Pending nodes for level order.
+ *      error - ENOMEM once growing the stack or queue has failed.
+ */
+typedef struct bt_iter_ {
+    bt_order_e order;
+    bt_node *cur;
+    bt_node *last;
+    dsa_stack_t stack;
+    simple_q *queue;
+    int error;
+} bt_iter_t;
+
 void in_order_traversal(bt_node *root, bt_traversalcb cb);
 void pre_order_traversal(bt_node *root, bt_traversalcb cb);
 void post_order_traversal(bt_node *root, bt_traversalcb cb);
 void level_order_traversal(bt_node *root, bt_traversalcb cb);
 void level_order_traversal_with_height(bt_node *root, bt_traversalcb cb);
 
+/*
+ * bt_iter_next returns nodes in order and NULL at the end, or when it
+ * runs out of memory, which leaves ENOMEM in 'error'. The tree must not
+ * change while it is walked. bt_iter_end may be called at any point,
+ * so a caller can stop early.
+ */
+int bt_iter_begin(bt_iter_t *it, bt_node *root, bt_order_e order);
+bt_node *bt_iter_next(bt_iter_t *it);
+void bt_iter_end(bt_iter_t *it);
+
+/*
+ * Visit 'root' in 'order' until 'cb' returns false. Returns ENOMEM if
+ * the walk could not finish.
+ */
+int bt_traverse(bt_node *root, bt_order_e order, bt_visitcb cb, void *arg);
+
 
 int insert_to_bt(bt_node **root, uint64_t key);
 int delete_from_bt(bt_node **root, uint64_t key);
@@ -27,5 +87,29 @@ int delete_from_bt(bt_node **root, uint64_t key);
 bt_node* insert_to_bst(bt_node **root, uint64_t key);
 bt_node* delete_from_bst(bt_node **root, uint64_t key);
 
+/*
+ * Build a perfectly balanced BST over 'n' sorted keys in O(n). Nodes
+ * come from the node cache like any other, so insert_to_bst and
+ * delete_from_bst work on the result. They are allocated in level
+ * order, which on a fresh cache tends to put the top levels close
+ * together in memory. Returns NULL if 'n' is 0, the keys are out of
+ * order, or allocation fails.
+ */
+bt_node *bst_build_from_sorted(const uint64_t *keys, uint64_t n);
+
+/*
+ * Free every node of the tree without recursion or extra memory and set
+ * '*root' to NULL.
+ */
+int destroy_bt(bt_node **root);
+
+/*
+ * Flatten the tree and relink its nodes into a perfectly balanced shape
+ * in O(n) time and space. Keys move between nodes; the root stays the
+ * same node. Returns ENOMEM if the temporary arrays cannot be allocated,
+ * in which case the tree is unchanged.
+ */
+int bst_rebalance(bt_node **root);
+
 
 
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Blocking Producer/Consumer Queue
+ *
+ * A simple_q ring behind a mutex, with threads that find it empty (or
+ * full) spinning briefly and then sleeping on a futex until the other
+ * side makes progress. Sleepers announce themselves in a waiter count,
+ * and the other side only makes the wake syscall when that count is non
+ * zero, so a busy queue with nobody asleep never enters the kernel
+ * beyond what the mutex itself needs.
+ *
+ * Closing the queue wakes everyone. Producers then get EPIPE, and
+ * consumers keep draining what is left before they get EPIPE too.
+ *
+ * Platforms without futexes fall back to a condition variable per
+ * queue with the same wait/wake protocol.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <queue.h>
+
+/* Checks of the item count before a waiter goes to sleep. */
+#define BLOCKING_Q_SPIN_COUNT   128
+
+/*
+ *      bq_count - Mirror of the ring's size, readable without the lock.
+ *      bq_items_seq - Futex word consumers sleep on; bumped by a producer
+ *                     that saw sleeping consumers.
+ *      bq_space_seq - Futex word producers sleep on when the ring is
+ *                     full; bumped by a consumer that saw them.
+ */
+typedef struct blocking_q_ {
+    pthread_mutex_t bq_lock;
+    simple_q *bq_q;
+    _Atomic uint64_t bq_count;
+    _Atomic uint32_t bq_items_seq;
+    _Atomic uint32_t bq_space_seq;
+    _Atomic uint32_t bq_consumers_waiting;
+    _Atomic uint32_t bq_producers_waiting;
+    _Atomic bool bq_closed;
+#ifndef __linux__
+    pthread_mutex_t bq_wait_lock;
+    pthread_cond_t bq_wait_cond;
+#endif
+} blocking_q;
+
+/*
+ * 'size' and 'flags' are passed to create_simple_q_flags. With
+ * SIMPLE_Q_F_GROW the queue never fills and producers never block.
+ */
+blocking_q *create_blocking_q(uint64_t size, uint32_t flags);
+int destroy_blocking_q(blocking_q *q);
+
+/*
+ * Blocks while the queue is full. Returns EPIPE once the queue is
+ * closed. The batch variant takes the lock once per run of keys that
+ * fit and wakes up to that many sleeping consumers with one syscall.
+ */
+int blocking_q_enqueue(blocking_q *q, uint64_t key);
+int blocking_q_enqueue_batch(blocking_q *q, const uint64_t *keys,
+                             uint64_t n);
+
+/*
+ * Waits up to 'timeout_ns' for a key; a negative timeout waits forever
+ * and zero does not wait. Returns ETIMEDOUT when the wait runs out and
+ * EPIPE once the queue is closed and empty. The batch variant returns
+ * as soon as at least one key is available, with up to 'max' of them.
+ */
+int blocking_q_dequeue(blocking_q *q, uint64_t *out, int64_t timeout_ns);
+int blocking_q_dequeue_batch(blocking_q *q, uint64_t *out, uint64_t max,
+                             uint64_t *got, int64_t timeout_ns);
+
+/*
+ * Refuse further enqueues and wake every waiter.
+ */
+int blocking_q_close(blocking_q *q);
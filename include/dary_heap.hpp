@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Cache Friendly D-ary Heap
+ *
+ * Arity and ordering are template parameters, so the comparator is
+ * inlined and there is no per-compare branch on the heap type. The array
+ * is cache line aligned and shifted by D - 1 slots, which makes every
+ * group of D siblings start on a D * sizeof(T) boundary. With 8 byte keys
+ * an 8-ary heap touches exactly one cache line per level on the way down.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+
+#define DARY_HEAP_CACHE_LINE 64
+
+template <typename T, unsigned D = 4, typename Compare = std::less<T>>
+class dary_heap {
+    static_assert(D == 2 || D == 4 || D == 8, "arity must be 2, 4 or 8");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "elements are moved with memcpy");
+
+public:
+    dary_heap() = default;
+
+    explicit dary_heap(uint64_t capacity)
+    {
+        reserve(capacity);
+    }
+
+    ~dary_heap()
+    {
+        free(raw_);
+    }
+
+    dary_heap(const dary_heap &) = delete;
+    dary_heap &operator=(const dary_heap &) = delete;
+
+    bool empty() const { return size_ == 0; }
+    uint64_t size() const { return size_; }
+    uint64_t capacity() const { return capacity_; }
+
+    const T &top() const { return arr_[0]; }
+
+    void reserve(uint64_t capacity)
+    {
+        if (capacity <= capacity_) {
+            return;
+        }
+
+        void *raw = NULL;
+        size_t bytes = (capacity + D - 1) * sizeof(T);
+        if (posix_memalign(&raw, DARY_HEAP_CACHE_LINE, bytes) != 0) {
+            throw std::bad_alloc();
+        }
+
+        T *arr = reinterpret_cast<T *>(raw) + (D - 1);
+        if (size_) {
+            memcpy(arr, arr_, size_ * sizeof(T));
+        }
+
+        free(raw_);
+        raw_ = raw;
+        arr_ = arr;
+        capacity_ = capacity;
+    }
+
+    void push(const T &elem)
+    {
+        if (size_ == capacity_) {
+            reserve(capacity_ ? capacity_ * 2 : 64);
+        }
+
+        uint64_t index = size_++;
+        while (index > 0) {
+            uint64_t parent = (index - 1) / D;
+            if (!cmp_(elem, arr_[parent])) {
+                break;
+            }
+            arr_[index] = arr_[parent];
+            index = parent;
+        }
+        arr_[index] = elem;
+    }
+
+    void pop()
+    {
+        if (size_ == 0) {
+            return;
+        }
+
+        --size_;
+        if (size_ > 0) {
+            sift_down(0, arr_[size_]);
+        }
+    }
+
+    bool pop(T *out)
+    {
+        if (size_ == 0) {
+            return false;
+        }
+
+        *out = arr_[0];
+        pop();
+        return true;
+    }
+
+    void clear() { size_ = 0; }
+
+private:
+    /*
+     * Index of the best child among a full group of D siblings. The
+     * select compiles to conditional moves, so there is no data dependent
+     * branch inside the group.
+     */
+    uint64_t best_of_group(uint64_t first) const
+    {
+        uint64_t best = first;
+        for (unsigned i = 1; i < D; i++) {
+            bool better = cmp_(arr_[first + i], arr_[best]);
+            best = better ? first + i : best;
+        }
+        return best;
+    }
+
+    uint64_t best_of_partial(uint64_t first, uint64_t last) const
+    {
+        uint64_t best = first;
+        for (uint64_t c = first + 1; c < last; c++) {
+            bool better = cmp_(arr_[c], arr_[best]);
+            best = better ? c : best;
+        }
+        return best;
+    }
+
+    void sift_down(uint64_t index, T elem)
+    {
+        const uint64_t size = size_;
+
+        /* Full groups only, no bounds checks inside the group. */
+        while (D * index + D < size) {
+            uint64_t best = best_of_group(D * index + 1);
+            if (!cmp_(arr_[best], elem)) {
+                arr_[index] = elem;
+                return;
+            }
+            arr_[index] = arr_[best];
+            index = best;
+        }
+
+        /* At most one partial group at the bottom of the heap. */
+        uint64_t first = D * index + 1;
+        if (first < size) {
+            uint64_t best = best_of_partial(first, size);
+            if (cmp_(arr_[best], elem)) {
+                arr_[index] = arr_[best];
+                index = best;
+            }
+        }
+        arr_[index] = elem;
+    }
+
+    void *raw_ = NULL;
+    T *arr_ = NULL;
+    uint64_t size_ = 0;
+    uint64_t capacity_ = 0;
+    Compare cmp_;
+};
+
+template <typename T, unsigned D = 4>
+using dary_min_heap = dary_heap<T, D, std::less<T>>;
+
+template <typename T, unsigned D = 4>
+using dary_max_heap = dary_heap<T, D, std::greater<T>>;
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <arena.h>
 
 struct graph_vertex_s;
 struct graph_edge_s;
@@ -80,6 +81,18 @@ int graph_dfs(graph_t *g, uint64_t start_vertex, bool *has_cycle,
               graphtraversalcb cb);
 int graph_bfs(graph_t *g, uint64_t start_vertex, graphtraversalcb cb);
 
+/*
+ * The _arena variants of the traversal and shortest path routines take
+ * their per call scratch arrays from 'arena' (released before they
+ * return) instead of malloc. With an arena that has already grown to
+ * the graph's size, Dijkstra, Bellman-Ford and the unweighted shortest
+ * path allocate nothing. A NULL arena behaves like the plain calls.
+ */
+int graph_dfs_arena(graph_t *g, uint64_t start_vertex, bool *has_cycle,
+                    graphtraversalcb cb, arena_t *arena);
+int graph_bfs_arena(graph_t *g, uint64_t start_vertex, graphtraversalcb cb,
+                    arena_t *arena);
+
 /*
  * Graph utility functions.
  */
@@ -97,3 +110,9 @@ bool has_cycle(graph_t *g);
 int shortest_path_dijkstra(graph_t *g, uint64_t src, uint64_t dst);
 int shortest_path_undirected(graph_t *g, uint64_t src, uint64_t dst);
 int shortest_path_bellmanford(graph_t *g, uint64_t src, uint64_t dst);
+int shortest_path_dijkstra_arena(graph_t *g, uint64_t src, uint64_t dst,
+                                 arena_t *arena);
+int shortest_path_undirected_arena(graph_t *g, uint64_t src, uint64_t dst,
+                                   arena_t *arena);
+int shortest_path_bellmanford_arena(graph_t *g, uint64_t src, uint64_t dst,
+                                    arena_t *arena);
@@ -4,6 +4,8 @@
  * Heap Data Structure Operations
  */
 
+#pragma once
+
 #include <stdint.h>
 
 typedef enum heap_type_ {
@@ -16,14 +18,30 @@ typedef struct heap_elem_ {
 } heap_elem_t;
 
 
+/*
+ * Heap creation flags.
+ *
+ *      HEAP_F_GROW - Double h_capacity instead of failing when full.
+ *      HEAP_F_SHRINK - Halve h_capacity once heap_pop_batch leaves the
+ *                      heap a quarter full, never going below the
+ *                      initial capacity. Single deletes never shrink,
+ *                      so the pointer delete_min and delete_max return
+ *                      still points into h_arr.
+ */
+#define HEAP_F_GROW     0x1
+#define HEAP_F_SHRINK   0x2
+
 typedef struct heap_ {
     heap_type_e h_type;
     heap_elem_t *h_arr;
     uint64_t h_capacity;
     uint64_t h_curr_size;
+    uint64_t h_min_capacity;
+    uint32_t h_flags;
 } heap_t;
 
 heap_t* create_heap(heap_type_e type, uint64_t size);
+heap_t* create_heap_flags(heap_type_e type, uint64_t size, uint32_t flags);
 int destroy_heap(heap_t *h);
 
 int insert_heap(heap_t *h, heap_elem_t *elem);
@@ -35,4 +53,22 @@ heap_elem_t *get_max(heap_t *h);
 int delete_min(heap_t *h, heap_elem_t **min);
 int delete_max(heap_t *h, heap_elem_t **max);
 
+/*
+ * Overwrite the root with 'elem' and sift it down, which is a pop and a
+ * push for the price of one sift. Returns EFAULT on an empty heap.
+ */
+int heap_replace_top(heap_t *h, heap_elem_t *elem);
+
+/*
+ * Bulk operations. heap_build_from_array appends 'n' elements and then
+ * restores the heap with Floyd's bottom-up heapify, which is O(size)
+ * instead of O(n log n) for n separate inserts. heap_push_batch picks
+ * between that and individual inserts based on the batch size.
+ * heap_pop_batch removes up to 'n' roots in order into 'out' and reports
+ * how many it removed through 'popped'.
+ */
+int heap_build_from_array(heap_t *h, heap_elem_t *arr, uint64_t n);
+int heap_push_batch(heap_t *h, heap_elem_t *arr, uint64_t n);
+int heap_pop_batch(heap_t *h, heap_elem_t *out, uint64_t n, uint64_t *popped);
+
 void print_heap(heap_t *h);
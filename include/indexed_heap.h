@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Indexed Heap Data Structure Operations
+ *
+ * A binary heap of (priority, id, payload) entries that also tracks the
+ * array position of every id. Knowing where an id lives lets priority
+ * changes and arbitrary removals run in O(log n) instead of scanning the
+ * heap, which is what Dijkstra style decrease-key workloads need.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <heap.h>
+
+/* Position value for ids that are not currently in the heap. */
+#define IDX_HEAP_NPOS   UINT64_MAX
+
+typedef struct idx_heap_elem_ {
+    uint64_t priority;
+    uint64_t id;
+    void *payload;
+} idx_heap_elem_t;
+
+/*
+ * Ids are dense integers in [0, ih_max_ids) and ih_pos[id] is the index
+ * of that id in ih_arr, or IDX_HEAP_NPOS when absent.
+ */
+typedef struct idx_heap_ {
+    heap_type_e ih_type;
+    idx_heap_elem_t *ih_arr;
+    uint64_t *ih_pos;
+    uint64_t ih_max_ids;
+    uint64_t ih_curr_size;
+} idx_heap_t;
+
+idx_heap_t *create_idx_heap(heap_type_e type, uint64_t max_ids);
+int destroy_idx_heap(idx_heap_t *h);
+
+int idx_heap_insert(idx_heap_t *h, uint64_t id, uint64_t priority,
+                    void *payload);
+int idx_heap_peek(idx_heap_t *h, idx_heap_elem_t *top);
+int idx_heap_pop(idx_heap_t *h, idx_heap_elem_t *top);
+int idx_heap_remove(idx_heap_t *h, uint64_t id, idx_heap_elem_t *elem);
+
+/*
+ * decrease_key and increase_key refer to the numeric priority, so on a
+ * MIN_HEAP a decrease moves the entry towards the root and on a MAX_HEAP
+ * an increase does. Moving a priority the wrong way returns EINVAL.
+ */
+int idx_heap_decrease_key(idx_heap_t *h, uint64_t id, uint64_t priority);
+int idx_heap_increase_key(idx_heap_t *h, uint64_t id, uint64_t priority);
+
+bool idx_heap_contains(idx_heap_t *h, uint64_t id);
+bool idx_heap_is_empty(idx_heap_t *h);
+void print_idx_heap(idx_heap_t *h);
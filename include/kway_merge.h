@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * K-way Merge of Sorted Runs
+ *
+ * Merges K ascending int64_t runs with a loser tree. Each internal node
+ * remembers the run that lost the match played there, so replacing the
+ * winner replays only the path from its leaf to the root: one compare
+ * per level and no swaps of whole entries as in a binary heap. Runs are
+ * read in batches through a callback, and merged output is handed out
+ * in caller sized blocks, so neither side needs to fit in memory.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Values pulled from a run per read callback when no batch is given. */
+#define KWAY_MERGE_DEFAULT_BATCH    256
+
+/*
+ * Fill 'buf' with up to 'max' further values of the run, in ascending
+ * order and continuing from the previous call, and store how many were
+ * written in 'count'. A count of zero marks the end of the run. A non
+ * zero return aborts the merge and is passed back to the caller.
+ */
+typedef int (*kway_read_fn)(void *ctx, int64_t *buf, int max, int *count);
+
+typedef struct kway_run_ {
+    kway_read_fn read;
+    void *ctx;
+} kway_run_t;
+
+/*
+ * Ready made reader over an in memory sorted array. Use kway_array_read
+ * as the callback and a kway_array_run_t as its context.
+ */
+typedef struct kway_array_run_ {
+    int64_t *arr;
+    int len;
+    int pos;
+} kway_array_run_t;
+
+int kway_array_read(void *ctx, int64_t *buf, int max, int *count);
+
+/*
+ * Per run read state.
+ */
+typedef struct kway_source_ {
+    kway_run_t run;
+    int64_t *buf;
+    int pos;
+    int len;
+} kway_source_t;
+
+/*
+ * Merge state.
+ *
+ *      km_tree - Loser tree over km_leaves leaves. km_tree[0] holds the
+ *                overall winner, km_tree[1..km_leaves - 1] the loser of
+ *                the match at each internal node.
+ *      km_keys - Head value of each run, copied out of the run buffers
+ *                so matches compare within one small array. Exhausted
+ *                runs hold INT64_MAX and lose ties.
+ *      km_exhausted - Runs with nothing left to read. Runs past the
+ *                     caller's K, which pad the tree to a power of two,
+ *                     start out exhausted.
+ *      km_error - First error returned by a read callback.
+ */
+typedef struct kway_merge_ {
+    kway_source_t *km_sources;
+    int64_t *km_keys;
+    bool *km_exhausted;
+    int *km_tree;
+    int km_leaves;
+    int km_batch;
+    int km_error;
+} kway_merge_t;
+
+/*
+ * Set up a merge over 'k' runs, reading 'batch' values at a time from
+ * each (KWAY_MERGE_DEFAULT_BATCH if 'batch' is zero). The first batch of
+ * every run is read here, so this returns NULL if a read fails.
+ */
+kway_merge_t *create_kway_merge(kway_run_t *runs, int k, int batch);
+int destroy_kway_merge(kway_merge_t *m);
+
+/*
+ * Write up to 'max' of the next merged values to 'out' and store how
+ * many were written in 'count'. A count of zero with a zero return
+ * means every run is exhausted.
+ */
+int kway_merge_next_block(kway_merge_t *m, int64_t *out, int max,
+                          int *count);
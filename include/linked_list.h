@@ -31,9 +31,27 @@ int insert_slist_head(slist_node_t **head, uint64_t key, uint64_t val);
 int insert_slist_tail(slist_node_t **head, uint64_t key, uint64_t val);
 int slist_remove(slist_node_t **head, uint64_t key);
 int slist_foreach(slist_node_t *head, sll_traversalcb cb);
+int slist_destroy(slist_node_t **head);
 
 int insert_dlist_head(dlist_node_t **head, uint64_t key);
 int insert_dlist_tail(dlist_node_t **head, uint64_t key);
 int dlist_remove(dlist_node_t **head, uint64_t key);
 int dlist_foreach(dlist_node_t *head, dll_traversalcb cb);
+int dlist_destroy(dlist_node_t **head);
+
+/*
+ * In-place bulk operations. These only relink existing nodes and never
+ * allocate. Merge and dedupe expect lists already sorted by key.
+ */
+int slist_sort(slist_node_t **head);
+int slist_merge(slist_node_t **head, slist_node_t *other);
+int slist_dedupe(slist_node_t **head);
+int slist_reverse(slist_node_t **head);
+int slist_split_at(slist_node_t **head, uint64_t index, slist_node_t **rest);
+
+int dlist_sort(dlist_node_t **head);
+int dlist_merge(dlist_node_t **head, dlist_node_t *other);
+int dlist_dedupe(dlist_node_t **head);
+int dlist_reverse(dlist_node_t **head);
+int dlist_split_at(dlist_node_t **head, uint64_t index, dlist_node_t **rest);
 
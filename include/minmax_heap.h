@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Min-Max Heap Data Structure Operations
+ *
+ * A double ended priority queue in a single array. Levels alternate
+ * between min levels (even depth, starting at the root) and max levels
+ * (odd depth), so the minimum is the root and the maximum is one of its
+ * two children. Both extremes are O(1) to read and O(log n) to delete,
+ * without keeping a second heap.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <heap.h>
+
+typedef struct minmax_heap_ {
+    heap_elem_t *mh_arr;
+    uint64_t mh_capacity;
+    uint64_t mh_curr_size;
+    uint64_t mh_min_capacity;
+    uint32_t mh_flags;
+} minmax_heap_t;
+
+/*
+ * 'flags' takes the HEAP_F_GROW and HEAP_F_SHRINK flags from heap.h.
+ * Without HEAP_F_GROW an insert into a full heap fails with EFAULT.
+ */
+minmax_heap_t *create_minmax_heap(uint64_t size, uint32_t flags);
+int destroy_minmax_heap(minmax_heap_t *h);
+
+int insert_minmax_heap(minmax_heap_t *h, heap_elem_t *elem);
+
+/*
+ * The returned pointers are only valid until the next change to the
+ * heap. Both return NULL on an empty heap.
+ */
+heap_elem_t *get_minmax_heap_min(minmax_heap_t *h);
+heap_elem_t *get_minmax_heap_max(minmax_heap_t *h);
+
+/*
+ * Remove an extreme, copying it into 'out' if non NULL. Returns EFAULT
+ * on an empty heap.
+ */
+int delete_minmax_heap_min(minmax_heap_t *h, heap_elem_t *out);
+int delete_minmax_heap_max(minmax_heap_t *h, heap_elem_t *out);
+
+bool minmax_heap_is_empty(minmax_heap_t *h);
+uint64_t minmax_heap_size(minmax_heap_t *h);
+void print_minmax_heap(minmax_heap_t *h);
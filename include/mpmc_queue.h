@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Bounded Lock-free Multi Producer Multi Consumer Queue
+ *
+ * Vyukov's array queue. Every slot carries a sequence number that says
+ * whose turn it is: a slot at position p is free for the producer that
+ * claims p when its sequence is p, and holds data for the consumer that
+ * claims p when its sequence is p + 1. Producers and consumers claim
+ * positions with a CAS on their own counter and then only touch their
+ * slot, so the two sides never contend on the same word unless the
+ * queue is full or empty.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#define MPMC_QUEUE_CACHE_LINE   64
+
+typedef struct mpmc_queue_ {
+    _Atomic uint64_t mp_tail __attribute__((aligned(MPMC_QUEUE_CACHE_LINE)));
+    _Atomic uint64_t mp_head __attribute__((aligned(MPMC_QUEUE_CACHE_LINE)));
+
+    /* Read only after creation. */
+    uint64_t mp_mask __attribute__((aligned(MPMC_QUEUE_CACHE_LINE)));
+    size_t mp_elem_size;
+    size_t mp_stride;
+    uint8_t *mp_slots;
+} mpmc_queue_t;
+
+/*
+ * 'capacity' is rounded up to a power of two of at least 2.
+ */
+mpmc_queue_t *create_mpmc_queue(uint64_t capacity, size_t elem_size);
+int destroy_mpmc_queue(mpmc_queue_t *q);
+
+/*
+ * Try variants return EAGAIN when the queue is full or empty. The plain
+ * variants spin, yielding the CPU now and then, until they succeed.
+ */
+int mpmc_queue_try_enqueue(mpmc_queue_t *q, const void *elem);
+int mpmc_queue_try_dequeue(mpmc_queue_t *q, void *elem);
+int mpmc_queue_enqueue(mpmc_queue_t *q, const void *elem);
+int mpmc_queue_dequeue(mpmc_queue_t *q, void *elem);
+
+/*
+ * Move up to 'n' elements with a single claim on the shared counter and
+ * store how many moved in 'done'. Return EAGAIN if none could move.
+ * The batch is sized from the other side's counter, which counts claims
+ * rather than finished copies, so a claimed slot may not be ready yet:
+ * an enqueue batch waits for a consumer still reading the slot's element
+ * from the previous lap, and a dequeue batch waits for a producer of the
+ * current lap that has claimed the slot but not yet published into it.
+ * Both waits last only as long as the other thread's copy, unless that
+ * thread is preempted mid copy.
+ */
+int mpmc_queue_try_enqueue_batch(mpmc_queue_t *q, const void *elems,
+                                 uint64_t n, uint64_t *done);
+int mpmc_queue_try_dequeue_batch(mpmc_queue_t *q, void *elems, uint64_t n,
+                                 uint64_t *done);
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Relaxed Concurrent Priority Queue (MultiQueue)
+ *
+ * c * P sequential MIN heaps, each behind its own try-lock. Insert pushes
+ * into a random heap. Delete-min samples two random heaps, and pops from
+ * whichever has the smaller cached top. Threads rarely contend on the
+ * same lock, so throughput scales with P. The price is that a pop
+ * returns an element near the minimum rather than the exact minimum;
+ * the expected rank error grows with c * P.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <heap.h>
+
+typedef struct multiqueue_ multiqueue_t;
+
+/*
+ * 'num_threads' is the expected number of concurrent callers (P) and
+ * 'factor' is the number of heaps per thread (c), usually 2 to 4.
+ */
+multiqueue_t *create_multiqueue(uint64_t num_threads, uint64_t factor);
+int destroy_multiqueue(multiqueue_t *mq);
+
+/*
+ * Keys must be below UINT64_MAX, which marks an empty heap.
+ * delete_min returns ENOENT once every heap is seen empty.
+ */
+int multiqueue_insert(multiqueue_t *mq, heap_elem_t *elem);
+int multiqueue_delete_min(multiqueue_t *mq, heap_elem_t *min);
+
+uint64_t multiqueue_num_heaps(multiqueue_t *mq);
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Per-thread Node Caches for List and Tree Allocation
+ *
+ * Every thread keeps a private free list of recycled nodes per node type.
+ * Allocation and free only touch that list in the common case. When a
+ * thread's list runs dry it takes a whole batch from a shared depot, and
+ * when it grows past two batches it hands one batch back, so nodes move
+ * between producer and consumer threads in bulk under a single lock.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+
+/* Number of nodes moved between a thread and the shared depot at once. */
+#define NODE_CACHE_BATCH        64
+
+/* Full batches the depot keeps before giving memory back to malloc. */
+#define NODE_CACHE_DEPOT_MAX    1024
+
+typedef enum node_cache_id_ {
+    NODE_CACHE_SLIST = 0,
+    NODE_CACHE_DLIST,
+    NODE_CACHE_BT,
+    NODE_CACHE_PAIRING_HEAP,
+    NODE_CACHE_AVL,
+    NODE_CACHE_MAX,
+} node_cache_id_e;
+
+/*
+ * Free nodes are chained through their own storage, so every cached
+ * type must be at least as large as this header.
+ */
+typedef struct node_cache_obj_ {
+    struct node_cache_obj_ *next;
+    struct node_cache_obj_ *batch_next; // Valid on a batch head in the depot.
+    uint64_t batch_count;               // Valid on a batch head in the depot.
+} node_cache_obj_t;
+
+/*
+ * Thread local magazine for one node type.
+ *
+ *      free_list - Recycled nodes owned by this thread.
+ *      count - Number of nodes on free_list.
+ *      limit - Count at which a batch is returned to the depot. It
+ *              starts at zero so the first free on a new thread takes
+ *              the slow path and registers the thread exit flush.
+ */
+typedef struct node_cache_tls_ {
+    node_cache_obj_t *free_list;
+    uint64_t count;
+    uint64_t limit;
+} node_cache_tls_t;
+
+/*
+ * Shared depot for one node type, holding full batches of free nodes.
+ */
+typedef struct node_cache_ {
+    size_t obj_size;
+    pthread_mutex_t lock;
+    node_cache_obj_t *batches;
+    uint64_t num_batches;
+} node_cache_t;
+
+extern _Thread_local node_cache_tls_t node_cache_tls[NODE_CACHE_MAX];
+
+void *node_cache_alloc_slow(node_cache_id_e id);
+void node_cache_free_slow(node_cache_id_e id, void *obj);
+
+static inline void *
+node_cache_alloc(node_cache_id_e id)
+{
+    node_cache_tls_t *tls = &node_cache_tls[id];
+    node_cache_obj_t *obj = tls->free_list;
+
+    if (obj == NULL) {
+        return node_cache_alloc_slow(id);
+    }
+
+    tls->free_list = obj->next;
+    tls->count--;
+    return obj;
+}
+
+static inline void
+node_cache_free(node_cache_id_e id, void *obj)
+{
+    node_cache_tls_t *tls = &node_cache_tls[id];
+
+    if (obj == NULL) {
+        return;
+    }
+
+    if (tls->count >= tls->limit) {
+        node_cache_free_slow(id, obj);
+        return;
+    }
+
+    ((node_cache_obj_t *)obj)->next = tls->free_list;
+    tls->free_list = (node_cache_obj_t *)obj;
+    tls->count++;
+}
+
+/*
+ * Return the calling thread's cached nodes to the depot. This runs
+ * automatically at thread exit and is exposed for long lived threads
+ * that go idle.
+ */
+void node_cache_thread_flush(void);
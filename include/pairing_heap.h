@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Pairing Heap Data Structure Operations
+ *
+ * A heap ordered multiway tree stored as child/sibling links. Insert and
+ * meld are a single link operation, delete of the root uses the two pass
+ * pairing scheme for amortized O(log n), and moving a key towards the
+ * root cuts the node's subtree and links it back at the root. Nodes come
+ * from the per-thread node cache.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <heap.h>
+
+/*
+ * Pairing heap node. Callers keep the pointer returned by insert as a
+ * handle for later key changes or removal.
+ *
+ *      child - Leftmost child.
+ *      next - Right sibling.
+ *      prev - Left sibling, or parent for a leftmost child.
+ */
+typedef struct pairing_heap_node_ {
+    uint64_t key;
+    void *payload;
+    struct pairing_heap_node_ *child;
+    struct pairing_heap_node_ *next;
+    struct pairing_heap_node_ *prev;
+} pairing_heap_node_t;
+
+typedef struct pairing_heap_ {
+    heap_type_e ph_type;
+    pairing_heap_node_t *ph_root;
+    uint64_t ph_size;
+} pairing_heap_t;
+
+pairing_heap_t *create_pairing_heap(heap_type_e type);
+int destroy_pairing_heap(pairing_heap_t *h);
+
+pairing_heap_node_t *pairing_heap_insert(pairing_heap_t *h, uint64_t key,
+                                         void *payload);
+pairing_heap_node_t *pairing_heap_top(pairing_heap_t *h);
+int pairing_heap_pop(pairing_heap_t *h, uint64_t *key, void **payload);
+int pairing_heap_remove(pairing_heap_t *h, pairing_heap_node_t *node);
+
+/*
+ * Numeric key changes. The cheap direction (decrease on MIN_HEAP,
+ * increase on MAX_HEAP) is O(1); the other direction re-pairs the
+ * node's children and costs the same as a pop. Moving a key the
+ * opposite way to the function name returns EINVAL.
+ */
+int pairing_heap_decrease_key(pairing_heap_t *h, pairing_heap_node_t *node,
+                              uint64_t key);
+int pairing_heap_increase_key(pairing_heap_t *h, pairing_heap_node_t *node,
+                              uint64_t key);
+
+/*
+ * Move every node of 'src' into 'dst' in O(1). Both heaps must be of the
+ * same type. 'src' is left empty and still has to be destroyed.
+ */
+int pairing_heap_meld(pairing_heap_t *dst, pairing_heap_t *src);
+
+bool pairing_heap_is_empty(pairing_heap_t *h);
@@ -2,24 +2,63 @@
  * Copyright (c) 2024 Vedant Mathur
  *
  * Queue Data Structure Operations
+ *
+ * A ring buffer whose capacity is always a power of two, so positions
+ * wrap with a mask instead of a modulo. A queue created with
+ * SIMPLE_Q_F_GROW doubles its array when full; the wrapped part of the
+ * ring is moved past the old end, so elements keep their order.
  */
 
+#pragma once
+
 #include <stdint.h>
 #include <stdbool.h>
 
+/*
+ * Queue creation flags.
+ *
+ *      SIMPLE_Q_F_GROW - Grow instead of failing when full. max_size is
+ *                        then only the initial capacity.
+ */
+#define SIMPLE_Q_F_GROW     0x1
+
+/*
+ * Slots hold either a plain key or a pointer, so pointer payloads do not
+ * need to be cast through uint64_t.
+ */
+typedef union simple_q_slot_ {
+    uint64_t key;
+    void *ptr;
+} simple_q_slot_t;
+
+/*
+ *      front, rear - Array positions of the next dequeue and enqueue.
+ *      max_size - Bound on curr_size for queues that do not grow.
+ *      mask - Array capacity minus one.
+ */
 typedef struct simple_queue_ {
     uint64_t front;
     uint64_t rear;
     uint64_t max_size;
     uint64_t curr_size;
-    uint64_t *arr;
+    uint64_t mask;
+    uint32_t flags;
+    simple_q_slot_t *arr;
 } simple_q;
 
 simple_q* create_simple_q(uint64_t size);
+simple_q* create_simple_q_flags(uint64_t size, uint32_t flags);
 void destroy_simple_q(simple_q *q);
 
+/*
+ * All enqueue and dequeue variants return -1 when the queue is full or
+ * empty, or when growing fails.
+ */
 int simple_q_enqueue(simple_q *q, uint64_t key);
 int simple_q_dequeue(simple_q *q, uint64_t *out);
+int simple_q_enqueue_ptr(simple_q *q, void *ptr);
+int simple_q_dequeue_ptr(simple_q *q, void **out);
+
 bool simple_q_is_full(simple_q *q);
 bool simple_q_is_empty(simple_q *q);
 void print_simple_q(simple_q *q);
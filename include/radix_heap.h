@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Radix Heap Data Structure Operations
+ *
+ * A monotone min priority queue for uint64_t keys. Every key pushed must
+ * be at least the last key popped, which holds for shortest path and
+ * timer workloads. Keys are bucketed by the highest bit in which they
+ * differ from the last popped minimum, so each key moves to a lower
+ * bucket at most 64 times over its life and buckets are plain arrays
+ * that are scanned sequentially.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <heap.h>
+
+/* Bucket 0 holds keys equal to the last minimum, bucket b >= 1 holds
+ * keys whose highest differing bit is b - 1. */
+#define RADIX_HEAP_NUM_BUCKETS 65
+
+typedef struct radix_heap_bucket_ {
+    heap_elem_t *rb_arr;
+    uint64_t rb_size;
+    uint64_t rb_capacity;
+} radix_heap_bucket_t;
+
+typedef struct radix_heap_ {
+    radix_heap_bucket_t rh_buckets[RADIX_HEAP_NUM_BUCKETS];
+    uint64_t rh_last_min;
+    uint64_t rh_curr_size;
+} radix_heap_t;
+
+radix_heap_t *create_radix_heap(void);
+int destroy_radix_heap(radix_heap_t *h);
+
+/*
+ * Same push/pop surface as heap_t. insert fails with EINVAL for keys
+ * below the last popped minimum. get_min may redistribute a bucket, so
+ * it is not a pure read, and the pointer it returns is only valid until
+ * the next call on the heap.
+ */
+int insert_radix_heap(radix_heap_t *h, heap_elem_t *elem);
+heap_elem_t *get_radix_heap_min(radix_heap_t *h);
+int delete_radix_heap_min(radix_heap_t *h, heap_elem_t *min);
+bool radix_heap_is_empty(radix_heap_t *h);
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Shared Memory Message Queue
+ *
+ * A byte ring that lives in a named POSIX shared memory segment, so a
+ * producer and a consumer in different processes can pass messages of
+ * any length without going through the kernel. Every message is framed
+ * by an 8 byte header holding its length and type, and frames are
+ * padded to 8 bytes so headers stay aligned. A message that would run
+ * past the end of the ring is preceded by a padding frame that fills
+ * the rest of it, so every payload is contiguous and can be written and
+ * read in place.
+ *
+ * Producers claim space by advancing a shared head with a CAS, write
+ * the payload, and then publish the frame by storing its header with
+ * release semantics. The single consumer waits for the header at its
+ * tail, reads the payload, zeroes the frame and advances the tail.
+ * Zeroing is what lets the consumer tell a published header from stale
+ * bytes of an earlier lap. Producers may finish out of order; the
+ * consumer simply stops at the first frame not yet published.
+ *
+ * Any number of processes may produce (MPSC). Passing SHM_Q_F_SPSC at
+ * creation promises a single producer and replaces the CAS with a plain
+ * store.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define SHM_Q_CACHE_LINE        64
+#define SHM_Q_MAGIC             0x53484d5155455545ULL   // "SHMQUEUE"
+
+/* Only one process will ever produce. */
+#define SHM_Q_F_SPSC            0x1
+
+/*
+ * Start of the shared segment. The ring follows at sh_data.
+ *
+ *      sh_magic - Set last by the creator; open checks it.
+ *      sh_head - Bytes claimed by producers.
+ *      sh_tail - Bytes consumed.
+ */
+typedef struct shm_q_hdr_ {
+    _Atomic uint64_t sh_magic;
+    uint64_t sh_capacity;
+    uint32_t sh_flags;
+
+    _Atomic uint64_t sh_head __attribute__((aligned(SHM_Q_CACHE_LINE)));
+    _Atomic uint64_t sh_tail __attribute__((aligned(SHM_Q_CACHE_LINE)));
+
+    uint8_t sh_data[] __attribute__((aligned(SHM_Q_CACHE_LINE)));
+} shm_q_hdr_t;
+
+/*
+ * Per process handle onto a mapped segment. A handle is used by one
+ * thread at a time; producer threads in the same process each open
+ * their own.
+ *
+ *      sq_cached_tail - Producer's last view of sh_tail.
+ *      sq_owner - The segment was created through this handle and is
+ *                 unlinked when it is destroyed.
+ */
+typedef struct shm_q_ {
+    shm_q_hdr_t *sq_hdr;
+    uint8_t *sq_data;
+    uint64_t sq_mask;
+    uint64_t sq_max_msg;
+    uint64_t sq_cached_tail;
+    size_t sq_map_size;
+    bool sq_owner;
+    char *sq_name;
+} shm_q;
+
+/*
+ * create_shm_q makes a new segment called 'name' (a shm_open name such
+ * as "/pipeline") with a ring of 'capacity' bytes, rounded up to a
+ * power of two, and fails if the name is already taken. open_shm_q maps
+ * an existing one. Both return NULL on failure with errno set.
+ */
+shm_q *create_shm_q(const char *name, uint64_t capacity, uint32_t flags);
+shm_q *open_shm_q(const char *name);
+
+/*
+ * Unmap the segment. The creator's handle also unlinks the name;
+ * processes that still have it mapped keep working.
+ */
+int destroy_shm_q(shm_q *q);
+
+/*
+ * Producer side zero copy. shm_q_reserve returns room for a 'len' byte
+ * message, or NULL with errno EAGAIN when the ring is full and EMSGSIZE
+ * when 'len' is larger than sq_max_msg (just under half the ring). The
+ * message is not visible to the consumer until shm_q_commit is called
+ * on the pointer.
+ */
+void *shm_q_reserve(shm_q *q, uint32_t len);
+int shm_q_commit(shm_q *q, void *msg);
+
+/*
+ * Consumer side zero copy. shm_q_peek returns the oldest published
+ * message and its length, or NULL with errno EAGAIN when there is none.
+ * The message stays valid until shm_q_release hands its space back.
+ */
+void *shm_q_peek(shm_q *q, uint32_t *len);
+int shm_q_release(shm_q *q);
+
+/*
+ * Copying wrappers. shm_q_recv returns EMSGSIZE, leaving the message in
+ * place, if it is longer than 'max'; 'len' then holds the length needed.
+ */
+int shm_q_send(shm_q *q, const void *buf, uint32_t len);
+int shm_q_recv(shm_q *q, void *buf, uint32_t max, uint32_t *len);
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Lock-free Single Producer Single Consumer Ring
+ *
+ * A bounded ring of fixed size elements shared by exactly one producer
+ * thread and one consumer thread. Head and tail are free running counts
+ * that each side owns and publishes with a release store. Each side also
+ * keeps a private copy of the other side's index and only re-reads the
+ * shared one when the copy says the ring is full (or empty), so in the
+ * steady state neither side touches the other's cache line.
+ *
+ * Besides single element push and pop, both sides can work on runs of
+ * slots in place: the producer reserves contiguous free slots, fills
+ * them and commits, and the consumer peeks at contiguous ready slots,
+ * reads them and releases.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#define SPSC_RING_CACHE_LINE    64
+
+typedef struct spsc_ring_ {
+    /* Producer side. */
+    _Atomic uint64_t sr_head __attribute__((aligned(SPSC_RING_CACHE_LINE)));
+    uint64_t sr_cached_tail;
+
+    /* Consumer side. */
+    _Atomic uint64_t sr_tail __attribute__((aligned(SPSC_RING_CACHE_LINE)));
+    uint64_t sr_cached_head;
+
+    /* Read only after creation. */
+    uint64_t sr_mask __attribute__((aligned(SPSC_RING_CACHE_LINE)));
+    size_t sr_elem_size;
+    uint8_t *sr_buf;
+} spsc_ring_t;
+
+/*
+ * 'capacity' is rounded up to a power of two.
+ */
+spsc_ring_t *create_spsc_ring(uint64_t capacity, size_t elem_size);
+int destroy_spsc_ring(spsc_ring_t *r);
+
+/*
+ * Copy one element in or out. Return EAGAIN when the ring is full or
+ * empty.
+ */
+int spsc_ring_push(spsc_ring_t *r, const void *elem);
+int spsc_ring_pop(spsc_ring_t *r, void *elem);
+
+/*
+ * Producer side zero copy. spsc_ring_reserve returns up to 'want'
+ * contiguous free slots and stores how many in 'got'; it returns NULL
+ * with 'got' zero when the ring is full. Fewer than 'want' slots come
+ * back when the ring is nearly full or the run reaches the end of the
+ * array. spsc_ring_commit publishes the first 'n' reserved slots.
+ */
+void *spsc_ring_reserve(spsc_ring_t *r, uint64_t want, uint64_t *got);
+int spsc_ring_commit(spsc_ring_t *r, uint64_t n);
+
+/*
+ * Consumer side zero copy, mirroring reserve and commit. The slots
+ * returned by spsc_ring_peek stay valid until spsc_ring_release hands
+ * them back to the producer.
+ */
+void *spsc_ring_peek(spsc_ring_t *r, uint64_t want, uint64_t *got);
+int spsc_ring_release(spsc_ring_t *r, uint64_t n);
+
+/*
+ * Number of elements in the ring. Only exact when called from a side
+ * whose counterpart is idle.
+ */
+uint64_t spsc_ring_size(spsc_ring_t *r);
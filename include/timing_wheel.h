@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Hierarchical Timing Wheel
+ *
+ * TW_LEVELS wheels of TW_SLOTS slots each. Level 0 covers the next
+ * TW_SLOTS ticks one slot per tick, and each higher level covers
+ * TW_SLOTS times the range of the level below it. Timers are intrusive
+ * and sit on doubly linked slot lists, so schedule and cancel are O(1).
+ * Each tick expires a whole level 0 slot as one batch. When level 0
+ * wraps, the matching slot of the next level is cascaded down.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TW_SLOT_BITS    8
+#define TW_SLOTS        (1 << TW_SLOT_BITS)
+#define TW_SLOT_MASK    (TW_SLOTS - 1)
+#define TW_LEVELS       4
+
+/* Furthest a timer can be placed ahead of the wheel, in ticks. Timers
+ * further out are parked at the horizon and re-placed on cascade. */
+#define TW_MAX_DELTA    ((1ULL << (TW_SLOT_BITS * TW_LEVELS)) - 1)
+
+typedef struct tw_list_ {
+    struct tw_list_ *next;
+    struct tw_list_ *prev;
+} tw_list_t;
+
+/*
+ * Timer embedded by the caller. 'node' must stay first so a list entry
+ * can be turned back into its timer.
+ */
+typedef struct tw_timer_ {
+    tw_list_t node;
+    uint64_t expires;
+    void *payload;
+} tw_timer_t;
+
+typedef void (*tw_expirycb)(tw_timer_t *t);
+
+/*
+ * tw_now is the next tick to be processed.
+ */
+typedef struct timing_wheel_ {
+    uint64_t tw_now;
+    uint64_t tw_count;
+    tw_list_t tw_slots[TW_LEVELS][TW_SLOTS];
+} timing_wheel_t;
+
+timing_wheel_t *create_timing_wheel(uint64_t start_tick);
+int destroy_timing_wheel(timing_wheel_t *tw);
+
+void tw_timer_init(tw_timer_t *t, void *payload);
+bool tw_timer_pending(tw_timer_t *t);
+
+/*
+ * Schedule 't' to expire at absolute tick 'expires'. Ticks already
+ * passed expire on the next processed tick. Re-scheduling a pending
+ * timer moves it.
+ */
+int timing_wheel_schedule(timing_wheel_t *tw, tw_timer_t *t, uint64_t expires);
+int timing_wheel_cancel(timing_wheel_t *tw, tw_timer_t *t);
+
+/*
+ * Process every tick up to and including 'now', calling 'cb' for each
+ * expired timer. Callbacks may schedule or cancel any timer. Returns
+ * the number of timers expired.
+ */
+uint64_t timing_wheel_advance(timing_wheel_t *tw, uint64_t now,
+                              tw_expirycb cb);
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Lock-free Treiber Stack
+ *
+ * A concurrent LIFO of caller owned nodes, meant for shared free lists:
+ * the node is embedded in (or is the start of) the caller's buffer, so
+ * pushing and popping never allocate. Push and pop are a single CAS on
+ * the head word.
+ *
+ * The head word packs the top node's address together with a tag that
+ * every pop bumps. A thread that read the head, was delayed while the
+ * top node was popped and pushed back, and then tries its CAS sees a
+ * different tag and retries instead of installing a stale next pointer
+ * (the ABA problem). Nodes are 8 byte aligned and user space addresses
+ * fit in 48 bits on the 64 bit targets we build for, which leaves 19
+ * bits for the tag.
+ *
+ * A pop may still read the next pointer of a node that another thread
+ * has just taken, so nodes must stay mapped while the stack is in use.
+ * That holds for a free list, where nodes only move between the stack
+ * and its users.
+ *
+ * With TREIBER_F_ELIMINATE, a push or pop whose CAS fails under
+ * contention first tries to meet an operation of the opposite kind in
+ * a small elimination array: the push offers its node in a slot and a
+ * pop that finds it there takes it directly, so neither touches the
+ * head again.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define TREIBER_CACHE_LINE      64
+
+/* Elimination slots, each on its own cache line. */
+#define TREIBER_ELIM_SLOTS      8
+
+/* Checks a push makes for a taker before withdrawing its offer. */
+#define TREIBER_ELIM_SPINS      64
+
+/*
+ * Stack creation flags.
+ *
+ *      TREIBER_F_ELIMINATE - Back off into the elimination array when
+ *                            the head CAS fails.
+ */
+#define TREIBER_F_ELIMINATE     0x1
+
+typedef struct treiber_node_ {
+    _Atomic(struct treiber_node_ *) next;
+} treiber_node_t;
+
+typedef struct treiber_slot_ {
+    _Atomic(treiber_node_t *) node __attribute__((aligned(TREIBER_CACHE_LINE)));
+} treiber_slot_t;
+
+/*
+ *      tr_head - Top node address and pop count, packed.
+ */
+typedef struct treiber_stack_ {
+    _Atomic uint64_t tr_head __attribute__((aligned(TREIBER_CACHE_LINE)));
+    uint32_t tr_flags __attribute__((aligned(TREIBER_CACHE_LINE)));
+    treiber_slot_t tr_elim[TREIBER_ELIM_SLOTS];
+} treiber_stack_t;
+
+treiber_stack_t *create_treiber_stack(uint32_t flags);
+int destroy_treiber_stack(treiber_stack_t *s);
+
+/*
+ * pop returns ENOENT when the stack is empty.
+ */
+int treiber_stack_push(treiber_stack_t *s, treiber_node_t *node);
+int treiber_stack_pop(treiber_stack_t *s, treiber_node_t **node);
+
+/*
+ * Push 'n' nodes with one CAS; nodes[n - 1] ends up on top.
+ */
+int treiber_stack_push_batch(treiber_stack_t *s, treiber_node_t **nodes,
+                             uint64_t n);
+
+/*
+ * Detach the whole stack and return it as a list linked through next,
+ * top first, or NULL when empty.
+ */
+treiber_node_t *treiber_stack_pop_all(treiber_stack_t *s);
+
+bool treiber_stack_is_empty(treiber_stack_t *s);
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Chase-Lev Work Stealing Deque
+ *
+ * A deque of pointers owned by one thread. The owner pushes and pops
+ * at the bottom, which costs plain loads and stores except when the
+ * deque is down to its last element; any number of thieves steal from
+ * the top with a CAS. Follows the C11 formulation by Le, Pop, Cohen and
+ * Zappa Nardelli.
+ *
+ * The array doubles when the owner runs out of room. A thief may still
+ * be reading the old array at that point, so replaced arrays are kept
+ * on a list and only freed by destroy_ws_deque. Since each array is
+ * twice the one before it, they add up to less than the live one.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+#define WS_DEQUE_CACHE_LINE     64
+
+typedef struct ws_array_ {
+    struct ws_array_ *prev;     // Replaced array, freed at destroy.
+    int64_t mask;
+    _Atomic(void *) slots[];
+} ws_array_t;
+
+typedef struct ws_deque_ {
+    _Atomic int64_t wd_top __attribute__((aligned(WS_DEQUE_CACHE_LINE)));
+    _Atomic int64_t wd_bottom __attribute__((aligned(WS_DEQUE_CACHE_LINE)));
+    _Atomic(ws_array_t *) wd_array;
+} ws_deque_t;
+
+/*
+ * 'capacity' is rounded up to a power of two. It is only the starting
+ * size; push grows the array as needed.
+ */
+ws_deque_t *create_ws_deque(uint64_t capacity);
+int destroy_ws_deque(ws_deque_t *d);
+
+/*
+ * Owner only. push returns ENOMEM if the array had to grow and could
+ * not; pop returns ENOENT when the deque is empty.
+ */
+int ws_deque_push(ws_deque_t *d, void *item);
+int ws_deque_pop(ws_deque_t *d, void **item);
+
+/*
+ * Any thread. Returns ENOENT when the deque is empty and EAGAIN when it
+ * lost a race with the owner or another thief, in which case trying
+ * again may succeed.
+ */
+int ws_deque_steal(ws_deque_t *d, void **item);
+
+/*
+ * Number of items, exact only when no other thread is using the deque.
+ */
+uint64_t ws_deque_size(ws_deque_t *d);
@@ -10,29 +10,51 @@
 #include <errno.h>
 #include <stdio.h>
 
+void
+dsa_stack_init(dsa_stack_t *s, uint64_t capacity, uint32_t flags)
+{
+    s->capacity = (flags & DSA_STACK_F_GROW) ? UINT64_MAX : capacity;
+    s->curr_size = 0;
+    s->base = s->inline_elements;
+    s->limit = s->inline_elements + DSA_STACK_INLINE_SIZE;
+    s->next = s->base;
+    s->chunk = NULL;
+    s->spare = NULL;
+    s->flags = flags;
+}
+
+void
+dsa_stack_fini(dsa_stack_t *s)
+{
+    while (s->chunk) {
+        dsa_stack_chunk_t *prev = s->chunk->prev;
+        free(s->chunk);
+        s->chunk = prev;
+    }
+    free(s->spare);
+    s->spare = NULL;
+}
+
 dsa_stack_t *
-create_dsa_stack(uint64_t capacity)
+create_dsa_stack_flags(uint64_t capacity, uint32_t flags)
 {
     dsa_stack_t *s = (dsa_stack_t *)malloc(sizeof(dsa_stack_t));
     if (s == NULL) {
         goto done;
     }
 
-    s->elements = (uint64_t*)malloc(capacity * sizeof(uint64_t));
-    if (s->elements == NULL) {
-        free(s);
-        s = NULL;
-        goto done;
-    }
-
-    s->capacity = capacity;
-    s->curr_size = 0;
-    s->top = NULL;
+    dsa_stack_init(s, capacity, flags);
 
 done:
     return s;
 }
 
+dsa_stack_t *
+create_dsa_stack(uint64_t capacity)
+{
+    return create_dsa_stack_flags(capacity, 0);
+}
+
 int
 destroy_dsa_stack(dsa_stack_t *s)
 {
@@ -43,13 +65,59 @@ destroy_dsa_stack(dsa_stack_t *s)
         goto done;
     }
 
-    free(s->elements);
+    dsa_stack_fini(s);
     free(s);
 
 done:
     return error;
 }
 
+/*
+ * Move up into the spare chunk, or a new one.
+ */
+static int
+dsa_stack_push_chunk(dsa_stack_t *s)
+{
+    dsa_stack_chunk_t *c = s->spare;
+
+    if (c == NULL) {
+        c = (dsa_stack_chunk_t *)malloc(sizeof(dsa_stack_chunk_t));
+        if (c == NULL) {
+            return ENOMEM;
+        }
+    }
+
+    s->spare = NULL;
+    c->prev = s->chunk;
+    s->chunk = c;
+    s->base = c->elements;
+    s->limit = c->elements + DSA_STACK_CHUNK_SIZE;
+    s->next = s->base;
+    return 0;
+}
+
+/*
+ * Move back down from an empty chunk, keeping it as the spare.
+ */
+static void
+dsa_stack_pop_chunk(dsa_stack_t *s)
+{
+    dsa_stack_chunk_t *c = s->chunk;
+
+    free(s->spare);
+    s->spare = c;
+    s->chunk = c->prev;
+
+    if (s->chunk) {
+        s->base = s->chunk->elements;
+        s->limit = s->chunk->elements + DSA_STACK_CHUNK_SIZE;
+    } else {
+        s->base = s->inline_elements;
+        s->limit = s->inline_elements + DSA_STACK_INLINE_SIZE;
+    }
+    s->next = s->limit;
+}
+
 int
 dsa_stack_push(dsa_stack_t *s, uint64_t key)
 {
@@ -65,8 +133,14 @@ dsa_stack_push(dsa_stack_t *s, uint64_t key)
         goto done;
     }
 
-    s->elements[s->curr_size] = key;
-    s->top = &s->elements[s->curr_size];
+    if (s->next == s->limit) {
+        error = dsa_stack_push_chunk(s);
+        if (error) {
+            goto done;
+        }
+    }
+
+    *s->next++ = key;
     s->curr_size++;
 
 done:
@@ -88,9 +162,13 @@ dsa_stack_pop(dsa_stack_t *s, uint64_t *key)
         goto done;
     }
 
-    *key = *s->top;
+    *key = *--s->next;
     s->curr_size--;
-    s->top = &s->elements[s->curr_size - 1];
+
+    /* Keep the top element in the current segment while non empty. */
+    if (s->next == s->base && s->chunk) {
+        dsa_stack_pop_chunk(s);
+    }
 
 done:
     return error;
@@ -111,7 +189,7 @@ dsa_stack_top(dsa_stack_t *s, uint64_t *key)
         goto done;
     }
 
-    *key = *s->top;
+    *key = s->next[-1];
 
 done:
     return error;
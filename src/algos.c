@@ -6,6 +6,8 @@
 
 #include <algos.h>
 #include <stdio.h>
+#include <errno.h>
+#include <string.h>
 
 int
 linear_search_arr(uint64_t *arr, int arr_len, uint64_t target)
@@ -155,63 +157,365 @@ void quick_sort(int64_t *arr, int len)
     quick_sort_helper(arr, 0, len - 1);
 }
 
+/*
+ * Merge the sorted runs arr[low..mid] and arr[mid+1..high]. Only the
+ * left run is copied out to 'tmp'; the merge writes back from the left
+ * and can never overtake the unread part of the right run.
+ */
 static void
-merge(int64_t *arr, int low, int mid, int high)
+merge(int64_t *arr, int low, int mid, int high, int64_t *tmp)
 {
     int len1 = mid - low + 1;
-    int len2 = high - mid;
-    int i, j, k = 0;
+    int i = 0;
+    int j = mid + 1;
+    int k = low;
 
-    int arr1[len1];
-    int arr2[len2];
+    memcpy(tmp, &arr[low], len1 * sizeof(int64_t));
 
-    for (i = 0; i < len1; i++) {
-        arr1[i] = arr[low + i];
+    while (i < len1 && j <= high) {
+        if (arr[j] < tmp[i]) {
+            arr[k++] = arr[j++];
+        } else {
+            arr[k++] = tmp[i++];
+        }
     }
 
-    for (j = 0; j < len2; j++) {
-        arr2[j] = arr[mid + j];
+    while (i < len1) {
+        arr[k++] = tmp[i++];
     }
+}
 
-    i = 0;
-    j = 0;
-    k = 0;
-    while (i < len1 && j < len2) {
-        if (arr1[i] < arr2[j]) {
-            arr[k] = arr1[i];
-            i++;
-        } else {
-            arr[k] = arr2[j];
-            j++;
+static void
+merge_sort_helper(int64_t *arr, int low, int high, int64_t *tmp)
+{
+    if (low < high) {
+        int mid = (low + (high - low) / 2);
+        merge_sort_helper(arr, low, mid, tmp);
+        merge_sort_helper(arr, mid + 1, high, tmp);
+        if (arr[mid] > arr[mid + 1]) {
+            merge(arr, low, mid, high, tmp);
         }
-        k++;
     }
+}
 
-    while (i < len1) {
-        arr[k] = arr1[i];
-        k++;
+int
+merge_sort_arena(int64_t *arr, int len, arena_t *arena)
+{
+    int error = 0;
+    int64_t *tmp = NULL;
+    arena_mark_t mark = {0};
+    size_t tmp_size = ((len + 1) / 2) * sizeof(int64_t);
+
+    if (arena) {
+        mark = arena_mark(arena);
+    }
+
+    if (arr == NULL || len < 0) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (len < 2) {
+        goto done;
+    }
+
+    if (arena) {
+        tmp = (int64_t *)arena_alloc(arena, tmp_size);
+    } else {
+        tmp = (int64_t *)malloc(tmp_size);
+    }
+    if (tmp == NULL) {
+        error = ENOMEM;
+        goto done;
+    }
+
+    merge_sort_helper(arr, 0, len - 1, tmp);
+
+done:
+    if (arena) {
+        arena_release(arena, mark);
+    } else {
+        free(tmp);
+    }
+    return error;
+}
+
+void merge_sort(int64_t *arr, int len)
+{
+    merge_sort_arena(arr, len, NULL);
+}
+
+/* Elements tested against the selection threshold per block. */
+#define TOPK_BLOCK      16
+
+/*
+ * heap_t keys are unsigned; flipping the sign bit maps int64_t onto
+ * uint64_t without changing the order.
+ */
+#define TOPK_SIGN_BIT   (1ULL << 63)
+
+static uint64_t
+topk_key(int64_t value)
+{
+    return (uint64_t)value ^ TOPK_SIGN_BIT;
+}
+
+static int64_t
+topk_value(uint64_t key)
+{
+    return (int64_t)(key ^ TOPK_SIGN_BIT);
+}
+
+/*
+ * Written as a branch free reduction so the compiler can vectorize it.
+ */
+static bool
+topk_block_has_candidate(const int64_t *arr, int n, int64_t threshold,
+                         bool largest)
+{
+    int hit = 0;
+
+    if (largest) {
+        for (int i = 0; i < n; i++) {
+            hit |= (arr[i] > threshold);
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            hit |= (arr[i] < threshold);
+        }
+    }
+
+    return (hit != 0);
+}
+
+/*
+ * Feed 'arr' into a bounded heap holding the best 'k' values seen. For
+ * the largest values the heap is a MIN_HEAP so its root is the value to
+ * beat, and the other way round for the smallest.
+ */
+static int
+topk_push(heap_t *h, uint64_t k, const int64_t *arr, int len, bool largest)
+{
+    int error = 0;
+    int i = 0;
+    heap_elem_t elem = {0};
+
+    while (i < len && h->h_curr_size < k) {
+        elem.key = topk_key(arr[i++]);
+        error = insert_heap(h, &elem);
+        if (error) {
+            goto done;
+        }
     }
 
-    while (j < len2) {
-        arr[k] = arr2[j];
-        k++;
+    while (i < len) {
+        int n = (len - i < TOPK_BLOCK) ? (len - i) : TOPK_BLOCK;
+        int64_t threshold = topk_value(h->h_arr[0].key);
+
+        if (topk_block_has_candidate(&arr[i], n, threshold, largest)) {
+            for (int j = i; j < i + n; j++) {
+                threshold = topk_value(h->h_arr[0].key);
+                if (largest ? (arr[j] > threshold) : (arr[j] < threshold)) {
+                    elem.key = topk_key(arr[j]);
+                    heap_replace_top(h, &elem);
+                }
+            }
+        }
+        i += n;
     }
 
+done:
+    return error;
 }
 
+/*
+ * Empty the heap into 'out'. Pops come out worst first, so fill from the
+ * back to leave 'out' best first.
+ */
 static void
-merge_sort_helper(int64_t *arr, int low, int high)
+topk_drain(heap_t *h, int64_t *out)
 {
-    if (low < high) {
-        int mid = (low + (high - low) / 2);
-        merge_sort_helper(arr, low, mid - 1);
-        merge_sort_helper(arr, mid, high);
-        merge(arr, low, mid, high);
+    heap_elem_t elem = {0};
+    uint64_t popped = 0;
+    uint64_t count = h->h_curr_size;
+
+    for (uint64_t i = count; i > 0; i--) {
+        heap_pop_batch(h, &elem, 1, &popped);
+        out[i - 1] = topk_value(elem.key);
     }
 }
 
-void merge_sort(int64_t *arr, int len)
+int
+top_k(int64_t *arr, int len, int k, int64_t *out)
 {
-    merge_sort_helper(arr, 0, len - 1);
+    int error = 0;
+    heap_t *h = NULL;
+
+    if (arr == NULL || out == NULL || k <= 0 || k > len) {
+        error = EINVAL;
+        goto done;
+    }
+
+    h = create_heap(MIN_HEAP, k);
+    if (h == NULL) {
+        error = ENOMEM;
+        goto done;
+    }
+
+    error = topk_push(h, k, arr, len, true);
+    if (error) {
+        goto done;
+    }
+
+    topk_drain(h, out);
+
+done:
+    if (h) {
+        destroy_heap(h);
+    }
+    return error;
+}
+
+int
+partial_sort(int64_t *arr, int len, int k)
+{
+    int error = 0;
+    heap_t *h = NULL;
+    int64_t pivot = 0;
+    int lt = 0;
+    int gt = len;
+    int i = 0;
+
+    if (arr == NULL || k <= 0 || k > len) {
+        error = EINVAL;
+        goto done;
+    }
+
+    h = create_heap(MAX_HEAP, k);
+    if (h == NULL) {
+        error = ENOMEM;
+        goto done;
+    }
+
+    error = topk_push(h, k, arr, len, false);
+    if (error) {
+        goto done;
+    }
+
+    /*
+     * Three way partition around the k-th smallest value so that the
+     * first k slots hold exactly the selected multiset, then overwrite
+     * them with the heap's contents in order.
+     */
+    pivot = topk_value(h->h_arr[0].key);
+    while (i < gt) {
+        if (arr[i] < pivot) {
+            swap(&arr[lt++], &arr[i++]);
+        } else if (arr[i] > pivot) {
+            swap(&arr[i], &arr[--gt]);
+        } else {
+            i++;
+        }
+    }
+
+    topk_drain(h, arr);
+
+done:
+    if (h) {
+        destroy_heap(h);
+    }
+    return error;
 }
 
+topk_stream_t *
+create_topk_stream(int k)
+{
+    topk_stream_t *s = NULL;
+
+    if (k <= 0) {
+        goto done;
+    }
+
+    s = (topk_stream_t *)malloc(sizeof(topk_stream_t));
+    if (s == NULL) {
+        goto done;
+    }
+
+    s->ts_heap = create_heap(MIN_HEAP, k);
+    if (s->ts_heap == NULL) {
+        free(s);
+        s = NULL;
+        goto done;
+    }
+    s->ts_k = k;
+
+done:
+    return s;
+}
+
+int
+destroy_topk_stream(topk_stream_t *s)
+{
+    int error = 0;
+
+    if (s == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    destroy_heap(s->ts_heap);
+    free(s);
+
+done:
+    return error;
+}
+
+int
+topk_stream_push(topk_stream_t *s, int64_t *arr, int len)
+{
+    int error = 0;
+
+    if (s == NULL || (arr == NULL && len != 0)) {
+        error = EINVAL;
+        goto done;
+    }
+
+    error = topk_push(s->ts_heap, s->ts_k, arr, len, true);
+
+done:
+    return error;
+}
+
+static int
+topk_compare_desc(const void *a, const void *b)
+{
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+
+    return (x < y) - (x > y);
+}
+
+int
+topk_stream_result(topk_stream_t *s, int64_t *out, int *count)
+{
+    int error = 0;
+    heap_t *h = NULL;
+
+    if (s == NULL || out == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    h = s->ts_heap;
+    for (uint64_t i = 0; i < h->h_curr_size; i++) {
+        out[i] = topk_value(h->h_arr[i].key);
+    }
+    qsort(out, h->h_curr_size, sizeof(int64_t), topk_compare_desc);
+
+    if (count) {
+        *count = h->h_curr_size;
+    }
+
+done:
+    return error;
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Arena Allocator Implementation.
+ */
+
+#include <arena.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+static _Thread_local arena_t *arena_tls;
+
+static pthread_once_t arena_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t arena_key;
+
+static void
+arena_thread_exit(void *arg)
+{
+    destroy_arena((arena_t *)arg);
+}
+
+static void
+arena_key_init(void)
+{
+    pthread_key_create(&arena_key, arena_thread_exit);
+}
+
+static void
+free_chunk_chain(arena_chunk_t *c)
+{
+    while (c) {
+        arena_chunk_t *prev = c->prev;
+        free(c);
+        c = prev;
+    }
+}
+
+arena_t *
+create_arena(size_t chunk_size)
+{
+    arena_t *a = (arena_t *)malloc(sizeof(arena_t));
+    if (a == NULL) {
+        goto done;
+    }
+
+    a->ar_chunk = NULL;
+    a->ar_ptr = NULL;
+    a->ar_end = NULL;
+    a->ar_free = NULL;
+    a->ar_chunk_size = chunk_size ? chunk_size : ARENA_DEFAULT_CHUNK;
+    a->ar_num_chunks = 0;
+
+done:
+    return a;
+}
+
+int
+destroy_arena(arena_t *a)
+{
+    int error = 0;
+
+    if (a == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    free_chunk_chain(a->ar_chunk);
+    free_chunk_chain(a->ar_free);
+    free(a);
+
+done:
+    return error;
+}
+
+/*
+ * Make a chunk with room for 'size' bytes current: the first one on the
+ * free list that is big enough, else a new one.
+ */
+static int
+arena_push_chunk(arena_t *a, size_t size)
+{
+    arena_chunk_t **link = &a->ar_free;
+    arena_chunk_t *c = NULL;
+
+    while (*link && (*link)->size < size) {
+        link = &(*link)->prev;
+    }
+
+    if (*link) {
+        c = *link;
+        *link = c->prev;
+    } else {
+        size_t chunk_size = (size > a->ar_chunk_size) ? size :
+                                                        a->ar_chunk_size;
+
+        /* A huge ar_chunk_size from create_arena must not wrap either. */
+        if (chunk_size > SIZE_MAX - sizeof(arena_chunk_t)) {
+            return ENOMEM;
+        }
+        c = (arena_chunk_t *)malloc(sizeof(arena_chunk_t) + chunk_size);
+        if (c == NULL) {
+            return ENOMEM;
+        }
+        c->size = chunk_size;
+        a->ar_num_chunks++;
+    }
+
+    c->prev = a->ar_chunk;
+    a->ar_chunk = c;
+    a->ar_ptr = c->data;
+    a->ar_end = c->data + c->size;
+    return 0;
+}
+
+void *
+arena_alloc(arena_t *a, size_t size)
+{
+    uintptr_t p = 0;
+
+    if (a == NULL) {
+        return NULL;
+    }
+
+    /*
+     * Past this, rounding up to ARENA_ALIGN or adding the chunk header
+     * would wrap around to a small size.
+     */
+    if (size > SIZE_MAX - ARENA_ALIGN - sizeof(arena_chunk_t)) {
+        return NULL;
+    }
+
+    /* Zero sized requests still get a distinct pointer. */
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if (size == 0) {
+        size = ARENA_ALIGN;
+    }
+    p = (uintptr_t)a->ar_ptr;
+
+    if (size > (uintptr_t)a->ar_end - p) {
+        if (arena_push_chunk(a, size) != 0) {
+            return NULL;
+        }
+        p = (uintptr_t)a->ar_ptr;
+    }
+
+    a->ar_ptr += size;
+    return (void *)p;
+}
+
+void *
+arena_calloc(arena_t *a, size_t count, size_t size)
+{
+    void *p = NULL;
+
+    if (size && count > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    p = arena_alloc(a, count * size);
+    if (p) {
+        memset(p, 0, count * size);
+    }
+    return p;
+}
+
+arena_mark_t
+arena_mark(arena_t *a)
+{
+    arena_mark_t mark = {a->ar_chunk, a->ar_ptr};
+
+    return mark;
+}
+
+int
+arena_release(arena_t *a, arena_mark_t mark)
+{
+    int error = 0;
+    arena_chunk_t *c = NULL;
+
+    if (a == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    /* The mark's chunk must still be on the chain below the current. */
+    for (c = a->ar_chunk; c != mark.am_chunk; c = c->prev) {
+        if (c == NULL) {
+            error = EINVAL;
+            goto done;
+        }
+    }
+    if (c && (mark.am_ptr < c->data || mark.am_ptr > c->data + c->size ||
+              (c == a->ar_chunk && mark.am_ptr > a->ar_ptr))) {
+        error = EINVAL;
+        goto done;
+    }
+
+    while (a->ar_chunk != mark.am_chunk) {
+        c = a->ar_chunk;
+        a->ar_chunk = c->prev;
+        c->prev = a->ar_free;
+        a->ar_free = c;
+    }
+
+    a->ar_ptr = mark.am_ptr;
+    a->ar_end = a->ar_chunk ? a->ar_chunk->data + a->ar_chunk->size : NULL;
+
+done:
+    return error;
+}
+
+void
+arena_reset(arena_t *a)
+{
+    arena_mark_t empty = {NULL, NULL};
+
+    arena_release(a, empty);
+}
+
+arena_t *
+arena_thread(void)
+{
+    if (arena_tls == NULL) {
+        arena_tls = create_arena(ARENA_DEFAULT_CHUNK);
+        if (arena_tls) {
+            pthread_once(&arena_key_once, arena_key_init);
+            pthread_setspecific(arena_key, arena_tls);
+        }
+    }
+
+    return arena_tls;
+}
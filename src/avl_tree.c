@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * AVL Tree Implementation.
+ */
+
+#include <avl_tree.h>
+#include <node_cache.h>
+#include <stdlib.h>
+#include <errno.h>
+
+static int32_t
+avl_height(avl_node_t *n)
+{
+    return n ? n->height : 0;
+}
+
+static void
+avl_update_height(avl_node_t *n)
+{
+    int32_t l = avl_height(n->left);
+    int32_t r = avl_height(n->right);
+
+    n->height = 1 + (l > r ? l : r);
+}
+
+static avl_node_t *
+avl_rotate_left(avl_node_t *n)
+{
+    avl_node_t *r = n->right;
+
+    n->right = r->left;
+    r->left = n;
+    avl_update_height(n);
+    avl_update_height(r);
+    return r;
+}
+
+static avl_node_t *
+avl_rotate_right(avl_node_t *n)
+{
+    avl_node_t *l = n->left;
+
+    n->left = l->right;
+    l->right = n;
+    avl_update_height(n);
+    avl_update_height(l);
+    return l;
+}
+
+/*
+ * Refresh the height of 'n', whose children are balanced, and rotate
+ * if they now differ by two. Returns the new root of the subtree.
+ */
+static avl_node_t *
+avl_balance(avl_node_t *n)
+{
+    int32_t diff = avl_height(n->left) - avl_height(n->right);
+
+    if (diff > 1) {
+        if (avl_height(n->left->left) < avl_height(n->left->right)) {
+            n->left = avl_rotate_left(n->left);
+        }
+        return avl_rotate_right(n);
+    }
+
+    if (diff < -1) {
+        if (avl_height(n->right->right) < avl_height(n->right->left)) {
+            n->right = avl_rotate_right(n->right);
+        }
+        return avl_rotate_left(n);
+    }
+
+    avl_update_height(n);
+    return n;
+}
+
+/*
+ * Rebalance the links path[depth - 1] up to path[0], stopping once a
+ * subtree comes out as tall as it went in.
+ */
+static void
+avl_rebalance_path(avl_node_t ***path, int depth)
+{
+    for (int i = depth - 1; i >= 0; i--) {
+        avl_node_t *n = *path[i];
+        int32_t old_height = n->height;
+
+        *path[i] = avl_balance(n);
+        if ((*path[i])->height == old_height) {
+            break;
+        }
+    }
+}
+
+avl_tree_t *
+create_avl_tree(void)
+{
+    avl_tree_t *t = (avl_tree_t *)malloc(sizeof(avl_tree_t));
+    if (t == NULL) {
+        goto done;
+    }
+
+    t->at_root = NULL;
+    t->at_count = 0;
+
+done:
+    return t;
+}
+
+int
+destroy_avl_tree(avl_tree_t *t)
+{
+    int error = 0;
+    avl_node_t *n = NULL;
+
+    if (t == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    /* Rotate left children up so the tree unrolls without a stack. */
+    n = t->at_root;
+    while (n) {
+        if (n->left) {
+            avl_node_t *l = n->left;
+            n->left = l->right;
+            l->right = n;
+            n = l;
+        } else {
+            avl_node_t *next = n->right;
+            node_cache_free(NODE_CACHE_AVL, n);
+            n = next;
+        }
+    }
+    free(t);
+
+done:
+    return error;
+}
+
+int
+avl_tree_insert(avl_tree_t *t, uint64_t key)
+{
+    int error = 0;
+    avl_node_t **path[AVL_MAX_HEIGHT];
+    avl_node_t **link = NULL;
+    avl_node_t *n = NULL;
+    int depth = 0;
+
+    if (t == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    link = &t->at_root;
+    while (*link) {
+        n = *link;
+        if (key == n->key) {
+            error = EEXIST;
+            goto done;
+        }
+        path[depth++] = link;
+        link = (key < n->key) ? &n->left : &n->right;
+    }
+
+    n = (avl_node_t *)node_cache_alloc(NODE_CACHE_AVL);
+    if (n == NULL) {
+        error = ENOMEM;
+        goto done;
+    }
+    n->key = key;
+    n->left = NULL;
+    n->right = NULL;
+    n->height = 1;
+
+    *link = n;
+    t->at_count++;
+    avl_rebalance_path(path, depth);
+
+done:
+    return error;
+}
+
+int
+avl_tree_delete(avl_tree_t *t, uint64_t key)
+{
+    int error = 0;
+    avl_node_t **path[AVL_MAX_HEIGHT];
+    avl_node_t **link = NULL;
+    avl_node_t *n = NULL;
+    int depth = 0;
+
+    if (t == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    link = &t->at_root;
+    while (*link && (*link)->key != key) {
+        n = *link;
+        path[depth++] = link;
+        link = (key < n->key) ? &n->left : &n->right;
+    }
+
+    n = *link;
+    if (n == NULL) {
+        error = ENOENT;
+        goto done;
+    }
+
+    if (n->left && n->right) {
+        /* Take over the successor's key and unlink the successor. */
+        avl_node_t **succ_link = &n->right;
+        avl_node_t *succ = NULL;
+
+        path[depth++] = link;
+        while ((*succ_link)->left) {
+            path[depth++] = succ_link;
+            succ_link = &(*succ_link)->left;
+        }
+        succ = *succ_link;
+        n->key = succ->key;
+        *succ_link = succ->right;
+        n = succ;
+    } else {
+        *link = n->left ? n->left : n->right;
+    }
+
+    node_cache_free(NODE_CACHE_AVL, n);
+    t->at_count--;
+    avl_rebalance_path(path, depth);
+
+done:
+    return error;
+}
+
+avl_node_t *
+avl_tree_find(avl_tree_t *t, uint64_t key)
+{
+    avl_node_t *n = t ? t->at_root : NULL;
+
+    while (n && n->key != key) {
+        n = (key < n->key) ? n->left : n->right;
+    }
+
+    return n;
+}
+
+uint64_t
+avl_tree_size(avl_tree_t *t)
+{
+    return t->at_count;
+}
+
+int32_t
+avl_tree_height(avl_tree_t *t)
+{
+    return avl_height(t->at_root);
+}
@@ -5,91 +5,247 @@
  */
 
 #include <binary_tree.h>
+#include <node_cache.h>
 #include <queue.h>
 #include <stdlib.h>
 #include <errno.h>
 #include <stdio.h>
 
-void
-in_order_traversal(bt_node *root, bt_traversalcb cb)
+/* Starting capacity of the growable queue used by breadth first walks. */
+#define BT_QUEUE_INIT_SIZE  64
+
+static int
+bt_iter_push(bt_iter_t *it, bt_node *node)
 {
-    if (NULL == root) {
-        return;
+    __builtin_prefetch(node);
+    if (dsa_stack_push(&it->stack, (uint64_t)(uintptr_t)node) != 0) {
+        it->error = ENOMEM;
     }
-
-    in_order_traversal(root->left, cb);
-    cb(root);
-    in_order_traversal(root->right, cb);
+    return it->error;
 }
 
-void
-pre_order_traversal(bt_node *root, bt_traversalcb cb)
+static int
+bt_iter_enqueue(bt_iter_t *it, bt_node *node)
 {
-    if (NULL == root) {
-        return;
+    __builtin_prefetch(node);
+    if (simple_q_enqueue_ptr(it->queue, node) < 0) {
+        it->error = ENOMEM;
     }
+    return it->error;
+}
 
-    cb(root);
-    pre_order_traversal(root->left, cb);
-    pre_order_traversal(root->right, cb);
+static bt_node *
+bt_iter_top(bt_iter_t *it)
+{
+    uint64_t top = 0;
+
+    dsa_stack_top(&it->stack, &top);
+    return (bt_node *)(uintptr_t)top;
 }
 
-void
-post_order_traversal(bt_node *root, bt_traversalcb cb)
+static bt_node *
+bt_iter_pop(bt_iter_t *it)
 {
-    if (NULL == root) {
-        return;
-    }
+    uint64_t top = 0;
 
-    post_order_traversal(root->left, cb);
-    post_order_traversal(root->right, cb);
-    cb(root);
+    dsa_stack_pop(&it->stack, &top);
+    return (bt_node *)(uintptr_t)top;
 }
 
-void
-level_order_traversal(bt_node *root, bt_traversalcb cb)
+/*
+ * Push 'it->cur' and its left spine.
+ */
+static int
+bt_iter_push_left(bt_iter_t *it)
+{
+    while (it->cur) {
+        if (bt_iter_push(it, it->cur) != 0) {
+            break;
+        }
+        it->cur = it->cur->left;
+    }
+    return it->error;
+}
+
+int
+bt_iter_begin(bt_iter_t *it, bt_node *root, bt_order_e order)
 {
     int error = 0;
-    simple_q *q = NULL;
-    const uint64_t q_max_size = 100;
-    bt_node *temp = NULL;
-    uint64_t dequeue_elem = -1;
 
-    if (NULL == root) {
+    if (it == NULL || order > BT_ORDER_LEVEL) {
+        error = EINVAL;
         goto done;
     }
 
-    q = create_simple_q(q_max_size);
-    if (q == NULL) {
+    it->order = order;
+    it->cur = NULL;
+    it->last = NULL;
+    it->queue = NULL;
+    it->error = 0;
+    dsa_stack_init(&it->stack, 0, DSA_STACK_F_GROW);
+
+    if (root == NULL) {
         goto done;
     }
 
-    temp = root;
-    while (temp != NULL) {
-        cb(temp);
-        if (temp->left) {
-            error = simple_q_enqueue(q, (uint64_t)(temp->left));
-            if (error < 0) {
-                goto done;
-            }
+    switch (order) {
+    case BT_ORDER_IN:
+    case BT_ORDER_POST:
+        it->cur = root;
+        break;
+    case BT_ORDER_PRE:
+        error = bt_iter_push(it, root);
+        break;
+    case BT_ORDER_LEVEL:
+        it->queue = create_simple_q_flags(BT_QUEUE_INIT_SIZE,
+                                          SIMPLE_Q_F_GROW);
+        if (it->queue == NULL) {
+            it->error = ENOMEM;
+            error = ENOMEM;
+            goto done;
         }
-        if (temp->right) {
-            error = simple_q_enqueue(q, (uint64_t)(temp->right));
-             if (error < 0) {
-                goto done;
+        error = bt_iter_enqueue(it, root);
+        break;
+    }
+
+done:
+    return error;
+}
+
+bt_node *
+bt_iter_next(bt_iter_t *it)
+{
+    bt_node *node = NULL;
+    void *dequeue_elem = NULL;
+
+    if (it->error) {
+        return NULL;
+    }
+
+    switch (it->order) {
+    case BT_ORDER_IN:
+        if (bt_iter_push_left(it) != 0 || dsa_stack_is_empty(&it->stack)) {
+            break;
+        }
+        node = bt_iter_pop(it);
+        it->cur = node->right;
+        break;
+
+    case BT_ORDER_PRE:
+        if (dsa_stack_is_empty(&it->stack)) {
+            break;
+        }
+        node = bt_iter_pop(it);
+        if ((node->right && bt_iter_push(it, node->right) != 0) ||
+            (node->left && bt_iter_push(it, node->left) != 0)) {
+            node = NULL;
+        }
+        break;
+
+    case BT_ORDER_POST:
+        /* A node is done once its right subtree, if any, was returned. */
+        for (;;) {
+            bt_node *top = NULL;
+
+            if (bt_iter_push_left(it) != 0 ||
+                dsa_stack_is_empty(&it->stack)) {
+                break;
+            }
+            top = bt_iter_top(it);
+            if (top->right && it->last != top->right) {
+                it->cur = top->right;
+                continue;
             }
+            node = bt_iter_pop(it);
+            it->last = node;
+            break;
         }
-        error = simple_q_dequeue(q, &dequeue_elem);
-        if (error < 0) {
-            goto done;
+        break;
+
+    case BT_ORDER_LEVEL:
+        if (it->queue == NULL ||
+            simple_q_dequeue_ptr(it->queue, &dequeue_elem) < 0) {
+            break;
         }
-        temp = (bt_node*)(dequeue_elem);
+        node = (bt_node *)dequeue_elem;
+        if ((node->left && bt_iter_enqueue(it, node->left) != 0) ||
+            (node->right && bt_iter_enqueue(it, node->right) != 0)) {
+            node = NULL;
+        }
+        break;
     }
 
+    return node;
+}
+
+void
+bt_iter_end(bt_iter_t *it)
+{
+    dsa_stack_fini(&it->stack);
+    if (it->queue) {
+        destroy_simple_q(it->queue);
+        it->queue = NULL;
+    }
+}
+
+int
+bt_traverse(bt_node *root, bt_order_e order, bt_visitcb cb, void *arg)
+{
+    int error = 0;
+    bt_iter_t it;
+    bt_node *node = NULL;
+
+    error = bt_iter_begin(&it, root, order);
+    if (error) {
+        goto done;
+    }
+
+    while ((node = bt_iter_next(&it)) != NULL) {
+        if (!cb(node, arg)) {
+            break;
+        }
+    }
+    error = it.error;
+
 done:
-    if (q) {
-        destroy_simple_q(q);
+    if (error != EINVAL) {
+        bt_iter_end(&it);
     }
+    return error;
+}
+
+/*
+ * Adapts the void callbacks of the *_traversal functions to bt_traverse.
+ */
+static bool
+bt_traversal_visit(bt_node *node, void *arg)
+{
+    (*(bt_traversalcb *)arg)(node);
+    return true;
+}
+
+void
+in_order_traversal(bt_node *root, bt_traversalcb cb)
+{
+    bt_traverse(root, BT_ORDER_IN, bt_traversal_visit, &cb);
+}
+
+void
+pre_order_traversal(bt_node *root, bt_traversalcb cb)
+{
+    bt_traverse(root, BT_ORDER_PRE, bt_traversal_visit, &cb);
+}
+
+void
+post_order_traversal(bt_node *root, bt_traversalcb cb)
+{
+    bt_traverse(root, BT_ORDER_POST, bt_traversal_visit, &cb);
+}
+
+void
+level_order_traversal(bt_node *root, bt_traversalcb cb)
+{
+    bt_traverse(root, BT_ORDER_LEVEL, bt_traversal_visit, &cb);
 }
 
 void
@@ -97,27 +253,26 @@ level_order_traversal_with_height(bt_node *root, bt_traversalcb cb)
 {
     int error = 0;
     simple_q *q = NULL;
-    const uint64_t q_max_size = 100;
     bt_node *temp = NULL;
-    uint64_t dequeue_elem = -1;
+    void *dequeue_elem = NULL;
     int level_length = 0;
 
     if (NULL == root) {
         goto done;
     }
 
-    q = create_simple_q(q_max_size);
+    q = create_simple_q_flags(BT_QUEUE_INIT_SIZE, SIMPLE_Q_F_GROW);
     if (q == NULL) {
         goto done;
     }
 
-    simple_q_enqueue(q, (uint64_t)(root));
+    simple_q_enqueue_ptr(q, root);
 
     while (!simple_q_is_empty(q)) {
         level_length = q->curr_size;
 
         while (level_length > 0) {
-            if (simple_q_dequeue(q, &dequeue_elem) == -1) {
+            if (simple_q_dequeue_ptr(q, &dequeue_elem) == -1) {
                 goto done;
             }
             --level_length;
@@ -126,10 +281,10 @@ level_order_traversal_with_height(bt_node *root, bt_traversalcb cb)
 			cb(temp);
 
             if (temp->left) {
-                simple_q_enqueue(q, (uint64_t)(temp->left));
+                simple_q_enqueue_ptr(q, temp->left);
             }
             if (temp->right) {
-                simple_q_enqueue(q, (uint64_t)(temp->right));
+                simple_q_enqueue_ptr(q, temp->right);
             }
         }
         printf(": ");
@@ -146,7 +301,7 @@ done:
 static bt_node*
 alloc_bt_node(uint64_t key)
 {
-    bt_node *node = (bt_node *)malloc(sizeof(bt_node));
+    bt_node *node = (bt_node *)node_cache_alloc(NODE_CACHE_BT);
     if (node == NULL) {
         goto done;
     }
@@ -164,7 +319,7 @@ free_bt_node(bt_node *node)
 {
     if (node) {
         node->key = 0;
-        free(node);
+        node_cache_free(NODE_CACHE_BT, node);
     }
 }
 
@@ -173,9 +328,8 @@ insert_bt_node(bt_node **root, bt_node *node)
 {
     int error = 0;
     simple_q *q = NULL;
-    const uint64_t q_max_size = 100;
     bt_node *temp = NULL;
-    uint64_t dequeue_elem = -1;
+    void *dequeue_elem = NULL;
 
     if (root == NULL || node == NULL) {
         error = EINVAL;
@@ -189,7 +343,7 @@ insert_bt_node(bt_node **root, bt_node *node)
     }
 
 
-    q = create_simple_q(q_max_size);
+    q = create_simple_q_flags(BT_QUEUE_INIT_SIZE, SIMPLE_Q_F_GROW);
     if (q == NULL) {
         error = ENOMEM;
         goto done;
@@ -205,17 +359,17 @@ insert_bt_node(bt_node **root, bt_node *node)
             temp->right = node;
             goto done;
         } else {
-            error = simple_q_enqueue(q, (uint64_t)(temp->left));
+            error = simple_q_enqueue_ptr(q, temp->left);
             if (error < 0) {
                 error = EFAULT;
                 goto done;
             }
-            error = simple_q_enqueue(q, (uint64_t)(temp->right));
+            error = simple_q_enqueue_ptr(q, temp->right);
              if (error < 0) {
                  error = EFAULT;
                 goto done;
             }
-            error = simple_q_dequeue(q, &dequeue_elem);
+            error = simple_q_dequeue_ptr(q, &dequeue_elem);
             if (error < 0) {
                 error = EFAULT;
                 goto done;
@@ -253,11 +407,10 @@ delete_from_bt(bt_node **root, uint64_t key)
 {
     int error = 0;
     simple_q *q = NULL;
-    const uint64_t q_max_size = 100;
     bt_node *temp = NULL;
     bt_node *del_node = NULL;
     bt_node *last_node = NULL;
-    uint64_t dequeue_elem = -1;
+    void *dequeue_elem = NULL;
     bool free_node = false;
 
     if (root == NULL) {
@@ -275,13 +428,13 @@ delete_from_bt(bt_node **root, uint64_t key)
     if (((*root)->key == key) &&
         ((*root)->left == NULL) &&
         ((*root)->right == NULL)) {
-        free(*root);
+        free_bt_node(*root);
         *root = NULL;
         goto done;
     }
 
 
-    q = create_simple_q(q_max_size);
+    q = create_simple_q_flags(BT_QUEUE_INIT_SIZE, SIMPLE_Q_F_GROW);
     if (q == NULL) {
         error = ENOMEM;
         goto done;
@@ -298,7 +451,7 @@ delete_from_bt(bt_node **root, uint64_t key)
         }
 
         if (temp->left) {
-            error = simple_q_enqueue(q, (uint64_t)(temp->left));
+            error = simple_q_enqueue_ptr(q, temp->left);
             if (error < 0) {
                 error = EFAULT;
                 goto done;
@@ -306,14 +459,14 @@ delete_from_bt(bt_node **root, uint64_t key)
         }
 
         if (temp->right) {
-            error = simple_q_enqueue(q, (uint64_t)(temp->right));
+            error = simple_q_enqueue_ptr(q, temp->right);
             if (error < 0) {
                 error = EFAULT;
                 goto done;
             }
         }
 
-        error = simple_q_dequeue(q, &dequeue_elem);
+        error = simple_q_dequeue_ptr(q, &dequeue_elem);
         if (error < 0) {
             error = EFAULT;
             break;
@@ -337,7 +490,7 @@ delete_from_bt(bt_node **root, uint64_t key)
             free_node = true;
             goto done;
         } else {
-            error = simple_q_enqueue(q, (uint64_t)(temp->left));
+            error = simple_q_enqueue_ptr(q, temp->left);
             if (error < 0) {
                 error = EFAULT;
                 goto done;
@@ -349,14 +502,14 @@ delete_from_bt(bt_node **root, uint64_t key)
             free_node = true;
             goto done;
         } else {
-            error = simple_q_enqueue(q, (uint64_t)(temp->right));
+            error = simple_q_enqueue_ptr(q, temp->right);
             if (error < 0) {
                 error = EFAULT;
                 goto done;
             }
         }
 
-        error = simple_q_dequeue(q, &dequeue_elem);
+        error = simple_q_dequeue_ptr(q, &dequeue_elem);
         if (error < 0) {
             error = EFAULT;
             goto done;
@@ -377,18 +530,13 @@ done:
 bt_node *
 insert_to_bst(bt_node **root, uint64_t key)
 {
-    bt_node *new_node = alloc_bt_node(key);
-    if (new_node == NULL) {
-        goto done;
-    }
-
     if (root == NULL) {
         goto done;
     }
 
-
+    /* Allocate only where the key lands, not at every level on the way. */
     if (*root == NULL) {
-        *root = new_node;
+        *root = alloc_bt_node(key);
         goto done;
     }
 
@@ -483,3 +631,186 @@ delete_from_bst(bt_node **root, uint64_t key)
 done:
     return (*root);
 }
+
+/*
+ * Shape the nodes into a perfectly balanced BST over 'keys', where
+ * 'nodes[i]' is node i in level order. Visiting nodes in level order
+ * means both children of a node are linked before it is reached, so each
+ * one's key range is parked in its own child pointers until then.
+ */
+static void
+bst_link_level_order(bt_node **nodes, const uint64_t *keys, uint64_t n)
+{
+    uint64_t next = 1;
+
+    nodes[0]->left = (bt_node *)(uintptr_t)0;
+    nodes[0]->right = (bt_node *)(uintptr_t)n;
+
+    for (uint64_t i = 0; i < n; i++) {
+        bt_node *node = nodes[i];
+        uint64_t lo = (uint64_t)(uintptr_t)node->left;
+        uint64_t hi = (uint64_t)(uintptr_t)node->right;
+        uint64_t mid = lo + (hi - lo) / 2;
+
+        node->key = keys[mid];
+        node->left = NULL;
+        node->right = NULL;
+
+        if (lo < mid) {
+            node->left = nodes[next++];
+            node->left->left = (bt_node *)(uintptr_t)lo;
+            node->left->right = (bt_node *)(uintptr_t)mid;
+        }
+        if (mid + 1 < hi) {
+            node->right = nodes[next++];
+            node->right->left = (bt_node *)(uintptr_t)(mid + 1);
+            node->right->right = (bt_node *)(uintptr_t)hi;
+        }
+    }
+}
+
+bt_node *
+bst_build_from_sorted(const uint64_t *keys, uint64_t n)
+{
+    bt_node **nodes = NULL;
+    bt_node *root = NULL;
+    uint64_t i = 0;
+
+    if (keys == NULL || n == 0 || n > SIZE_MAX / sizeof(bt_node *)) {
+        goto done;
+    }
+
+    for (i = 1; i < n; i++) {
+        if (keys[i - 1] > keys[i]) {
+            goto done;
+        }
+    }
+
+    nodes = (bt_node **)malloc(n * sizeof(bt_node *));
+    if (nodes == NULL) {
+        goto done;
+    }
+
+    /* Allocated in level order, the order lookups first touch them. */
+    for (i = 0; i < n; i++) {
+        nodes[i] = alloc_bt_node(0);
+        if (nodes[i] == NULL) {
+            while (i-- > 0) {
+                free_bt_node(nodes[i]);
+            }
+            goto done;
+        }
+    }
+
+    bst_link_level_order(nodes, keys, n);
+    root = nodes[0];
+
+done:
+    free(nodes);
+    return root;
+}
+
+int
+destroy_bt(bt_node **root)
+{
+    int error = 0;
+    bt_node *node = NULL;
+    bt_node *left = NULL;
+
+    if (root == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    /*
+     * Rotate left children up until the node has none, then free it and
+     * carry on down the right, so no stack or queue is needed.
+     */
+    node = *root;
+    while (node) {
+        if (node->left) {
+            left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        } else {
+            left = node->right;
+            free_bt_node(node);
+            node = left;
+        }
+    }
+    *root = NULL;
+
+done:
+    return error;
+}
+
+int
+bst_rebalance(bt_node **root)
+{
+    int error = 0;
+    uint64_t *keys = NULL;
+    bt_node **nodes = NULL;
+    bt_node *node = NULL;
+    uint64_t n = 0;
+    uint64_t cap = BT_QUEUE_INIT_SIZE;
+    bt_iter_t it;
+
+    if (root == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (*root == NULL) {
+        goto done;
+    }
+
+    /* Keys in order; the walk also sizes the arrays. */
+    keys = (uint64_t *)malloc(cap * sizeof(uint64_t));
+    if (keys == NULL) {
+        error = ENOMEM;
+        goto done;
+    }
+    bt_iter_begin(&it, *root, BT_ORDER_IN);
+    while ((node = bt_iter_next(&it)) != NULL) {
+        if (n == cap) {
+            uint64_t *grown = (uint64_t *)realloc(keys,
+                                                  2 * cap * sizeof(uint64_t));
+            if (grown == NULL) {
+                break;
+            }
+            keys = grown;
+            cap *= 2;
+        }
+        keys[n++] = node->key;
+    }
+    error = (node || it.error) ? ENOMEM : 0;
+    bt_iter_end(&it);
+    if (error) {
+        goto done;
+    }
+
+    /* Nodes in their current level order, so the root comes first. */
+    nodes = (bt_node **)malloc(n * sizeof(bt_node *));
+    if (nodes == NULL) {
+        error = ENOMEM;
+        goto done;
+    }
+    n = 0;
+    bt_iter_begin(&it, *root, BT_ORDER_LEVEL);
+    while ((node = bt_iter_next(&it)) != NULL) {
+        nodes[n++] = node;
+    }
+    error = it.error;
+    bt_iter_end(&it);
+    if (error) {
+        goto done;
+    }
+
+    bst_link_level_order(nodes, keys, n);
+
+done:
+    free(keys);
+    free(nodes);
+    return error;
+}
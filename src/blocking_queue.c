@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Blocking Producer/Consumer Queue Implementation.
+ */
+
+#include <blocking_queue.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static int64_t
+bq_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+#ifdef __linux__
+
+static void
+bq_futex_wait(blocking_q *q, _Atomic uint32_t *word, uint32_t val,
+              const struct timespec *rel)
+{
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, val, rel, NULL, 0);
+}
+
+static void
+bq_futex_wake(blocking_q *q, _Atomic uint32_t *word, int n)
+{
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, n, NULL, NULL, 0);
+}
+
+#else
+
+/*
+ * Same contract as the futex calls: sleep only while *word == val, and
+ * wake sleepers after *word has been changed.
+ */
+static void
+bq_futex_wait(blocking_q *q, _Atomic uint32_t *word, uint32_t val,
+              const struct timespec *rel)
+{
+    struct timespec abs;
+
+    pthread_mutex_lock(&q->bq_wait_lock);
+    if (atomic_load(word) == val) {
+        if (rel) {
+            clock_gettime(CLOCK_REALTIME, &abs);
+            abs.tv_sec += rel->tv_sec;
+            abs.tv_nsec += rel->tv_nsec;
+            if (abs.tv_nsec >= 1000000000L) {
+                abs.tv_sec++;
+                abs.tv_nsec -= 1000000000L;
+            }
+            pthread_cond_timedwait(&q->bq_wait_cond, &q->bq_wait_lock, &abs);
+        } else {
+            pthread_cond_wait(&q->bq_wait_cond, &q->bq_wait_lock);
+        }
+    }
+    pthread_mutex_unlock(&q->bq_wait_lock);
+}
+
+static void
+bq_futex_wake(blocking_q *q, _Atomic uint32_t *word, int n)
+{
+    pthread_mutex_lock(&q->bq_wait_lock);
+    pthread_cond_broadcast(&q->bq_wait_cond);
+    pthread_mutex_unlock(&q->bq_wait_lock);
+}
+
+#endif
+
+static bool
+bq_has_items(blocking_q *q)
+{
+    return (atomic_load(&q->bq_count) > 0 || atomic_load(&q->bq_closed));
+}
+
+static bool
+bq_has_space(blocking_q *q)
+{
+    if (q->bq_q->flags & SIMPLE_Q_F_GROW) {
+        return true;
+    }
+
+    return (atomic_load(&q->bq_count) < q->bq_q->max_size ||
+            atomic_load(&q->bq_closed));
+}
+
+/*
+ * Spin on 'ready' for a while, then sleep on 'word' until woken or
+ * until 'deadline' (a negative deadline means none). The waiter count
+ * is raised before the final check of 'ready'; the other side updates
+ * bq_count before reading the count, so one of the two always sees the
+ * other and no wakeup is lost.
+ */
+static void
+bq_wait(blocking_q *q, _Atomic uint32_t *word, _Atomic uint32_t *waiters,
+        bool (*ready)(blocking_q *), int64_t deadline)
+{
+    struct timespec rel;
+    uint32_t seq = 0;
+
+    for (int i = 0; i < BLOCKING_Q_SPIN_COUNT; i++) {
+        if (ready(q)) {
+            return;
+        }
+    }
+
+    seq = atomic_load(word);
+    atomic_fetch_add(waiters, 1);
+
+    if (!ready(q)) {
+        if (deadline < 0) {
+            bq_futex_wait(q, word, seq, NULL);
+        } else {
+            int64_t left = deadline - bq_now_ns();
+            if (left > 0) {
+                rel.tv_sec = left / 1000000000LL;
+                rel.tv_nsec = left % 1000000000LL;
+                bq_futex_wait(q, word, seq, &rel);
+            }
+        }
+    }
+
+    atomic_fetch_sub(waiters, 1);
+}
+
+/*
+ * Wake up to 'n' threads sleeping on 'word', skipping the syscall when
+ * nobody is asleep.
+ */
+static void
+bq_wake(blocking_q *q, _Atomic uint32_t *word, _Atomic uint32_t *waiters,
+        uint64_t n)
+{
+    if (atomic_load(waiters) == 0) {
+        return;
+    }
+
+    atomic_fetch_add(word, 1);
+    bq_futex_wake(q, word, (n > INT_MAX) ? INT_MAX : (int)n);
+}
+
+blocking_q *
+create_blocking_q(uint64_t size, uint32_t flags)
+{
+    blocking_q *q = NULL;
+
+    q = (blocking_q *)malloc(sizeof(blocking_q));
+    if (q == NULL) {
+        goto done;
+    }
+
+    q->bq_q = create_simple_q_flags(size, flags);
+    if (q->bq_q == NULL) {
+        free(q);
+        q = NULL;
+        goto done;
+    }
+
+    pthread_mutex_init(&q->bq_lock, NULL);
+    atomic_init(&q->bq_count, 0);
+    atomic_init(&q->bq_items_seq, 0);
+    atomic_init(&q->bq_space_seq, 0);
+    atomic_init(&q->bq_consumers_waiting, 0);
+    atomic_init(&q->bq_producers_waiting, 0);
+    atomic_init(&q->bq_closed, false);
+#ifndef __linux__
+    pthread_mutex_init(&q->bq_wait_lock, NULL);
+    pthread_cond_init(&q->bq_wait_cond, NULL);
+#endif
+
+done:
+    return q;
+}
+
+int
+destroy_blocking_q(blocking_q *q)
+{
+    int error = 0;
+
+    if (q == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    destroy_simple_q(q->bq_q);
+    pthread_mutex_destroy(&q->bq_lock);
+#ifndef __linux__
+    pthread_mutex_destroy(&q->bq_wait_lock);
+    pthread_cond_destroy(&q->bq_wait_cond);
+#endif
+    free(q);
+
+done:
+    return error;
+}
+
+int
+blocking_q_enqueue_batch(blocking_q *q, const uint64_t *keys, uint64_t n)
+{
+    int error = 0;
+    uint64_t done = 0;
+
+    if (q == NULL || (keys == NULL && n != 0)) {
+        error = EINVAL;
+        goto done;
+    }
+
+    while (done < n) {
+        uint64_t pushed = 0;
+
+        pthread_mutex_lock(&q->bq_lock);
+        if (atomic_load(&q->bq_closed)) {
+            pthread_mutex_unlock(&q->bq_lock);
+            error = EPIPE;
+            goto done;
+        }
+        while (done + pushed < n &&
+               simple_q_enqueue(q->bq_q, keys[done + pushed]) == 0) {
+            pushed++;
+        }
+        atomic_store(&q->bq_count, q->bq_q->curr_size);
+        pthread_mutex_unlock(&q->bq_lock);
+
+        if (pushed) {
+            done += pushed;
+            bq_wake(q, &q->bq_items_seq, &q->bq_consumers_waiting, pushed);
+            continue;
+        }
+
+        bq_wait(q, &q->bq_space_seq, &q->bq_producers_waiting,
+                bq_has_space, -1);
+    }
+
+done:
+    return error;
+}
+
+int
+blocking_q_enqueue(blocking_q *q, uint64_t key)
+{
+    return blocking_q_enqueue_batch(q, &key, 1);
+}
+
+int
+blocking_q_dequeue_batch(blocking_q *q, uint64_t *out, uint64_t max,
+                         uint64_t *got, int64_t timeout_ns)
+{
+    int error = 0;
+    int64_t deadline = -1;
+    uint64_t popped = 0;
+
+    if (q == NULL || out == NULL || max == 0) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (timeout_ns >= 0) {
+        deadline = bq_now_ns() + timeout_ns;
+    }
+
+    for (;;) {
+        bool closed = false;
+
+        pthread_mutex_lock(&q->bq_lock);
+        while (popped < max && simple_q_dequeue(q->bq_q, &out[popped]) == 0) {
+            popped++;
+        }
+        atomic_store(&q->bq_count, q->bq_q->curr_size);
+        closed = atomic_load(&q->bq_closed);
+        pthread_mutex_unlock(&q->bq_lock);
+
+        if (popped) {
+            bq_wake(q, &q->bq_space_seq, &q->bq_producers_waiting, popped);
+            goto done;
+        }
+
+        /* Nothing can be enqueued after close, so empty means drained. */
+        if (closed) {
+            error = EPIPE;
+            goto done;
+        }
+
+        if (deadline >= 0 && bq_now_ns() >= deadline) {
+            error = ETIMEDOUT;
+            goto done;
+        }
+
+        bq_wait(q, &q->bq_items_seq, &q->bq_consumers_waiting,
+                bq_has_items, deadline);
+    }
+
+done:
+    if (got) {
+        *got = popped;
+    }
+    return error;
+}
+
+int
+blocking_q_dequeue(blocking_q *q, uint64_t *out, int64_t timeout_ns)
+{
+    return blocking_q_dequeue_batch(q, out, 1, NULL, timeout_ns);
+}
+
+int
+blocking_q_close(blocking_q *q)
+{
+    int error = 0;
+
+    if (q == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    pthread_mutex_lock(&q->bq_lock);
+    atomic_store(&q->bq_closed, true);
+    pthread_mutex_unlock(&q->bq_lock);
+
+    bq_wake(q, &q->bq_items_seq, &q->bq_consumers_waiting, INT_MAX);
+    bq_wake(q, &q->bq_space_seq, &q->bq_producers_waiting, INT_MAX);
+
+done:
+    return error;
+}
@@ -0,0 +1,802 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * B+tree Implementation.
+ */
+
+#include <bptree.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+_Static_assert(sizeof(bptree_leaf_t) <= BPTREE_NODE_SIZE,
+               "bptree_leaf_t must fit in a node");
+_Static_assert(sizeof(bptree_inner_t) <= BPTREE_NODE_SIZE,
+               "bptree_inner_t must fit in a node");
+_Static_assert(BPTREE_KEY_SLOTS % 4 == 0 &&
+               BPTREE_KEY_SLOTS >= BPTREE_MAX_KEYS,
+               "key slots are searched four at a time");
+
+static pthread_once_t bptree_once = PTHREAD_ONCE_INIT;
+static bool bptree_have_avx2;
+
+static void
+bptree_detect_cpu(void)
+{
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    bptree_have_avx2 = __builtin_cpu_supports("avx2");
+#endif
+}
+
+static uint32_t
+bptree_rank_scalar(const uint64_t *keys, uint64_t key)
+{
+    uint32_t n = 0;
+
+    for (int i = 0; i < BPTREE_KEY_SLOTS; i++) {
+        n += (keys[i] < key);
+    }
+    return n;
+}
+
+#if defined(__x86_64__)
+/*
+ * AVX2 only has a signed 64 bit compare, so flip the sign bits of both
+ * sides first. Each lane that compares true is -1; subtracting them
+ * from an accumulator counts them.
+ */
+__attribute__((target("avx2")))
+static uint32_t
+bptree_rank_avx2(const uint64_t *keys, uint64_t key)
+{
+    const __m256i bias = _mm256_set1_epi64x((long long)(1ULL << 63));
+    __m256i k = _mm256_xor_si256(_mm256_set1_epi64x((long long)key), bias);
+    __m256i acc = _mm256_setzero_si256();
+    __m128i sum;
+
+    for (int i = 0; i < BPTREE_KEY_SLOTS; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)&keys[i]);
+
+        v = _mm256_xor_si256(v, bias);
+        acc = _mm256_sub_epi64(acc, _mm256_cmpgt_epi64(k, v));
+    }
+
+    sum = _mm_add_epi64(_mm256_castsi256_si128(acc),
+                        _mm256_extracti128_si256(acc, 1));
+    sum = _mm_add_epi64(sum, _mm_unpackhi_epi64(sum, sum));
+    return (uint32_t)_mm_cvtsi128_si64(sum);
+}
+#endif
+
+/*
+ * Number of keys in 'keys' below 'key'. Unused slots hold UINT64_MAX
+ * and are never below anything.
+ */
+static inline uint32_t
+bptree_rank(const uint64_t *keys, uint64_t key)
+{
+#if defined(__x86_64__)
+    if (bptree_have_avx2) {
+        return bptree_rank_avx2(keys, key);
+    }
+#endif
+    return bptree_rank_scalar(keys, key);
+}
+
+/*
+ * Index of the child of 'in' whose range holds 'key'.
+ */
+static inline uint32_t
+bptree_child_index(bptree_inner_t *in, uint64_t key)
+{
+    if (key == UINT64_MAX) {
+        return in->bi_hdr.bh_count;
+    }
+    return bptree_rank(in->bi_keys, key + 1);
+}
+
+static bptree_leaf_t *
+bptree_new_leaf(void)
+{
+    bptree_leaf_t *l = NULL;
+
+    if (posix_memalign((void **)&l, BPTREE_CACHE_LINE,
+                       BPTREE_NODE_SIZE) != 0) {
+        return NULL;
+    }
+
+    l->bl_hdr.bh_count = 0;
+    l->bl_hdr.bh_level = 0;
+    l->bl_next = NULL;
+    for (int i = 0; i < BPTREE_KEY_SLOTS; i++) {
+        l->bl_keys[i] = UINT64_MAX;
+    }
+    return l;
+}
+
+static bptree_inner_t *
+bptree_new_inner(uint32_t level)
+{
+    bptree_inner_t *in = NULL;
+
+    if (posix_memalign((void **)&in, BPTREE_CACHE_LINE,
+                       BPTREE_NODE_SIZE) != 0) {
+        return NULL;
+    }
+
+    in->bi_hdr.bh_count = 0;
+    in->bi_hdr.bh_level = level;
+    for (int i = 0; i < BPTREE_KEY_SLOTS; i++) {
+        in->bi_keys[i] = UINT64_MAX;
+    }
+    return in;
+}
+
+/*
+ * Recursion is bounded by the height of the tree.
+ */
+static void
+bptree_free_subtree(bptree_hdr_t *n)
+{
+    if (n->bh_level > 0) {
+        bptree_inner_t *in = (bptree_inner_t *)n;
+
+        for (uint32_t i = 0; i <= in->bi_hdr.bh_count; i++) {
+            bptree_free_subtree(in->bi_children[i]);
+        }
+    }
+    free(n);
+}
+
+bptree_t *
+create_bptree(void)
+{
+    bptree_t *t = NULL;
+
+    pthread_once(&bptree_once, bptree_detect_cpu);
+
+    t = (bptree_t *)malloc(sizeof(bptree_t));
+    if (t == NULL) {
+        goto done;
+    }
+
+    t->bp_root = NULL;
+    t->bp_first = NULL;
+    t->bp_count = 0;
+
+done:
+    return t;
+}
+
+int
+destroy_bptree(bptree_t *t)
+{
+    int error = 0;
+
+    if (t == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (t->bp_root) {
+        bptree_free_subtree(t->bp_root);
+    }
+    free(t);
+
+done:
+    return error;
+}
+
+static bptree_leaf_t *
+bptree_find_leaf(bptree_t *t, uint64_t key)
+{
+    bptree_hdr_t *n = t->bp_root;
+
+    while (n && n->bh_level > 0) {
+        bptree_inner_t *in = (bptree_inner_t *)n;
+
+        n = in->bi_children[bptree_child_index(in, key)];
+    }
+
+    return (bptree_leaf_t *)n;
+}
+
+int
+bptree_find(bptree_t *t, uint64_t key, uint64_t *value)
+{
+    bptree_leaf_t *leaf = NULL;
+    uint32_t pos = 0;
+
+    if (t == NULL) {
+        return EINVAL;
+    }
+
+    leaf = bptree_find_leaf(t, key);
+    if (leaf == NULL) {
+        return ENOENT;
+    }
+
+    pos = bptree_rank(leaf->bl_keys, key);
+    if (pos >= leaf->bl_hdr.bh_count || leaf->bl_keys[pos] != key) {
+        return ENOENT;
+    }
+
+    if (value) {
+        *value = leaf->bl_values[pos];
+    }
+    return 0;
+}
+
+static void
+bptree_leaf_insert_at(bptree_leaf_t *l, uint32_t pos, uint64_t key,
+                      uint64_t value)
+{
+    uint32_t count = l->bl_hdr.bh_count;
+
+    memmove(&l->bl_keys[pos + 1], &l->bl_keys[pos],
+            (count - pos) * sizeof(uint64_t));
+    memmove(&l->bl_values[pos + 1], &l->bl_values[pos],
+            (count - pos) * sizeof(uint64_t));
+    l->bl_keys[pos] = key;
+    l->bl_values[pos] = value;
+    l->bl_hdr.bh_count = count + 1;
+}
+
+/*
+ * Insert separator 'key' at 'pos' with 'child' to its right.
+ */
+static void
+bptree_inner_insert_at(bptree_inner_t *in, uint32_t pos, uint64_t key,
+                       bptree_hdr_t *child)
+{
+    uint32_t count = in->bi_hdr.bh_count;
+
+    memmove(&in->bi_keys[pos + 1], &in->bi_keys[pos],
+            (count - pos) * sizeof(uint64_t));
+    memmove(&in->bi_children[pos + 2], &in->bi_children[pos + 1],
+            (count - pos) * sizeof(bptree_hdr_t *));
+    in->bi_keys[pos] = key;
+    in->bi_children[pos + 1] = child;
+    in->bi_hdr.bh_count = count + 1;
+}
+
+/*
+ * Insert into the full leaf 'l' and move the upper half of the result
+ * to the empty leaf 'r'. Returns the separator for 'r'.
+ */
+static uint64_t
+bptree_leaf_split(bptree_leaf_t *l, bptree_leaf_t *r, uint32_t pos,
+                  uint64_t key, uint64_t value)
+{
+    uint64_t keys[BPTREE_MAX_KEYS + 1];
+    uint64_t values[BPTREE_MAX_KEYS + 1];
+    uint32_t total = BPTREE_MAX_KEYS + 1;
+    uint32_t left = total - total / 2;
+
+    memcpy(keys, l->bl_keys, pos * sizeof(uint64_t));
+    memcpy(values, l->bl_values, pos * sizeof(uint64_t));
+    keys[pos] = key;
+    values[pos] = value;
+    memcpy(&keys[pos + 1], &l->bl_keys[pos],
+           (BPTREE_MAX_KEYS - pos) * sizeof(uint64_t));
+    memcpy(&values[pos + 1], &l->bl_values[pos],
+           (BPTREE_MAX_KEYS - pos) * sizeof(uint64_t));
+
+    memcpy(l->bl_keys, keys, left * sizeof(uint64_t));
+    memcpy(l->bl_values, values, left * sizeof(uint64_t));
+    for (uint32_t i = left; i < BPTREE_MAX_KEYS; i++) {
+        l->bl_keys[i] = UINT64_MAX;
+    }
+    l->bl_hdr.bh_count = left;
+
+    memcpy(r->bl_keys, &keys[left], (total - left) * sizeof(uint64_t));
+    memcpy(r->bl_values, &values[left], (total - left) * sizeof(uint64_t));
+    r->bl_hdr.bh_count = total - left;
+
+    r->bl_next = l->bl_next;
+    l->bl_next = r;
+    return r->bl_keys[0];
+}
+
+/*
+ * Insert separator 'key' and 'child' into the full inner node 'l' and
+ * move the upper half to the empty node 'r'. The middle separator moves
+ * up rather than into either half; it is returned.
+ */
+static uint64_t
+bptree_inner_split(bptree_inner_t *l, bptree_inner_t *r, uint32_t pos,
+                   uint64_t key, bptree_hdr_t *child)
+{
+    uint64_t keys[BPTREE_MAX_KEYS + 1];
+    bptree_hdr_t *children[BPTREE_MAX_KEYS + 2];
+    uint32_t total = BPTREE_MAX_KEYS + 1;
+    uint32_t left = total / 2;
+    uint32_t right = total - left - 1;
+
+    memcpy(keys, l->bi_keys, pos * sizeof(uint64_t));
+    keys[pos] = key;
+    memcpy(&keys[pos + 1], &l->bi_keys[pos],
+           (BPTREE_MAX_KEYS - pos) * sizeof(uint64_t));
+    memcpy(children, l->bi_children, (pos + 1) * sizeof(bptree_hdr_t *));
+    children[pos + 1] = child;
+    memcpy(&children[pos + 2], &l->bi_children[pos + 1],
+           (BPTREE_MAX_KEYS - pos) * sizeof(bptree_hdr_t *));
+
+    memcpy(l->bi_keys, keys, left * sizeof(uint64_t));
+    memcpy(l->bi_children, children, (left + 1) * sizeof(bptree_hdr_t *));
+    for (uint32_t i = left; i < BPTREE_MAX_KEYS; i++) {
+        l->bi_keys[i] = UINT64_MAX;
+    }
+    l->bi_hdr.bh_count = left;
+
+    memcpy(r->bi_keys, &keys[left + 1], right * sizeof(uint64_t));
+    memcpy(r->bi_children, &children[left + 1],
+           (right + 1) * sizeof(bptree_hdr_t *));
+    r->bi_hdr.bh_count = right;
+
+    return keys[left];
+}
+
+int
+bptree_insert(bptree_t *t, uint64_t key, uint64_t value)
+{
+    int error = 0;
+    bptree_inner_t *path[BPTREE_MAX_DEPTH];
+    uint32_t index[BPTREE_MAX_DEPTH];
+    void *spare[BPTREE_MAX_DEPTH + 1];
+    int num_spare = 0;
+    int needed = 0;
+    int depth = 0;
+    bptree_hdr_t *n = NULL;
+    bptree_hdr_t *child = NULL;
+    bptree_leaf_t *leaf = NULL;
+    uint64_t sep = 0;
+    uint32_t pos = 0;
+
+    if (t == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (t->bp_root == NULL) {
+        leaf = bptree_new_leaf();
+        if (leaf == NULL) {
+            error = ENOMEM;
+            goto done;
+        }
+        t->bp_root = &leaf->bl_hdr;
+        t->bp_first = leaf;
+    }
+
+    n = t->bp_root;
+    while (n->bh_level > 0) {
+        bptree_inner_t *in = (bptree_inner_t *)n;
+
+        path[depth] = in;
+        index[depth] = bptree_child_index(in, key);
+        n = in->bi_children[index[depth]];
+        depth++;
+    }
+    leaf = (bptree_leaf_t *)n;
+
+    pos = bptree_rank(leaf->bl_keys, key);
+    if (pos < leaf->bl_hdr.bh_count && leaf->bl_keys[pos] == key) {
+        error = EEXIST;
+        goto done;
+    }
+
+    if (leaf->bl_hdr.bh_count < BPTREE_MAX_KEYS) {
+        bptree_leaf_insert_at(leaf, pos, key, value);
+        t->bp_count++;
+        goto done;
+    }
+
+    /*
+     * Allocate every node the split will need before changing anything:
+     * one per full node from the leaf up, and a new root if they all are.
+     */
+    needed = 1;
+    while (needed <= depth &&
+           path[depth - needed]->bi_hdr.bh_count == BPTREE_MAX_KEYS) {
+        needed++;
+    }
+    if (needed > depth) {
+        needed++;
+    }
+    for (num_spare = 0; num_spare < needed; num_spare++) {
+        if (posix_memalign(&spare[num_spare], BPTREE_CACHE_LINE,
+                           BPTREE_NODE_SIZE) != 0) {
+            while (num_spare > 0) {
+                free(spare[--num_spare]);
+            }
+            error = ENOMEM;
+            goto done;
+        }
+    }
+
+    {
+        bptree_leaf_t *right = (bptree_leaf_t *)spare[--num_spare];
+
+        right->bl_hdr.bh_level = 0;
+        for (int i = 0; i < BPTREE_KEY_SLOTS; i++) {
+            right->bl_keys[i] = UINT64_MAX;
+        }
+        sep = bptree_leaf_split(leaf, right, pos, key, value);
+        child = &right->bl_hdr;
+    }
+    t->bp_count++;
+
+    while (depth > 0) {
+        bptree_inner_t *in = path[--depth];
+        bptree_inner_t *right = NULL;
+
+        if (in->bi_hdr.bh_count < BPTREE_MAX_KEYS) {
+            bptree_inner_insert_at(in, index[depth], sep, child);
+            goto done;
+        }
+
+        right = (bptree_inner_t *)spare[--num_spare];
+        right->bi_hdr.bh_level = in->bi_hdr.bh_level;
+        for (int i = 0; i < BPTREE_KEY_SLOTS; i++) {
+            right->bi_keys[i] = UINT64_MAX;
+        }
+        sep = bptree_inner_split(in, right, index[depth], sep, child);
+        child = &right->bi_hdr;
+    }
+
+    {
+        bptree_inner_t *root = (bptree_inner_t *)spare[--num_spare];
+
+        root->bi_hdr.bh_level = t->bp_root->bh_level + 1;
+        for (int i = 0; i < BPTREE_KEY_SLOTS; i++) {
+            root->bi_keys[i] = UINT64_MAX;
+        }
+        root->bi_keys[0] = sep;
+        root->bi_children[0] = t->bp_root;
+        root->bi_children[1] = child;
+        root->bi_hdr.bh_count = 1;
+        t->bp_root = &root->bi_hdr;
+    }
+
+done:
+    return error;
+}
+
+/*
+ * Fix up the underfull child at 'index' of 'parent' together with a
+ * neighbour: merge the two if they fit in one node, else share their
+ * keys evenly. Returns true if they were merged, which takes a key out
+ * of 'parent'.
+ */
+static bool
+bptree_rebalance(bptree_inner_t *parent, uint32_t index)
+{
+    uint32_t li = (index > 0) ? index - 1 : index;
+    bptree_hdr_t *lh = parent->bi_children[li];
+    bptree_hdr_t *rh = parent->bi_children[li + 1];
+    uint32_t lc = lh->bh_count;
+    uint32_t rc = rh->bh_count;
+
+    if (lh->bh_level == 0) {
+        bptree_leaf_t *l = (bptree_leaf_t *)lh;
+        bptree_leaf_t *r = (bptree_leaf_t *)rh;
+        uint64_t keys[2 * BPTREE_MAX_KEYS];
+        uint64_t values[2 * BPTREE_MAX_KEYS];
+        uint32_t total = lc + rc;
+        uint32_t left = total / 2;
+
+        if (total <= BPTREE_MAX_KEYS) {
+            memcpy(&l->bl_keys[lc], r->bl_keys, rc * sizeof(uint64_t));
+            memcpy(&l->bl_values[lc], r->bl_values, rc * sizeof(uint64_t));
+            l->bl_hdr.bh_count = total;
+            l->bl_next = r->bl_next;
+            free(r);
+            goto merged;
+        }
+
+        memcpy(keys, l->bl_keys, lc * sizeof(uint64_t));
+        memcpy(&keys[lc], r->bl_keys, rc * sizeof(uint64_t));
+        memcpy(values, l->bl_values, lc * sizeof(uint64_t));
+        memcpy(&values[lc], r->bl_values, rc * sizeof(uint64_t));
+
+        for (uint32_t i = 0; i < BPTREE_MAX_KEYS; i++) {
+            l->bl_keys[i] = (i < left) ? keys[i] : UINT64_MAX;
+            r->bl_keys[i] = (i < total - left) ? keys[left + i] : UINT64_MAX;
+        }
+        memcpy(l->bl_values, values, left * sizeof(uint64_t));
+        memcpy(r->bl_values, &values[left], (total - left) * sizeof(uint64_t));
+        l->bl_hdr.bh_count = left;
+        r->bl_hdr.bh_count = total - left;
+        parent->bi_keys[li] = r->bl_keys[0];
+    } else {
+        bptree_inner_t *l = (bptree_inner_t *)lh;
+        bptree_inner_t *r = (bptree_inner_t *)rh;
+        uint64_t keys[2 * BPTREE_MAX_KEYS + 1];
+        bptree_hdr_t *children[2 * BPTREE_MAX_KEYS + 2];
+        uint32_t total = lc + rc + 1;
+        uint32_t left = total / 2;
+
+        if (total <= BPTREE_MAX_KEYS) {
+            l->bi_keys[lc] = parent->bi_keys[li];
+            memcpy(&l->bi_keys[lc + 1], r->bi_keys, rc * sizeof(uint64_t));
+            memcpy(&l->bi_children[lc + 1], r->bi_children,
+                   (rc + 1) * sizeof(bptree_hdr_t *));
+            l->bi_hdr.bh_count = total;
+            free(r);
+            goto merged;
+        }
+
+        memcpy(keys, l->bi_keys, lc * sizeof(uint64_t));
+        keys[lc] = parent->bi_keys[li];
+        memcpy(&keys[lc + 1], r->bi_keys, rc * sizeof(uint64_t));
+        memcpy(children, l->bi_children, (lc + 1) * sizeof(bptree_hdr_t *));
+        memcpy(&children[lc + 1], r->bi_children,
+               (rc + 1) * sizeof(bptree_hdr_t *));
+
+        /* keys[left] moves up; total - left - 1 keys go right. */
+        for (uint32_t i = 0; i < BPTREE_MAX_KEYS; i++) {
+            l->bi_keys[i] = (i < left) ? keys[i] : UINT64_MAX;
+            r->bi_keys[i] = (i < total - left - 1) ? keys[left + 1 + i] :
+                                                     UINT64_MAX;
+        }
+        memcpy(l->bi_children, children, (left + 1) * sizeof(bptree_hdr_t *));
+        memcpy(r->bi_children, &children[left + 1],
+               (total - left) * sizeof(bptree_hdr_t *));
+        l->bi_hdr.bh_count = left;
+        r->bi_hdr.bh_count = total - left - 1;
+        parent->bi_keys[li] = keys[left];
+    }
+
+    return false;
+
+merged:
+    /* Drop separator li and the right child. */
+    memmove(&parent->bi_keys[li], &parent->bi_keys[li + 1],
+            (parent->bi_hdr.bh_count - li - 1) * sizeof(uint64_t));
+    memmove(&parent->bi_children[li + 1], &parent->bi_children[li + 2],
+            (parent->bi_hdr.bh_count - li - 1) * sizeof(bptree_hdr_t *));
+    parent->bi_hdr.bh_count--;
+    parent->bi_keys[parent->bi_hdr.bh_count] = UINT64_MAX;
+    return true;
+}
+
+int
+bptree_delete(bptree_t *t, uint64_t key)
+{
+    int error = 0;
+    bptree_inner_t *path[BPTREE_MAX_DEPTH];
+    uint32_t index[BPTREE_MAX_DEPTH];
+    int depth = 0;
+    bptree_hdr_t *n = NULL;
+    bptree_leaf_t *leaf = NULL;
+    uint32_t pos = 0;
+    uint32_t count = 0;
+
+    if (t == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    n = t->bp_root;
+    if (n == NULL) {
+        error = ENOENT;
+        goto done;
+    }
+    while (n->bh_level > 0) {
+        bptree_inner_t *in = (bptree_inner_t *)n;
+
+        path[depth] = in;
+        index[depth] = bptree_child_index(in, key);
+        n = in->bi_children[index[depth]];
+        depth++;
+    }
+    leaf = (bptree_leaf_t *)n;
+
+    pos = bptree_rank(leaf->bl_keys, key);
+    count = leaf->bl_hdr.bh_count;
+    if (pos >= count || leaf->bl_keys[pos] != key) {
+        error = ENOENT;
+        goto done;
+    }
+
+    memmove(&leaf->bl_keys[pos], &leaf->bl_keys[pos + 1],
+            (count - pos - 1) * sizeof(uint64_t));
+    memmove(&leaf->bl_values[pos], &leaf->bl_values[pos + 1],
+            (count - pos - 1) * sizeof(uint64_t));
+    leaf->bl_keys[count - 1] = UINT64_MAX;
+    leaf->bl_hdr.bh_count = count - 1;
+    t->bp_count--;
+
+    while (depth > 0 && n->bh_count < BPTREE_MIN_KEYS) {
+        depth--;
+        if (!bptree_rebalance(path[depth], index[depth])) {
+            break;
+        }
+        n = &path[depth]->bi_hdr;
+    }
+
+    /* Shrink the root once it is empty. */
+    n = t->bp_root;
+    if (n->bh_count == 0) {
+        if (n->bh_level == 0) {
+            t->bp_root = NULL;
+            t->bp_first = NULL;
+        } else {
+            t->bp_root = ((bptree_inner_t *)n)->bi_children[0];
+        }
+        free(n);
+    }
+
+done:
+    return error;
+}
+
+int
+bptree_bulk_load(bptree_t *t, const uint64_t *keys, const uint64_t *values,
+                 uint64_t n)
+{
+    int error = 0;
+    bptree_hdr_t **nodes = NULL;
+    uint64_t *lows = NULL;
+    bptree_leaf_t *prev = NULL;
+    uint64_t m = 0;
+    uint64_t built = 0;
+    uint64_t next = 0;
+    uint32_t level = 1;
+
+    if (t == NULL || t->bp_root != NULL || (keys == NULL && n != 0)) {
+        error = EINVAL;
+        goto done;
+    }
+
+    for (uint64_t i = 1; i < n; i++) {
+        if (keys[i - 1] >= keys[i]) {
+            error = EINVAL;
+            goto done;
+        }
+    }
+
+    if (n == 0) {
+        goto done;
+    }
+
+    /* Spread the keys evenly so no leaf ends up below the minimum. */
+    m = (n + BPTREE_MAX_KEYS - 1) / BPTREE_MAX_KEYS;
+    nodes = (bptree_hdr_t **)malloc(m * sizeof(bptree_hdr_t *));
+    lows = (uint64_t *)malloc(m * sizeof(uint64_t));
+    if (nodes == NULL || lows == NULL) {
+        error = ENOMEM;
+        goto done;
+    }
+
+    next = m;
+    for (uint64_t i = 0, k = 0; i < m; i++) {
+        uint32_t c = (uint32_t)(n / m + (i < n % m));
+        bptree_leaf_t *leaf = bptree_new_leaf();
+
+        if (leaf == NULL) {
+            error = ENOMEM;
+            goto cleanup;
+        }
+
+        memcpy(leaf->bl_keys, &keys[k], c * sizeof(uint64_t));
+        for (uint32_t j = 0; j < c; j++) {
+            leaf->bl_values[j] = values ? values[k + j] : keys[k + j];
+        }
+        leaf->bl_hdr.bh_count = c;
+        if (prev) {
+            prev->bl_next = leaf;
+        }
+        prev = leaf;
+
+        nodes[i] = &leaf->bl_hdr;
+        lows[i] = keys[k];
+        built++;
+        k += c;
+    }
+
+    /* Build each level over the one below, in place in 'nodes'. */
+    while (m > 1) {
+        uint64_t pm = (m + BPTREE_MAX_KEYS) / (BPTREE_MAX_KEYS + 1);
+
+        built = 0;
+        next = 0;
+        for (uint64_t j = 0; j < pm; j++) {
+            uint32_t c = (uint32_t)(m / pm + (j < m % pm));
+            bptree_inner_t *in = bptree_new_inner(level);
+
+            if (in == NULL) {
+                error = ENOMEM;
+                goto cleanup;
+            }
+
+            for (uint32_t i = 0; i < c; i++) {
+                in->bi_children[i] = nodes[next + i];
+                if (i > 0) {
+                    in->bi_keys[i - 1] = lows[next + i];
+                }
+            }
+            in->bi_hdr.bh_count = c - 1;
+
+            lows[j] = lows[next];
+            nodes[j] = &in->bi_hdr;
+            built++;
+            next += c;
+        }
+
+        m = pm;
+        level++;
+    }
+
+    t->bp_root = nodes[0];
+    t->bp_first = (bptree_leaf_t *)t->bp_root;
+    while (t->bp_first->bl_hdr.bh_level > 0) {
+        t->bp_first = (bptree_leaf_t *)
+                      ((bptree_inner_t *)t->bp_first)->bi_children[0];
+    }
+    t->bp_count = n;
+    goto done;
+
+cleanup:
+    /* Free the finished nodes of this level and the rest of the last. */
+    for (uint64_t i = 0; i < built; i++) {
+        bptree_free_subtree(nodes[i]);
+    }
+    for (uint64_t i = next; i < m; i++) {
+        bptree_free_subtree(nodes[i]);
+    }
+
+done:
+    free(nodes);
+    free(lows);
+    return error;
+}
+
+void
+bptree_seek(bptree_t *t, uint64_t key, bptree_cursor_t *c)
+{
+    bptree_leaf_t *leaf = t ? bptree_find_leaf(t, key) : NULL;
+
+    c->bc_leaf = leaf;
+    c->bc_pos = leaf ? bptree_rank(leaf->bl_keys, key) : 0;
+}
+
+bool
+bptree_next(bptree_cursor_t *c, uint64_t *key, uint64_t *value)
+{
+    while (c->bc_leaf && c->bc_pos >= c->bc_leaf->bl_hdr.bh_count) {
+        c->bc_leaf = c->bc_leaf->bl_next;
+        c->bc_pos = 0;
+    }
+
+    if (c->bc_leaf == NULL) {
+        return false;
+    }
+
+    if (key) {
+        *key = c->bc_leaf->bl_keys[c->bc_pos];
+    }
+    if (value) {
+        *value = c->bc_leaf->bl_values[c->bc_pos];
+    }
+    c->bc_pos++;
+    return true;
+}
+
+uint64_t
+bptree_size(bptree_t *t)
+{
+    return t->bp_count;
+}
+
+uint32_t
+bptree_height(bptree_t *t)
+{
+    return t->bp_root ? t->bp_root->bh_level + 1 : 0;
+}
@@ -13,6 +13,25 @@
 #include <queue.h>
 #include <Stack.h>
 
+/*
+ * Per call scratch arrays come from the caller's arena when there is
+ * one; the arena is reset to its entry mark on return, so only the
+ * malloc path needs an explicit free.
+ */
+static void *
+graph_scratch_alloc(arena_t *arena, size_t size)
+{
+    return arena ? arena_alloc(arena, size) : malloc(size);
+}
+
+static void
+graph_scratch_free(arena_t *arena, void *p)
+{
+    if (arena == NULL) {
+        free(p);
+    }
+}
+
 graph_t *
 create_graph(uint64_t num_vertices, bool is_directed)
 {
@@ -307,19 +326,20 @@ graph_dfs_connected(graph_t *g, graph_vertex_t *start,
                     bool *has_cycle, graphtraversalcb cb)
 {
     int error = 0;
-    dsa_stack_t *st = NULL;
-    uint64_t num_vertices = g->num_vertices;
+    dsa_stack_t stack;
+    dsa_stack_t *st = &stack;
     graph_vertex_t *parent = NULL;
     graph_vertex_t *curr_vertex = start;
 
-    st = create_dsa_stack(num_vertices);
-    if (st == NULL) {
-        error = ENOMEM;
+    // Every edge to an unvisited vertex pushes an entry, so the stack
+    // can get far deeper than the vertex count; let it grow.
+    dsa_stack_init(st, 0, DSA_STACK_F_GROW);
+
+    error = dsa_stack_push(st, (uint64_t)(curr_vertex));
+    if (error) {
         goto done;
     }
 
-    dsa_stack_push(st, (uint64_t)(curr_vertex));
-
     while (!dsa_stack_is_empty(st)) {
 
         uint64_t temp = 0;
@@ -345,7 +365,10 @@ graph_dfs_connected(graph_t *g, graph_vertex_t *start,
         while (curr_edge != NULL) {
             graph_vertex_t *v = curr_edge->dst;
             if (!visited[v->idx]) {
-                dsa_stack_push(st, (uint64_t)(curr_edge->dst));
+                error = dsa_stack_push(st, (uint64_t)(curr_edge->dst));
+                if (error) {
+                    goto done;
+                }
             } else {
                 // Parent tracking based logic for
                 // undirected graphs.
@@ -371,9 +394,7 @@ graph_dfs_connected(graph_t *g, graph_vertex_t *start,
     }
 
 done:
-    if (st) {
-        destroy_dsa_stack(st);
-    }
+    dsa_stack_fini(st);
 
     return error;
 }
@@ -389,12 +410,24 @@ reset_callstack(bool *callstack, uint64_t numvertices)
 int
 graph_dfs(graph_t *g, uint64_t start_vertex, bool *has_cycle,
           graphtraversalcb cb)
+{
+    return graph_dfs_arena(g, start_vertex, has_cycle, cb, NULL);
+}
+
+int
+graph_dfs_arena(graph_t *g, uint64_t start_vertex, bool *has_cycle,
+                graphtraversalcb cb, arena_t *arena)
 {
     int error = 0;
     bool *visited = NULL;
     bool *incallstack = NULL;
     uint64_t num_vertices = 0;
     graph_vertex_t *start = NULL;
+    arena_mark_t mark = {0};
+
+    if (arena) {
+        mark = arena_mark(arena);
+    }
 
     if (g == NULL) {
         error = EINVAL;
@@ -408,13 +441,14 @@ graph_dfs(graph_t *g, uint64_t start_vertex, bool *has_cycle,
         goto done;
     }
 
-    visited = (bool *)malloc(sizeof(bool) * num_vertices);
+    visited = (bool *)graph_scratch_alloc(arena, sizeof(bool) * num_vertices);
     if (visited == NULL) {
         error = ENOMEM;
         goto done;
     }
 
-    incallstack = (bool *)malloc(sizeof(bool) * num_vertices);
+    incallstack = (bool *)graph_scratch_alloc(arena,
+                                              sizeof(bool) * num_vertices);
     if (incallstack == NULL) {
         error = ENOMEM;
         goto done;
@@ -452,14 +486,10 @@ graph_dfs(graph_t *g, uint64_t start_vertex, bool *has_cycle,
     }
 
 done:
-
-    if (incallstack) {
-        free(incallstack);
-    }
-
-
-    if (visited) {
-        free(visited);
+    graph_scratch_free(arena, incallstack);
+    graph_scratch_free(arena, visited);
+    if (arena) {
+        arena_release(arena, mark);
     }
 
     return error;
@@ -534,11 +564,23 @@ done:
 
 int
 graph_bfs(graph_t *g, uint64_t start_vertex, graphtraversalcb cb)
+{
+    return graph_bfs_arena(g, start_vertex, cb, NULL);
+}
+
+int
+graph_bfs_arena(graph_t *g, uint64_t start_vertex, graphtraversalcb cb,
+                arena_t *arena)
 {
     int error = 0;
     bool *visited = NULL;
     uint64_t num_vertices = 0;
     graph_vertex_t *start = NULL;
+    arena_mark_t mark = {0};
+
+    if (arena) {
+        mark = arena_mark(arena);
+    }
 
     if (g == NULL) {
         error = EINVAL;
@@ -552,7 +594,7 @@ graph_bfs(graph_t *g, uint64_t start_vertex, graphtraversalcb cb)
         goto done;
     }
 
-    visited = (bool *)malloc(sizeof(bool) * num_vertices);
+    visited = (bool *)graph_scratch_alloc(arena, sizeof(bool) * num_vertices);
     if (visited == NULL) {
         error = ENOMEM;
         goto done;
@@ -586,8 +628,9 @@ graph_bfs(graph_t *g, uint64_t start_vertex, graphtraversalcb cb)
     }
 
 done:
-    if (visited) {
-        free(visited);
+    graph_scratch_free(arena, visited);
+    if (arena) {
+        arena_release(arena, mark);
     }
     return error;
 }
@@ -683,6 +726,13 @@ print_shortest_path_info(graph_vertex_t *start, graph_vertex_t *end,
 
 int
 shortest_path_dijkstra(graph_t *g, uint64_t src, uint64_t dst)
+{
+    return shortest_path_dijkstra_arena(g, src, dst, NULL);
+}
+
+int
+shortest_path_dijkstra_arena(graph_t *g, uint64_t src, uint64_t dst,
+                             arena_t *arena)
 {
     int error = 0;
     uint64_t num_vertices = 0;
@@ -691,6 +741,11 @@ shortest_path_dijkstra(graph_t *g, uint64_t src, uint64_t dst)
     int64_t *dist = NULL;
     uint64_t *parents = NULL;
     bool *visited = NULL;
+    arena_mark_t mark = {0};
+
+    if (arena) {
+        mark = arena_mark(arena);
+    }
 
     if (g == NULL) {
         error = EINVAL;
@@ -711,19 +766,21 @@ shortest_path_dijkstra(graph_t *g, uint64_t src, uint64_t dst)
     }
 
 
-    dist = (int64_t *)malloc(sizeof(int64_t) * num_vertices);
+    dist = (int64_t *)graph_scratch_alloc(arena,
+                                          sizeof(int64_t) * num_vertices);
     if (dist == NULL) {
         error = ENOMEM;
         goto done;
     }
 
-    parents = (uint64_t *)malloc(sizeof(uint64_t) * num_vertices);
+    parents = (uint64_t *)graph_scratch_alloc(arena,
+                                              sizeof(uint64_t) * num_vertices);
     if (parents == NULL) {
         error = ENOMEM;
         goto done;
     }
 
-    visited = (bool *)malloc(sizeof(bool) * num_vertices);
+    visited = (bool *)graph_scratch_alloc(arena, sizeof(bool) * num_vertices);
     if (visited == NULL) {
         error = ENOMEM;
         goto done;
@@ -767,17 +824,11 @@ shortest_path_dijkstra(graph_t *g, uint64_t src, uint64_t dst)
     print_shortest_path_info(start, end, dist, parents, num_vertices);
 
 done:
-
-    if (visited) {
-        free(visited);
-    }
-
-    if (parents) {
-        free(parents);
-    }
-
-    if (dist) {
-        free(dist);
+    graph_scratch_free(arena, visited);
+    graph_scratch_free(arena, parents);
+    graph_scratch_free(arena, dist);
+    if (arena) {
+        arena_release(arena, mark);
     }
 
     return error;
@@ -785,15 +836,29 @@ done:
 
 int
 shortest_path_undirected(graph_t *g, uint64_t src, uint64_t dst)
+{
+    return shortest_path_undirected_arena(g, src, dst, NULL);
+}
+
+int
+shortest_path_undirected_arena(graph_t *g, uint64_t src, uint64_t dst,
+                               arena_t *arena)
 {
     int error = 0;
     bool *visited = NULL;
     int64_t *dist = NULL;
     uint64_t *parents = NULL;
     uint64_t num_vertices = 0;
-    simple_q *q = NULL;
+    graph_vertex_t **q = NULL;
+    uint64_t q_head = 0;
+    uint64_t q_tail = 0;
     graph_vertex_t *start = NULL;
     graph_vertex_t *end = NULL;
+    arena_mark_t mark = {0};
+
+    if (arena) {
+        mark = arena_mark(arena);
+    }
 
     if (g == NULL) {
         error = EINVAL;
@@ -813,19 +878,21 @@ shortest_path_undirected(graph_t *g, uint64_t src, uint64_t dst)
         goto done;
     }
 
-    visited = (bool *)malloc(sizeof(bool) * num_vertices);
+    visited = (bool *)graph_scratch_alloc(arena, sizeof(bool) * num_vertices);
     if (visited == NULL) {
         error = ENOMEM;
         goto done;
     }
 
-    dist = (int64_t *)malloc(sizeof(int64_t) * num_vertices);
+    dist = (int64_t *)graph_scratch_alloc(arena,
+                                          sizeof(int64_t) * num_vertices);
     if (dist == NULL) {
         error = ENOMEM;
         goto done;
     }
 
-    parents = (uint64_t *)malloc(sizeof(uint64_t) * num_vertices);
+    parents = (uint64_t *)graph_scratch_alloc(arena,
+                                              sizeof(uint64_t) * num_vertices);
     if (parents == NULL) {
         error = ENOMEM;
         goto done;
@@ -837,7 +904,14 @@ shortest_path_undirected(graph_t *g, uint64_t src, uint64_t dst)
         parents[i] = UINT64_MAX;
     }
 
-    q = create_simple_q(num_vertices);
+    /*
+     * A vertex is queued only when first marked visited, and the start
+     * vertex (not marked) at most once more, so a flat array of
+     * num_vertices + 1 entries is enough for the queue.
+     */
+    q = (graph_vertex_t **)graph_scratch_alloc(arena,
+                                               sizeof(graph_vertex_t *) *
+                                               (num_vertices + 1));
     if (q == NULL) {
         error = ENOMEM;
         goto done;
@@ -845,15 +919,11 @@ shortest_path_undirected(graph_t *g, uint64_t src, uint64_t dst)
 
     dist[start->idx] = 0;
     parents[start->idx] = 0;
-    simple_q_enqueue(q, (uint64_t)(start));
+    q[q_tail++] = start;
 
-    while (!simple_q_is_empty(q)) {
-        graph_vertex_t *v = NULL;
+    while (q_head < q_tail) {
+        graph_vertex_t *v = q[q_head++];
         graph_edge_t *e = NULL;
-        uint64_t temp = 0;
-
-        simple_q_dequeue(q, &temp);
-        v = (graph_vertex_t *)(temp);
 
         e = v->edges;
         while (e != NULL) {
@@ -861,7 +931,7 @@ shortest_path_undirected(graph_t *g, uint64_t src, uint64_t dst)
                 visited[e->dst->idx] = true;
                 parents[e->dst->idx] = v->key;
                 dist[e->dst->idx] = dist[v->idx] + 1;
-                simple_q_enqueue(q, (uint64_t)(e->dst));
+                q[q_tail++] = e->dst;
             }
             e = e->edge_next;
         }
@@ -870,20 +940,12 @@ shortest_path_undirected(graph_t *g, uint64_t src, uint64_t dst)
     print_shortest_path_info(start, end, dist, parents, num_vertices);
 
 done:
-    if (q) {
-        destroy_simple_q(q);
-    }
-
-    if (parents) {
-        free(parents);
-    }
-
-    if (dist) {
-        free(dist);
-    }
-
-    if (visited) {
-        free(visited);
+    graph_scratch_free(arena, q);
+    graph_scratch_free(arena, parents);
+    graph_scratch_free(arena, dist);
+    graph_scratch_free(arena, visited);
+    if (arena) {
+        arena_release(arena, mark);
     }
     return error;
 }
@@ -916,6 +978,13 @@ relax_all_edges(graph_t *g, int64_t *dist, uint64_t *parents)
 
 int
 shortest_path_bellmanford(graph_t *g, uint64_t src, uint64_t dst)
+{
+    return shortest_path_bellmanford_arena(g, src, dst, NULL);
+}
+
+int
+shortest_path_bellmanford_arena(graph_t *g, uint64_t src, uint64_t dst,
+                                arena_t *arena)
 {
     int error = 0;
     int64_t *dist = NULL;
@@ -924,6 +993,11 @@ shortest_path_bellmanford(graph_t *g, uint64_t src, uint64_t dst)
     graph_vertex_t *start = NULL;
     graph_vertex_t *end = NULL;
     uint64_t relax = 0;
+    arena_mark_t mark = {0};
+
+    if (arena) {
+        mark = arena_mark(arena);
+    }
 
     if (g == NULL) {
         error = EINVAL;
@@ -944,13 +1018,15 @@ shortest_path_bellmanford(graph_t *g, uint64_t src, uint64_t dst)
         goto done;
     }
 
-    dist = (int64_t *)malloc(sizeof(int64_t) * num_vertices);
+    dist = (int64_t *)graph_scratch_alloc(arena,
+                                          sizeof(int64_t) * num_vertices);
     if (dist == NULL) {
         error = ENOMEM;
         goto done;
     }
 
-    parents = (uint64_t *)malloc(sizeof(uint64_t) * num_vertices);
+    parents = (uint64_t *)graph_scratch_alloc(arena,
+                                              sizeof(uint64_t) * num_vertices);
     if (parents == NULL) {
         error = ENOMEM;
         goto done;
@@ -978,12 +1054,10 @@ shortest_path_bellmanford(graph_t *g, uint64_t src, uint64_t dst)
     print_shortest_path_info(start, end, dist, parents, num_vertices);
 
 done:
-    if (parents) {
-        free(parents);
-    }
-
-    if (dist) {
-        free(dist);
+    graph_scratch_free(arena, parents);
+    graph_scratch_free(arena, dist);
+    if (arena) {
+        arena_release(arena, mark);
     }
 
     return error;
@@ -9,6 +9,9 @@
 #include <stdbool.h>
 #include <errno.h>
 #include <stdio.h>
+#include <string.h>
+
+#define HEAP_MIN_GROW_CAPACITY 16
 
 static bool
 is_heap_full(heap_t * h)
@@ -143,7 +146,7 @@ done:
 }
 
 heap_t*
-create_heap(heap_type_e type, uint64_t size)
+create_heap_flags(heap_type_e type, uint64_t size, uint32_t flags)
 {
     heap_t *new_heap = NULL;
 
@@ -153,7 +156,7 @@ create_heap(heap_type_e type, uint64_t size)
     }
 
     new_heap->h_arr = (heap_elem_t *)malloc(size * sizeof(heap_elem_t));
-    if (new_heap->h_arr == NULL) {
+    if (new_heap->h_arr == NULL && size != 0) {
         free(new_heap);
         new_heap = NULL;
         goto done;
@@ -162,11 +165,80 @@ create_heap(heap_type_e type, uint64_t size)
     new_heap->h_type = type;
     new_heap->h_capacity = size;
     new_heap->h_curr_size = 0;
+    new_heap->h_min_capacity = size;
+    new_heap->h_flags = flags;
 
 done:
     return new_heap;
 }
 
+heap_t*
+create_heap(heap_type_e type, uint64_t size)
+{
+    return create_heap_flags(type, size, 0);
+}
+
+static int
+heap_resize(heap_t *h, uint64_t capacity)
+{
+    heap_elem_t *arr = NULL;
+
+    arr = (heap_elem_t *)realloc(h->h_arr, capacity * sizeof(heap_elem_t));
+    if (arr == NULL) {
+        return ENOMEM;
+    }
+
+    h->h_arr = arr;
+    h->h_capacity = capacity;
+    return 0;
+}
+
+/*
+ * Make room for 'n' more elements, growing geometrically if allowed.
+ */
+static int
+heap_reserve(heap_t *h, uint64_t n)
+{
+    uint64_t needed = h->h_curr_size + n;
+    uint64_t capacity = h->h_capacity;
+
+    if (needed <= capacity) {
+        return 0;
+    }
+
+    if (!(h->h_flags & HEAP_F_GROW)) {
+        return EFAULT;
+    }
+
+    if (capacity < HEAP_MIN_GROW_CAPACITY) {
+        capacity = HEAP_MIN_GROW_CAPACITY;
+    }
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+
+    return heap_resize(h, capacity);
+}
+
+static void
+heap_maybe_shrink(heap_t *h)
+{
+    uint64_t capacity = h->h_capacity / 2;
+
+    if (!(h->h_flags & HEAP_F_SHRINK)) {
+        return;
+    }
+
+    if (h->h_curr_size > h->h_capacity / 4 ||
+        capacity < h->h_min_capacity ||
+        capacity < HEAP_MIN_GROW_CAPACITY) {
+        return;
+    }
+
+    /* A failed shrink just leaves the larger array in place. */
+    heap_resize(h, capacity);
+}
+
 int
 destroy_heap(heap_t *h)
 {
@@ -183,8 +255,10 @@ insert_heap(heap_t *h, heap_elem_t *elem)
     int index = h->h_curr_size;
 
     if (is_heap_full(h)) {
-        error = EFAULT;
-        goto done;
+        error = heap_reserve(h, 1);
+        if (error) {
+            goto done;
+        }
     }
 
     h->h_arr[index] = *elem;
@@ -238,6 +312,102 @@ done:
     return error;
 }
 
+int
+heap_build_from_array(heap_t *h, heap_elem_t *arr, uint64_t n)
+{
+    int error = 0;
+
+    if (h == NULL || (arr == NULL && n != 0)) {
+        error = EINVAL;
+        goto done;
+    }
+
+    error = heap_reserve(h, n);
+    if (error) {
+        goto done;
+    }
+
+    memcpy(&h->h_arr[h->h_curr_size], arr, n * sizeof(heap_elem_t));
+    h->h_curr_size += n;
+
+    /* Floyd: sift down every internal node, last parent first. */
+    for (uint64_t i = h->h_curr_size / 2; i > 0; i--) {
+        heapify(h, i - 1);
+    }
+
+done:
+    return error;
+}
+
+int
+heap_push_batch(heap_t *h, heap_elem_t *arr, uint64_t n)
+{
+    int error = 0;
+
+    if (h == NULL || (arr == NULL && n != 0)) {
+        error = EINVAL;
+        goto done;
+    }
+
+    /*
+     * A rebuild costs O(size + n) while inserts cost O(n log size), so
+     * rebuild once the batch is comparable to what is already there.
+     */
+    if (n >= h->h_curr_size) {
+        error = heap_build_from_array(h, arr, n);
+        goto done;
+    }
+
+    error = heap_reserve(h, n);
+    if (error) {
+        goto done;
+    }
+
+    for (uint64_t i = 0; i < n; i++) {
+        error = insert_heap(h, &arr[i]);
+        if (error) {
+            goto done;
+        }
+    }
+
+done:
+    return error;
+}
+
+int
+heap_pop_batch(heap_t *h, heap_elem_t *out, uint64_t n, uint64_t *popped)
+{
+    int error = 0;
+    uint64_t count = 0;
+
+    if (h == NULL || out == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    while (count < n && !is_heap_empty(h)) {
+        out[count++] = h->h_arr[0];
+        h->h_arr[0] = h->h_arr[h->h_curr_size - 1];
+        h->h_curr_size--;
+        if (!is_heap_empty(h)) {
+            heapify(h, 0);
+        }
+    }
+
+    /*
+     * Only here, where the roots have been copied out. delete_min and
+     * delete_max hand back a pointer into h_arr, which a shrink in
+     * delete_heap would free.
+     */
+    heap_maybe_shrink(h);
+
+done:
+    if (popped) {
+        *popped = count;
+    }
+    return error;
+}
+
 heap_elem_t*
 get_min(heap_t *h)
 {
@@ -273,6 +443,28 @@ delete_max(heap_t *h, heap_elem_t **max)
     return delete_heap(h, *max);
 }
 
+int
+heap_replace_top(heap_t *h, heap_elem_t *elem)
+{
+    int error = 0;
+
+    if (h == NULL || elem == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (is_heap_empty(h)) {
+        error = EFAULT;
+        goto done;
+    }
+
+    h->h_arr[0] = *elem;
+    heapify(h, 0);
+
+done:
+    return error;
+}
+
 void
 print_heap(heap_t *h)
 {
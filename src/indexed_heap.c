@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Indexed Heap Data Structure Operations Implementation.
+ */
+
+#include <indexed_heap.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <stdio.h>
+
+/*
+ * True when 'a' belongs above 'b' for this heap type.
+ */
+static bool
+idx_heap_before(idx_heap_t *h, uint64_t a, uint64_t b)
+{
+    return (h->ih_type == MIN_HEAP) ? (a < b) : (a > b);
+}
+
+static void
+idx_heap_place(idx_heap_t *h, uint64_t index, idx_heap_elem_t *elem)
+{
+    h->ih_arr[index] = *elem;
+    h->ih_pos[elem->id] = index;
+}
+
+/*
+ * Sift helpers move a hole rather than swapping, so each level costs one
+ * element copy and one position update.
+ */
+static void
+idx_heap_sift_up(idx_heap_t *h, uint64_t index)
+{
+    idx_heap_elem_t elem = h->ih_arr[index];
+
+    while (index > 0) {
+        uint64_t parent = (index - 1) / 2;
+        if (!idx_heap_before(h, elem.priority, h->ih_arr[parent].priority)) {
+            break;
+        }
+        idx_heap_place(h, index, &h->ih_arr[parent]);
+        index = parent;
+    }
+
+    idx_heap_place(h, index, &elem);
+}
+
+static void
+idx_heap_sift_down(idx_heap_t *h, uint64_t index)
+{
+    idx_heap_elem_t elem = h->ih_arr[index];
+    uint64_t size = h->ih_curr_size;
+
+    while (true) {
+        uint64_t child = 2 * index + 1;
+        if (child >= size) {
+            break;
+        }
+        if ((child + 1 < size) &&
+            idx_heap_before(h, h->ih_arr[child + 1].priority,
+                            h->ih_arr[child].priority)) {
+            child++;
+        }
+        if (!idx_heap_before(h, h->ih_arr[child].priority, elem.priority)) {
+            break;
+        }
+        idx_heap_place(h, index, &h->ih_arr[child]);
+        index = child;
+    }
+
+    idx_heap_place(h, index, &elem);
+}
+
+idx_heap_t *
+create_idx_heap(heap_type_e type, uint64_t max_ids)
+{
+    idx_heap_t *h = NULL;
+
+    if (max_ids == 0) {
+        goto done;
+    }
+
+    h = (idx_heap_t *)malloc(sizeof(idx_heap_t));
+    if (h == NULL) {
+        goto done;
+    }
+
+    h->ih_arr = (idx_heap_elem_t *)malloc(max_ids * sizeof(idx_heap_elem_t));
+    h->ih_pos = (uint64_t *)malloc(max_ids * sizeof(uint64_t));
+    if (h->ih_arr == NULL || h->ih_pos == NULL) {
+        free(h->ih_arr);
+        free(h->ih_pos);
+        free(h);
+        h = NULL;
+        goto done;
+    }
+
+    for (uint64_t i = 0; i < max_ids; i++) {
+        h->ih_pos[i] = IDX_HEAP_NPOS;
+    }
+
+    h->ih_type = type;
+    h->ih_max_ids = max_ids;
+    h->ih_curr_size = 0;
+
+done:
+    return h;
+}
+
+int
+destroy_idx_heap(idx_heap_t *h)
+{
+    int error = 0;
+
+    if (h == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    free(h->ih_pos);
+    free(h->ih_arr);
+    free(h);
+
+done:
+    return error;
+}
+
+bool
+idx_heap_contains(idx_heap_t *h, uint64_t id)
+{
+    return (id < h->ih_max_ids) && (h->ih_pos[id] != IDX_HEAP_NPOS);
+}
+
+bool
+idx_heap_is_empty(idx_heap_t *h)
+{
+    return (h->ih_curr_size == 0);
+}
+
+int
+idx_heap_insert(idx_heap_t *h, uint64_t id, uint64_t priority, void *payload)
+{
+    int error = 0;
+    idx_heap_elem_t elem = {0};
+
+    if (h == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (id >= h->ih_max_ids) {
+        error = ERANGE;
+        goto done;
+    }
+
+    if (h->ih_pos[id] != IDX_HEAP_NPOS) {
+        error = EEXIST;
+        goto done;
+    }
+
+    elem.priority = priority;
+    elem.id = id;
+    elem.payload = payload;
+
+    idx_heap_place(h, h->ih_curr_size, &elem);
+    h->ih_curr_size++;
+    idx_heap_sift_up(h, h->ih_curr_size - 1);
+
+done:
+    return error;
+}
+
+int
+idx_heap_peek(idx_heap_t *h, idx_heap_elem_t *top)
+{
+    int error = 0;
+
+    if (h == NULL || top == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (idx_heap_is_empty(h)) {
+        error = ENOENT;
+        goto done;
+    }
+
+    *top = h->ih_arr[0];
+
+done:
+    return error;
+}
+
+/*
+ * Remove the entry at 'index' by moving the last entry into its slot and
+ * sifting that entry whichever way restores the heap property.
+ */
+static void
+idx_heap_remove_at(idx_heap_t *h, uint64_t index, idx_heap_elem_t *elem)
+{
+    idx_heap_elem_t removed = h->ih_arr[index];
+    uint64_t last = h->ih_curr_size - 1;
+
+    h->ih_pos[removed.id] = IDX_HEAP_NPOS;
+    h->ih_curr_size--;
+
+    if (index != last) {
+        idx_heap_place(h, index, &h->ih_arr[last]);
+        if (index > 0 &&
+            idx_heap_before(h, h->ih_arr[index].priority,
+                            h->ih_arr[(index - 1) / 2].priority)) {
+            idx_heap_sift_up(h, index);
+        } else {
+            idx_heap_sift_down(h, index);
+        }
+    }
+
+    if (elem) {
+        *elem = removed;
+    }
+}
+
+int
+idx_heap_pop(idx_heap_t *h, idx_heap_elem_t *top)
+{
+    int error = 0;
+
+    if (h == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (idx_heap_is_empty(h)) {
+        error = ENOENT;
+        goto done;
+    }
+
+    idx_heap_remove_at(h, 0, top);
+
+done:
+    return error;
+}
+
+int
+idx_heap_remove(idx_heap_t *h, uint64_t id, idx_heap_elem_t *elem)
+{
+    int error = 0;
+
+    if (h == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (!idx_heap_contains(h, id)) {
+        error = ENOENT;
+        goto done;
+    }
+
+    idx_heap_remove_at(h, h->ih_pos[id], elem);
+
+done:
+    return error;
+}
+
+static int
+idx_heap_change_key(idx_heap_t *h, uint64_t id, uint64_t priority,
+                    bool decrease)
+{
+    int error = 0;
+    uint64_t index = 0;
+    uint64_t old_priority = 0;
+
+    if (h == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (!idx_heap_contains(h, id)) {
+        error = ENOENT;
+        goto done;
+    }
+
+    index = h->ih_pos[id];
+    old_priority = h->ih_arr[index].priority;
+
+    if ((decrease && priority > old_priority) ||
+        (!decrease && priority < old_priority)) {
+        error = EINVAL;
+        goto done;
+    }
+
+    h->ih_arr[index].priority = priority;
+
+    if (idx_heap_before(h, priority, old_priority)) {
+        idx_heap_sift_up(h, index);
+    } else {
+        idx_heap_sift_down(h, index);
+    }
+
+done:
+    return error;
+}
+
+int
+idx_heap_decrease_key(idx_heap_t *h, uint64_t id, uint64_t priority)
+{
+    return idx_heap_change_key(h, id, priority, true);
+}
+
+int
+idx_heap_increase_key(idx_heap_t *h, uint64_t id, uint64_t priority)
+{
+    return idx_heap_change_key(h, id, priority, false);
+}
+
+void
+print_idx_heap(idx_heap_t *h)
+{
+    if (idx_heap_is_empty(h)) {
+        printf("Heap Empty");
+        return;
+    }
+
+    for (uint64_t i = 0; i < h->ih_curr_size; i++) {
+        printf("%llu(id %llu) ", h->ih_arr[i].priority, h->ih_arr[i].id);
+    }
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * K-way Merge of Sorted Runs Implementation.
+ */
+
+#include <kway_merge.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+int
+kway_array_read(void *ctx, int64_t *buf, int max, int *count)
+{
+    kway_array_run_t *r = (kway_array_run_t *)ctx;
+    int n = r->len - r->pos;
+
+    if (n > max) {
+        n = max;
+    }
+
+    memcpy(buf, &r->arr[r->pos], n * sizeof(int64_t));
+    r->pos += n;
+    *count = n;
+
+    return 0;
+}
+
+/*
+ * Pull the next batch of a run. Errors are latched in km_error and the
+ * run is treated as exhausted so the tree stays consistent.
+ */
+static void
+kway_refill(kway_merge_t *m, int index)
+{
+    kway_source_t *s = &m->km_sources[index];
+    int count = 0;
+    int error = 0;
+
+    s->pos = 0;
+    s->len = 0;
+    m->km_keys[index] = INT64_MAX;
+
+    if (m->km_exhausted[index]) {
+        return;
+    }
+
+    error = s->run.read(s->run.ctx, s->buf, m->km_batch, &count);
+    if (error && m->km_error == 0) {
+        m->km_error = error;
+    }
+
+    if (error || count <= 0) {
+        m->km_exhausted[index] = true;
+        return;
+    }
+
+    s->len = count;
+    m->km_keys[index] = s->buf[0];
+}
+
+/*
+ * True if run 'a' should be output before run 'b'. A real INT64_MAX
+ * beats the INT64_MAX of an exhausted run. Uses bitwise operators so
+ * that the replay loop compiles to conditional moves, since the outcome
+ * of each match is close to random on real data.
+ */
+static inline bool
+kway_beats(kway_merge_t *m, int a, int b)
+{
+    int64_t ka = m->km_keys[a];
+    int64_t kb = m->km_keys[b];
+
+    return (ka < kb) |
+           ((ka == kb) & (m->km_exhausted[a] < m->km_exhausted[b]));
+}
+
+/*
+ * Play every match bottom up once. 'winners' is scratch space for the
+ * winner of each internal node.
+ */
+static void
+kway_build(kway_merge_t *m, int *winners)
+{
+    int leaves = m->km_leaves;
+
+    for (int i = 0; i < leaves; i++) {
+        winners[leaves + i] = i;
+    }
+
+    for (int node = leaves - 1; node >= 1; node--) {
+        int left = winners[2 * node];
+        int right = winners[2 * node + 1];
+
+        if (kway_beats(m, left, right)) {
+            winners[node] = left;
+            m->km_tree[node] = right;
+        } else {
+            winners[node] = right;
+            m->km_tree[node] = left;
+        }
+    }
+
+    m->km_tree[0] = winners[1];
+}
+
+/*
+ * Run 'winner' has a new head value; replay its matches up to the root.
+ */
+static void
+kway_replay(kway_merge_t *m, int winner)
+{
+    int *tree = m->km_tree;
+
+    for (int node = (winner + m->km_leaves) / 2; node >= 1; node /= 2) {
+        int loser = tree[node];
+        bool swap = kway_beats(m, loser, winner);
+
+        tree[node] = swap ? winner : loser;
+        winner = swap ? loser : winner;
+    }
+
+    tree[0] = winner;
+}
+
+kway_merge_t *
+create_kway_merge(kway_run_t *runs, int k, int batch)
+{
+    kway_merge_t *m = NULL;
+    int *winners = NULL;
+    int leaves = 1;
+
+    if (runs == NULL || k <= 0 || batch < 0) {
+        goto done;
+    }
+
+    while (leaves < k) {
+        leaves *= 2;
+    }
+
+    m = (kway_merge_t *)calloc(1, sizeof(kway_merge_t));
+    if (m == NULL) {
+        goto done;
+    }
+
+    m->km_leaves = leaves;
+    m->km_batch = batch ? batch : KWAY_MERGE_DEFAULT_BATCH;
+    m->km_sources = (kway_source_t *)calloc(leaves, sizeof(kway_source_t));
+    m->km_keys = (int64_t *)malloc(leaves * sizeof(int64_t));
+    m->km_exhausted = (bool *)calloc(leaves, sizeof(bool));
+    m->km_tree = (int *)calloc(leaves, sizeof(int));
+    winners = (int *)malloc(2 * leaves * sizeof(int));
+    if (m->km_sources == NULL || m->km_keys == NULL ||
+        m->km_exhausted == NULL || m->km_tree == NULL || winners == NULL) {
+        goto fail;
+    }
+
+    for (int i = 0; i < leaves; i++) {
+        kway_source_t *s = &m->km_sources[i];
+
+        if (i >= k) {
+            m->km_exhausted[i] = true;
+            m->km_keys[i] = INT64_MAX;
+            continue;
+        }
+
+        s->run = runs[i];
+        s->buf = (int64_t *)malloc(m->km_batch * sizeof(int64_t));
+        if (s->buf == NULL) {
+            goto fail;
+        }
+        kway_refill(m, i);
+    }
+
+    if (m->km_error) {
+        goto fail;
+    }
+
+    kway_build(m, winners);
+    goto done;
+
+fail:
+    destroy_kway_merge(m);
+    m = NULL;
+
+done:
+    free(winners);
+    return m;
+}
+
+int
+destroy_kway_merge(kway_merge_t *m)
+{
+    int error = 0;
+
+    if (m == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (m->km_sources) {
+        for (int i = 0; i < m->km_leaves; i++) {
+            free(m->km_sources[i].buf);
+        }
+    }
+    free(m->km_sources);
+    free(m->km_keys);
+    free(m->km_exhausted);
+    free(m->km_tree);
+    free(m);
+
+done:
+    return error;
+}
+
+int
+kway_merge_next_block(kway_merge_t *m, int64_t *out, int max, int *count)
+{
+    int error = 0;
+    int n = 0;
+
+    if (m == NULL || out == NULL || count == NULL || max < 0) {
+        error = EINVAL;
+        goto done;
+    }
+
+    while (n < max) {
+        int winner = m->km_tree[0];
+        kway_source_t *s = &m->km_sources[winner];
+
+        if (m->km_exhausted[winner]) {
+            break;
+        }
+
+        out[n++] = s->buf[s->pos++];
+        if (s->pos < s->len) {
+            m->km_keys[winner] = s->buf[s->pos];
+        } else {
+            kway_refill(m, winner);
+            if (m->km_error) {
+                break;
+            }
+        }
+        kway_replay(m, winner);
+    }
+
+    error = m->km_error;
+
+done:
+    if (count) {
+        *count = n;
+    }
+    return error;
+}
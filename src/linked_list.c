@@ -5,6 +5,7 @@
  */
 
 #include <linked_list.h>
+#include <node_cache.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <errno.h>
@@ -21,7 +22,7 @@ insert_slist_common(slist_node_t **head, uint64_t key, uint64_t val, bool tail)
         goto done;
     }
 
-    slist_node_t *new_node = (slist_node_t *)malloc(sizeof(slist_node_t));
+    slist_node_t *new_node = (slist_node_t *)node_cache_alloc(NODE_CACHE_SLIST);
     if (new_node == NULL) {
         *head = NULL;
         error = ENOMEM;
@@ -88,7 +89,7 @@ slist_remove(slist_node_t **head, uint64_t key)
     /* Single Element. */
     if ((*head)->next == NULL) {
         if ((*head)->key_node.key == key) {
-            free(*head);
+            node_cache_free(NODE_CACHE_SLIST, *head);
             *head = NULL;
         } else {
             error = ENOENT;
@@ -101,7 +102,7 @@ slist_remove(slist_node_t **head, uint64_t key)
     while (temp) {
         if (temp->key_node.key == key) {
             prev->next = temp->next;
-            free(temp);
+            node_cache_free(NODE_CACHE_SLIST, temp);
             goto done;
         }
         prev = temp;
@@ -153,7 +154,7 @@ insert_dlist_common(dlist_node_t **head, uint64_t key, bool tail)
        goto done;
    }
 
-   dlist_node_t *new_node = (dlist_node_t*)malloc(sizeof(dlist_node_t));
+   dlist_node_t *new_node = (dlist_node_t*)node_cache_alloc(NODE_CACHE_DLIST);
    if (new_node == NULL) {
        error = ENOMEM;
        goto done;
@@ -224,7 +225,7 @@ dlist_remove(dlist_node_t **head, uint64_t key)
     /* Single Element. */
     if ((*head)->next == NULL) {
         if ((*head)->key_node.key == key) {
-            free(*head);
+            node_cache_free(NODE_CACHE_DLIST, *head);
             *head = NULL;
         } else {
             error = ENOENT;
@@ -239,7 +240,7 @@ dlist_remove(dlist_node_t **head, uint64_t key)
             if (temp->next) {
                 temp->next->prev = temp->prev;
             }
-            free(temp);
+            node_cache_free(NODE_CACHE_DLIST, temp);
             goto done;
         }
         temp = temp->next;
@@ -276,6 +277,382 @@ dlist_foreach(dlist_node_t *head, dll_traversalcb cb)
     error = ENOENT;
 
 done:
-    return error;}
+    return error;
+}
+
+/*
+ * Sort and merge code shared by both list types. The loops only follow
+ * 'next' and compare 'key_node.key', so one body is instantiated per
+ * node type as <prefix>_merge_runs and <prefix>_sort_runs.
+ *
+ * <prefix>_merge_runs merges two sorted runs; ties are taken from 'a'
+ * first so the sort built on top of it stays stable.
+ *
+ * <prefix>_sort_runs is a bottom-up merge sort. runs[i] holds a sorted
+ * run of 2^i nodes (or NULL), so each node taken off the list is carried
+ * up like a binary counter.
+ */
+#define LIST_SORT_MAX_RUNS 64
+
+#define LIST_SORT_DEFINE(prefix, node_t)                                    \
+static node_t *                                                             \
+prefix##_merge_runs(node_t *a, node_t *b)                                   \
+{                                                                           \
+    node_t merged_head = {0};                                               \
+    node_t *tail = &merged_head;                                            \
+                                                                            \
+    while (a && b) {                                                        \
+        if (b->key_node.key < a->key_node.key) {                            \
+            tail->next = b;                                                 \
+            b = b->next;                                                    \
+        } else {                                                            \
+            tail->next = a;                                                 \
+            a = a->next;                                                    \
+        }                                                                   \
+        tail = tail->next;                                                  \
+    }                                                                       \
+    tail->next = (a != NULL) ? a : b;                                       \
+                                                                            \
+    return merged_head.next;                                                \
+}                                                                           \
+                                                                            \
+static node_t *                                                             \
+prefix##_sort_runs(node_t *list)                                            \
+{                                                                           \
+    node_t *runs[LIST_SORT_MAX_RUNS] = {0};                                 \
+    node_t *carry = NULL;                                                   \
+    node_t *result = NULL;                                                  \
+    int i = 0;                                                              \
+                                                                            \
+    while (list) {                                                          \
+        carry = list;                                                       \
+        list = list->next;                                                  \
+        carry->next = NULL;                                                 \
+                                                                            \
+        for (i = 0; i < LIST_SORT_MAX_RUNS - 1 && runs[i] != NULL; i++) {   \
+            carry = prefix##_merge_runs(runs[i], carry);                    \
+            runs[i] = NULL;                                                 \
+        }                                                                   \
+        runs[i] = prefix##_merge_runs(runs[i], carry);                      \
+    }                                                                       \
+                                                                            \
+    for (i = 0; i < LIST_SORT_MAX_RUNS; i++) {                              \
+        result = prefix##_merge_runs(runs[i], result);                      \
+    }                                                                       \
+                                                                            \
+    return result;                                                          \
+}
+
+LIST_SORT_DEFINE(slist, slist_node_t)
+LIST_SORT_DEFINE(dlist, dlist_node_t)
+
+int
+slist_destroy(slist_node_t **head)
+{
+    int error = 0;
+    slist_node_t *next = NULL;
+
+    if (head == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    while (*head) {
+        next = (*head)->next;
+        node_cache_free(NODE_CACHE_SLIST, *head);
+        *head = next;
+    }
+
+done:
+    return error;
+}
+
+int
+slist_sort(slist_node_t **head)
+{
+    int error = 0;
+
+    if (head == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    *head = slist_sort_runs(*head);
+
+done:
+    return error;
+}
+
+int
+slist_merge(slist_node_t **head, slist_node_t *other)
+{
+    int error = 0;
+
+    if (head == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    *head = slist_merge_runs(*head, other);
+
+done:
+    return error;
+}
+
+int
+slist_dedupe(slist_node_t **head)
+{
+    int error = 0;
+    slist_node_t *temp = NULL;
+    slist_node_t *dup = NULL;
+
+    if (head == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    temp = *head;
+    while (temp && temp->next) {
+        if (temp->next->key_node.key == temp->key_node.key) {
+            dup = temp->next;
+            temp->next = dup->next;
+            node_cache_free(NODE_CACHE_SLIST, dup);
+        } else {
+            temp = temp->next;
+        }
+    }
+
+done:
+    return error;
+}
+
+int
+slist_reverse(slist_node_t **head)
+{
+    int error = 0;
+    slist_node_t *prev = NULL;
+    slist_node_t *temp = NULL;
+    slist_node_t *next = NULL;
+
+    if (head == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    temp = *head;
+    while (temp) {
+        next = temp->next;
+        temp->next = prev;
+        prev = temp;
+        temp = next;
+    }
+    *head = prev;
+
+done:
+    return error;
+}
+
+/*
+ * Keep the first 'index' nodes in *head and hand the remainder back
+ * through *rest. Returns ERANGE if the list is shorter than 'index'.
+ */
+int
+slist_split_at(slist_node_t **head, uint64_t index, slist_node_t **rest)
+{
+    int error = 0;
+    slist_node_t *temp = NULL;
+
+    if (head == NULL || rest == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    *rest = NULL;
+
+    if (index == 0) {
+        *rest = *head;
+        *head = NULL;
+        goto done;
+    }
+
+    temp = *head;
+    while (temp && --index > 0) {
+        temp = temp->next;
+    }
+
+    if (temp == NULL) {
+        error = ERANGE;
+        goto done;
+    }
+
+    *rest = temp->next;
+    temp->next = NULL;
+
+done:
+    return error;
+}
+
+/*
+ * Doubly linked variants run the shared code over the 'next' chain and
+ * then restore the 'prev' pointers in a single pass.
+ */
+static void
+dlist_fix_prev(dlist_node_t *head)
+{
+    dlist_node_t *prev = NULL;
+
+    while (head) {
+        head->prev = prev;
+        prev = head;
+        head = head->next;
+    }
+}
+
+int
+dlist_destroy(dlist_node_t **head)
+{
+    int error = 0;
+    dlist_node_t *next = NULL;
+
+    if (head == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    while (*head) {
+        next = (*head)->next;
+        node_cache_free(NODE_CACHE_DLIST, *head);
+        *head = next;
+    }
+
+done:
+    return error;
+}
+
+int
+dlist_sort(dlist_node_t **head)
+{
+    int error = 0;
 
+    if (head == NULL) {
+        error = EINVAL;
+        goto done;
+    }
 
+    *head = dlist_sort_runs(*head);
+    dlist_fix_prev(*head);
+
+done:
+    return error;
+}
+
+int
+dlist_merge(dlist_node_t **head, dlist_node_t *other)
+{
+    int error = 0;
+
+    if (head == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    *head = dlist_merge_runs(*head, other);
+    dlist_fix_prev(*head);
+
+done:
+    return error;
+}
+
+int
+dlist_dedupe(dlist_node_t **head)
+{
+    int error = 0;
+    dlist_node_t *temp = NULL;
+    dlist_node_t *dup = NULL;
+
+    if (head == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    temp = *head;
+    while (temp && temp->next) {
+        if (temp->next->key_node.key == temp->key_node.key) {
+            dup = temp->next;
+            temp->next = dup->next;
+            if (dup->next) {
+                dup->next->prev = temp;
+            }
+            node_cache_free(NODE_CACHE_DLIST, dup);
+        } else {
+            temp = temp->next;
+        }
+    }
+
+done:
+    return error;
+}
+
+int
+dlist_reverse(dlist_node_t **head)
+{
+    int error = 0;
+    dlist_node_t *temp = NULL;
+    dlist_node_t *next = NULL;
+
+    if (head == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    temp = *head;
+    while (temp) {
+        next = temp->next;
+        temp->next = temp->prev;
+        temp->prev = next;
+        *head = temp;
+        temp = next;
+    }
+
+done:
+    return error;
+}
+
+int
+dlist_split_at(dlist_node_t **head, uint64_t index, dlist_node_t **rest)
+{
+    int error = 0;
+    dlist_node_t *temp = NULL;
+
+    if (head == NULL || rest == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    *rest = NULL;
+
+    if (index == 0) {
+        *rest = *head;
+        *head = NULL;
+        goto done;
+    }
+
+    temp = *head;
+    while (temp && --index > 0) {
+        temp = temp->next;
+    }
+
+    if (temp == NULL) {
+        error = ERANGE;
+        goto done;
+    }
+
+    *rest = temp->next;
+    if (*rest) {
+        (*rest)->prev = NULL;
+    }
+    temp->next = NULL;
+
+done:
+    return error;
+}
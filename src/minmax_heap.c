@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Min-Max Heap Data Structure Operations Implementation.
+ */
+
+#include <minmax_heap.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <stdio.h>
+
+#define MINMAX_HEAP_MIN_GROW_CAPACITY 16
+
+static bool
+mh_is_min_level(uint64_t i)
+{
+    /* Depth of index i is floor(log2(i + 1)). */
+    return ((63 - __builtin_clzll(i + 1)) % 2) == 0;
+}
+
+/*
+ * Ordering used on a level: on min levels 'a' comes first when smaller,
+ * on max levels when larger.
+ */
+static bool
+mh_before(bool min_level, uint64_t a, uint64_t b)
+{
+    return min_level ? (a < b) : (a > b);
+}
+
+static void
+mh_swap(heap_elem_t *a, heap_elem_t *b)
+{
+    heap_elem_t temp = *a;
+
+    *a = *b;
+    *b = temp;
+}
+
+static void
+mh_bubble_up(minmax_heap_t *h, uint64_t i, bool min_level)
+{
+    heap_elem_t *arr = h->mh_arr;
+
+    /* Compare against grandparents, which sit on the same kind of level. */
+    while (i > 2) {
+        uint64_t grandparent = (((i - 1) / 2) - 1) / 2;
+
+        if (!mh_before(min_level, arr[i].key, arr[grandparent].key)) {
+            break;
+        }
+        mh_swap(&arr[i], &arr[grandparent]);
+        i = grandparent;
+    }
+}
+
+/*
+ * Sift the element at 'i' down among its children and grandchildren.
+ * When it lands on a grandchild it may be out of order with that
+ * grandchild's parent, which lives on the opposite kind of level.
+ */
+static void
+mh_trickle_down(minmax_heap_t *h, uint64_t i, bool min_level)
+{
+    heap_elem_t *arr = h->mh_arr;
+    uint64_t size = h->mh_curr_size;
+
+    while (2 * i + 1 < size) {
+        uint64_t best = 2 * i + 1;
+        uint64_t first_grandchild = 4 * i + 3;
+        uint64_t last = first_grandchild + 4;
+
+        if (best + 1 < size && mh_before(min_level, arr[best + 1].key,
+                                         arr[best].key)) {
+            best = best + 1;
+        }
+        if (last > size) {
+            last = size;
+        }
+        for (uint64_t g = first_grandchild; g < last; g++) {
+            if (mh_before(min_level, arr[g].key, arr[best].key)) {
+                best = g;
+            }
+        }
+
+        if (!mh_before(min_level, arr[best].key, arr[i].key)) {
+            break;
+        }
+        mh_swap(&arr[best], &arr[i]);
+
+        if (best < first_grandchild) {
+            break;
+        }
+
+        uint64_t parent = (best - 1) / 2;
+        if (mh_before(min_level, arr[parent].key, arr[best].key)) {
+            mh_swap(&arr[parent], &arr[best]);
+        }
+        i = best;
+    }
+}
+
+static int
+mh_resize(minmax_heap_t *h, uint64_t capacity)
+{
+    heap_elem_t *arr = NULL;
+
+    arr = (heap_elem_t *)realloc(h->mh_arr, capacity * sizeof(heap_elem_t));
+    if (arr == NULL) {
+        return ENOMEM;
+    }
+
+    h->mh_arr = arr;
+    h->mh_capacity = capacity;
+    return 0;
+}
+
+static int
+mh_grow(minmax_heap_t *h)
+{
+    uint64_t capacity = h->mh_capacity * 2;
+
+    if (!(h->mh_flags & HEAP_F_GROW)) {
+        return EFAULT;
+    }
+
+    if (capacity < MINMAX_HEAP_MIN_GROW_CAPACITY) {
+        capacity = MINMAX_HEAP_MIN_GROW_CAPACITY;
+    }
+
+    return mh_resize(h, capacity);
+}
+
+static void
+mh_maybe_shrink(minmax_heap_t *h)
+{
+    uint64_t capacity = h->mh_capacity / 2;
+
+    if (!(h->mh_flags & HEAP_F_SHRINK)) {
+        return;
+    }
+
+    if (h->mh_curr_size > h->mh_capacity / 4 ||
+        capacity < h->mh_min_capacity ||
+        capacity < MINMAX_HEAP_MIN_GROW_CAPACITY) {
+        return;
+    }
+
+    /* A failed shrink just leaves the larger array in place. */
+    mh_resize(h, capacity);
+}
+
+static uint64_t
+mh_max_index(minmax_heap_t *h)
+{
+    if (h->mh_curr_size == 1) {
+        return 0;
+    }
+    if (h->mh_curr_size == 2 || h->mh_arr[1].key >= h->mh_arr[2].key) {
+        return 1;
+    }
+    return 2;
+}
+
+/*
+ * Replace the element at 'index' with the last one and restore order
+ * from there.
+ */
+static void
+mh_delete_at(minmax_heap_t *h, uint64_t index, heap_elem_t *out)
+{
+    if (out) {
+        *out = h->mh_arr[index];
+    }
+
+    h->mh_curr_size--;
+    if (index < h->mh_curr_size) {
+        h->mh_arr[index] = h->mh_arr[h->mh_curr_size];
+        mh_trickle_down(h, index, mh_is_min_level(index));
+    }
+
+    mh_maybe_shrink(h);
+}
+
+minmax_heap_t *
+create_minmax_heap(uint64_t size, uint32_t flags)
+{
+    minmax_heap_t *h = NULL;
+
+    h = (minmax_heap_t *)malloc(sizeof(minmax_heap_t));
+    if (h == NULL) {
+        goto done;
+    }
+
+    h->mh_arr = (heap_elem_t *)malloc(size * sizeof(heap_elem_t));
+    if (h->mh_arr == NULL && size != 0) {
+        free(h);
+        h = NULL;
+        goto done;
+    }
+
+    h->mh_capacity = size;
+    h->mh_curr_size = 0;
+    h->mh_min_capacity = size;
+    h->mh_flags = flags;
+
+done:
+    return h;
+}
+
+int
+destroy_minmax_heap(minmax_heap_t *h)
+{
+    int error = 0;
+
+    if (h == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    free(h->mh_arr);
+    free(h);
+
+done:
+    return error;
+}
+
+int
+insert_minmax_heap(minmax_heap_t *h, heap_elem_t *elem)
+{
+    int error = 0;
+    uint64_t index = 0;
+    uint64_t parent = 0;
+    bool min_level = false;
+
+    if (h == NULL || elem == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (h->mh_curr_size == h->mh_capacity) {
+        error = mh_grow(h);
+        if (error) {
+            goto done;
+        }
+    }
+
+    index = h->mh_curr_size++;
+    h->mh_arr[index] = *elem;
+    if (index == 0) {
+        goto done;
+    }
+
+    /*
+     * If the new element belongs on the other kind of level than where
+     * it landed, swap it with its parent first, then bubble up through
+     * grandparents only.
+     */
+    parent = (index - 1) / 2;
+    min_level = mh_is_min_level(index);
+    if (mh_before(!min_level, h->mh_arr[index].key, h->mh_arr[parent].key)) {
+        mh_swap(&h->mh_arr[index], &h->mh_arr[parent]);
+        mh_bubble_up(h, parent, !min_level);
+    } else {
+        mh_bubble_up(h, index, min_level);
+    }
+
+done:
+    return error;
+}
+
+heap_elem_t *
+get_minmax_heap_min(minmax_heap_t *h)
+{
+    if (minmax_heap_is_empty(h)) {
+        return NULL;
+    }
+
+    return &h->mh_arr[0];
+}
+
+heap_elem_t *
+get_minmax_heap_max(minmax_heap_t *h)
+{
+    if (minmax_heap_is_empty(h)) {
+        return NULL;
+    }
+
+    return &h->mh_arr[mh_max_index(h)];
+}
+
+int
+delete_minmax_heap_min(minmax_heap_t *h, heap_elem_t *out)
+{
+    int error = 0;
+
+    if (h == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (minmax_heap_is_empty(h)) {
+        error = EFAULT;
+        goto done;
+    }
+
+    mh_delete_at(h, 0, out);
+
+done:
+    return error;
+}
+
+int
+delete_minmax_heap_max(minmax_heap_t *h, heap_elem_t *out)
+{
+    int error = 0;
+
+    if (h == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (minmax_heap_is_empty(h)) {
+        error = EFAULT;
+        goto done;
+    }
+
+    mh_delete_at(h, mh_max_index(h), out);
+
+done:
+    return error;
+}
+
+bool
+minmax_heap_is_empty(minmax_heap_t *h)
+{
+    return (h->mh_curr_size == 0);
+}
+
+uint64_t
+minmax_heap_size(minmax_heap_t *h)
+{
+    return h->mh_curr_size;
+}
+
+void
+print_minmax_heap(minmax_heap_t *h)
+{
+    if (minmax_heap_is_empty(h)) {
+        printf("Heap Empty");
+        return;
+    }
+
+    for (uint64_t i = 0; i < h->mh_curr_size; i++) {
+        printf("%llu ", h->mh_arr[i].key);
+    }
+}
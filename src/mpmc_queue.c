@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Bounded Lock-free Multi Producer Multi Consumer Queue Implementation.
+ */
+
+#include <mpmc_queue.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <sched.h>
+
+/* Failed attempts between yields in the waiting paths. */
+#define MPMC_SPINS_PER_YIELD    64
+
+/*
+ * Slot layout: the sequence number followed by the element, padded so
+ * the next sequence number stays 8 byte aligned.
+ */
+typedef struct mpmc_slot_ {
+    _Atomic uint64_t seq;
+    uint8_t data[];
+} mpmc_slot_t;
+
+static mpmc_slot_t *
+mpmc_slot(mpmc_queue_t *q, uint64_t pos)
+{
+    return (mpmc_slot_t *)&q->mp_slots[(pos & q->mp_mask) * q->mp_stride];
+}
+
+static void
+mpmc_backoff(uint64_t *spins)
+{
+    if ((++*spins % MPMC_SPINS_PER_YIELD) == 0) {
+        sched_yield();
+    }
+}
+
+/*
+ * Wait for a slot inside a claimed batch to reach 'seq'.
+ */
+static void
+mpmc_wait_seq(mpmc_slot_t *slot, uint64_t seq)
+{
+    uint64_t spins = 0;
+
+    while (atomic_load_explicit(&slot->seq, memory_order_acquire) != seq) {
+        mpmc_backoff(&spins);
+    }
+}
+
+mpmc_queue_t *
+create_mpmc_queue(uint64_t capacity, size_t elem_size)
+{
+    mpmc_queue_t *q = NULL;
+    uint64_t size = 2;
+
+    if (capacity == 0 || elem_size == 0) {
+        goto done;
+    }
+
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    if (posix_memalign((void **)&q, MPMC_QUEUE_CACHE_LINE,
+                       sizeof(mpmc_queue_t)) != 0) {
+        q = NULL;
+        goto done;
+    }
+
+    q->mp_mask = size - 1;
+    q->mp_elem_size = elem_size;
+    q->mp_stride = sizeof(mpmc_slot_t) + ((elem_size + 7) & ~(size_t)7);
+
+    if (posix_memalign((void **)&q->mp_slots, MPMC_QUEUE_CACHE_LINE,
+                       size * q->mp_stride) != 0) {
+        free(q);
+        q = NULL;
+        goto done;
+    }
+
+    for (uint64_t i = 0; i < size; i++) {
+        atomic_init(&mpmc_slot(q, i)->seq, i);
+    }
+    atomic_init(&q->mp_tail, 0);
+    atomic_init(&q->mp_head, 0);
+
+done:
+    return q;
+}
+
+int
+destroy_mpmc_queue(mpmc_queue_t *q)
+{
+    int error = 0;
+
+    if (q == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    free(q->mp_slots);
+    free(q);
+
+done:
+    return error;
+}
+
+int
+mpmc_queue_try_enqueue(mpmc_queue_t *q, const void *elem)
+{
+    uint64_t pos = atomic_load_explicit(&q->mp_tail, memory_order_relaxed);
+    mpmc_slot_t *slot = NULL;
+
+    for (;;) {
+        slot = mpmc_slot(q, pos);
+        uint64_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int64_t diff = (int64_t)(seq - pos);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->mp_tail, &pos,
+                                                      pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* The slot still holds last lap's element: full. */
+            return EAGAIN;
+        } else {
+            pos = atomic_load_explicit(&q->mp_tail, memory_order_relaxed);
+        }
+    }
+
+    memcpy(slot->data, elem, q->mp_elem_size);
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    return 0;
+}
+
+int
+mpmc_queue_try_dequeue(mpmc_queue_t *q, void *elem)
+{
+    uint64_t pos = atomic_load_explicit(&q->mp_head, memory_order_relaxed);
+    mpmc_slot_t *slot = NULL;
+
+    for (;;) {
+        slot = mpmc_slot(q, pos);
+        uint64_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int64_t diff = (int64_t)(seq - (pos + 1));
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->mp_head, &pos,
+                                                      pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* Not yet filled for this lap: empty. */
+            return EAGAIN;
+        } else {
+            pos = atomic_load_explicit(&q->mp_head, memory_order_relaxed);
+        }
+    }
+
+    memcpy(elem, slot->data, q->mp_elem_size);
+    atomic_store_explicit(&slot->seq, pos + q->mp_mask + 1,
+                          memory_order_release);
+    return 0;
+}
+
+int
+mpmc_queue_enqueue(mpmc_queue_t *q, const void *elem)
+{
+    uint64_t spins = 0;
+
+    while (mpmc_queue_try_enqueue(q, elem) != 0) {
+        mpmc_backoff(&spins);
+    }
+
+    return 0;
+}
+
+int
+mpmc_queue_dequeue(mpmc_queue_t *q, void *elem)
+{
+    uint64_t spins = 0;
+
+    while (mpmc_queue_try_dequeue(q, elem) != 0) {
+        mpmc_backoff(&spins);
+    }
+
+    return 0;
+}
+
+/*
+ * Claim up to 'n' positions from 'counter'. 'limit' is the other side's
+ * counter; 'room' turns the gap between them into how many positions
+ * this side may take. The first slot is checked the same way as the
+ * single element path, so an empty or full queue fails without a CAS.
+ */
+static uint64_t
+mpmc_claim(mpmc_queue_t *q, _Atomic uint64_t *counter,
+           _Atomic uint64_t *limit, uint64_t n, bool enqueue, uint64_t *start)
+{
+    uint64_t capacity = q->mp_mask + 1;
+    uint64_t pos = atomic_load_explicit(counter, memory_order_relaxed);
+
+    for (;;) {
+        uint64_t seq = atomic_load_explicit(&mpmc_slot(q, pos)->seq,
+                                            memory_order_acquire);
+        int64_t diff = (int64_t)(seq - (enqueue ? pos : pos + 1));
+        uint64_t other = 0;
+        uint64_t avail = 0;
+
+        if (diff < 0) {
+            return 0;
+        }
+        if (diff > 0) {
+            pos = atomic_load_explicit(counter, memory_order_relaxed);
+            continue;
+        }
+
+        other = atomic_load_explicit(limit, memory_order_acquire);
+        if (enqueue) {
+            avail = capacity - (pos - other);
+        } else {
+            avail = other - pos;
+        }
+        /* 'other' may be stale enough to underflow; the first slot is
+         * known good, so fall back to one. */
+        if (avail == 0 || avail > capacity) {
+            avail = 1;
+        }
+        if (avail > n) {
+            avail = n;
+        }
+
+        if (atomic_compare_exchange_weak_explicit(counter, &pos, pos + avail,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+            *start = pos;
+            return avail;
+        }
+    }
+}
+
+int
+mpmc_queue_try_enqueue_batch(mpmc_queue_t *q, const void *elems,
+                             uint64_t n, uint64_t *done)
+{
+    int error = 0;
+    const uint8_t *src = (const uint8_t *)elems;
+    uint64_t start = 0;
+    uint64_t count = 0;
+
+    if (q == NULL || (elems == NULL && n != 0)) {
+        error = EINVAL;
+        goto done;
+    }
+
+    count = mpmc_claim(q, &q->mp_tail, &q->mp_head, n, true, &start);
+    if (count == 0) {
+        error = (n == 0) ? 0 : EAGAIN;
+        goto done;
+    }
+
+    for (uint64_t i = 0; i < count; i++) {
+        mpmc_slot_t *slot = mpmc_slot(q, start + i);
+
+        mpmc_wait_seq(slot, start + i);
+        memcpy(slot->data, src + i * q->mp_elem_size, q->mp_elem_size);
+        atomic_store_explicit(&slot->seq, start + i + 1,
+                              memory_order_release);
+    }
+
+done:
+    if (done) {
+        *done = count;
+    }
+    return error;
+}
+
+int
+mpmc_queue_try_dequeue_batch(mpmc_queue_t *q, void *elems, uint64_t n,
+                             uint64_t *done)
+{
+    int error = 0;
+    uint8_t *dst = (uint8_t *)elems;
+    uint64_t start = 0;
+    uint64_t count = 0;
+
+    if (q == NULL || (elems == NULL && n != 0)) {
+        error = EINVAL;
+        goto done;
+    }
+
+    count = mpmc_claim(q, &q->mp_head, &q->mp_tail, n, false, &start);
+    if (count == 0) {
+        error = (n == 0) ? 0 : EAGAIN;
+        goto done;
+    }
+
+    for (uint64_t i = 0; i < count; i++) {
+        mpmc_slot_t *slot = mpmc_slot(q, start + i);
+
+        mpmc_wait_seq(slot, start + i + 1);
+        memcpy(dst + i * q->mp_elem_size, slot->data, q->mp_elem_size);
+        atomic_store_explicit(&slot->seq, start + i + q->mp_mask + 1,
+                              memory_order_release);
+    }
+
+done:
+    if (done) {
+        *done = count;
+    }
+    return error;
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Relaxed Concurrent Priority Queue (MultiQueue) Implementation.
+ */
+
+#include <multiqueue.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <errno.h>
+
+#define MQ_CACHE_LINE   64
+#define MQ_EMPTY_KEY    UINT64_MAX
+
+/*
+ * One sub-queue. 'top' mirrors the heap minimum so that delete-min can
+ * compare two candidates without taking either lock. Each sub-queue sits
+ * on its own cache line.
+ */
+typedef struct mq_heap_ {
+    pthread_mutex_t lock;
+    _Atomic uint64_t top;
+    heap_t *heap;
+} __attribute__((aligned(MQ_CACHE_LINE))) mq_heap_t;
+
+struct multiqueue_ {
+    uint64_t num_heaps;
+    mq_heap_t *heaps;
+};
+
+static _Thread_local uint64_t mq_rand_state;
+
+/*
+ * xorshift64, seeded per thread from the address of its state.
+ */
+static uint64_t
+mq_rand(void)
+{
+    uint64_t x = mq_rand_state;
+
+    if (x == 0) {
+        x = (uint64_t)(uintptr_t)&mq_rand_state | 1;
+    }
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    mq_rand_state = x;
+
+    return x;
+}
+
+static void
+mq_update_top(mq_heap_t *q)
+{
+    heap_elem_t *min = get_min(q->heap);
+
+    atomic_store_explicit(&q->top, min ? min->key : MQ_EMPTY_KEY,
+                          memory_order_relaxed);
+}
+
+multiqueue_t *
+create_multiqueue(uint64_t num_threads, uint64_t factor)
+{
+    multiqueue_t *mq = NULL;
+    uint64_t num_heaps = num_threads * factor;
+    uint64_t i = 0;
+
+    if (num_heaps == 0) {
+        goto done;
+    }
+
+    mq = (multiqueue_t *)malloc(sizeof(multiqueue_t));
+    if (mq == NULL) {
+        goto done;
+    }
+
+    if (posix_memalign((void **)&mq->heaps, MQ_CACHE_LINE,
+                       num_heaps * sizeof(mq_heap_t)) != 0) {
+        free(mq);
+        mq = NULL;
+        goto done;
+    }
+
+    for (i = 0; i < num_heaps; i++) {
+        mq_heap_t *q = &mq->heaps[i];
+        q->heap = create_heap_flags(MIN_HEAP, 0, HEAP_F_GROW);
+        if (q->heap == NULL) {
+            break;
+        }
+        pthread_mutex_init(&q->lock, NULL);
+        atomic_init(&q->top, MQ_EMPTY_KEY);
+    }
+
+    mq->num_heaps = i;
+    if (i != num_heaps) {
+        destroy_multiqueue(mq);
+        mq = NULL;
+    }
+
+done:
+    return mq;
+}
+
+int
+destroy_multiqueue(multiqueue_t *mq)
+{
+    int error = 0;
+
+    if (mq == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    for (uint64_t i = 0; i < mq->num_heaps; i++) {
+        pthread_mutex_destroy(&mq->heaps[i].lock);
+        destroy_heap(mq->heaps[i].heap);
+    }
+    free(mq->heaps);
+    free(mq);
+
+done:
+    return error;
+}
+
+uint64_t
+multiqueue_num_heaps(multiqueue_t *mq)
+{
+    return mq->num_heaps;
+}
+
+int
+multiqueue_insert(multiqueue_t *mq, heap_elem_t *elem)
+{
+    int error = 0;
+    mq_heap_t *q = NULL;
+
+    if (mq == NULL || elem == NULL || elem->key == MQ_EMPTY_KEY) {
+        error = EINVAL;
+        goto done;
+    }
+
+    do {
+        q = &mq->heaps[mq_rand() % mq->num_heaps];
+    } while (pthread_mutex_trylock(&q->lock) != 0);
+
+    error = insert_heap(q->heap, elem);
+    if (error == 0) {
+        mq_update_top(q);
+    }
+    pthread_mutex_unlock(&q->lock);
+
+done:
+    return error;
+}
+
+/*
+ * Pop from 'q' if it is still non empty once locked.
+ */
+static bool
+mq_pop_locked(mq_heap_t *q, heap_elem_t *min)
+{
+    heap_elem_t *top = get_min(q->heap);
+
+    if (top == NULL) {
+        return false;
+    }
+
+    if (min) {
+        *min = *top;
+    }
+    delete_min(q->heap, &top);
+    mq_update_top(q);
+
+    return true;
+}
+
+int
+multiqueue_delete_min(multiqueue_t *mq, heap_elem_t *min)
+{
+    int error = 0;
+    uint64_t attempts = 0;
+
+    if (mq == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    /*
+     * Pick two, lock the better one. After a run of misses on empty
+     * heaps fall back to a full sweep, which is also how emptiness of
+     * the whole queue is decided.
+     */
+    while (attempts < mq->num_heaps) {
+        mq_heap_t *a = &mq->heaps[mq_rand() % mq->num_heaps];
+        mq_heap_t *b = &mq->heaps[mq_rand() % mq->num_heaps];
+        uint64_t a_top = atomic_load_explicit(&a->top, memory_order_relaxed);
+        uint64_t b_top = atomic_load_explicit(&b->top, memory_order_relaxed);
+        mq_heap_t *q = (b_top < a_top) ? b : a;
+        bool popped = false;
+
+        if (a_top == MQ_EMPTY_KEY && b_top == MQ_EMPTY_KEY) {
+            attempts++;
+            continue;
+        }
+
+        if (pthread_mutex_trylock(&q->lock) != 0) {
+            continue;
+        }
+        popped = mq_pop_locked(q, min);
+        pthread_mutex_unlock(&q->lock);
+
+        if (popped) {
+            goto done;
+        }
+        attempts++;
+    }
+
+    for (uint64_t i = 0; i < mq->num_heaps; i++) {
+        mq_heap_t *q = &mq->heaps[i];
+        bool popped = false;
+
+        if (atomic_load_explicit(&q->top, memory_order_relaxed) ==
+            MQ_EMPTY_KEY) {
+            continue;
+        }
+
+        pthread_mutex_lock(&q->lock);
+        popped = mq_pop_locked(q, min);
+        pthread_mutex_unlock(&q->lock);
+
+        if (popped) {
+            goto done;
+        }
+    }
+
+    error = ENOENT;
+
+done:
+    return error;
+}
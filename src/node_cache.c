@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Per-thread Node Caches Implementation.
+ */
+
+#include <node_cache.h>
+#include <linked_list.h>
+#include <binary_tree.h>
+#include <pairing_heap.h>
+#include <avl_tree.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define NODE_CACHE_SIZE(type) \
+    ((sizeof(type) > sizeof(node_cache_obj_t)) ? \
+     sizeof(type) : sizeof(node_cache_obj_t))
+
+static node_cache_t node_caches[NODE_CACHE_MAX] = {
+    [NODE_CACHE_SLIST] = {
+        .obj_size = NODE_CACHE_SIZE(slist_node_t),
+        .lock = PTHREAD_MUTEX_INITIALIZER,
+    },
+    [NODE_CACHE_DLIST] = {
+        .obj_size = NODE_CACHE_SIZE(dlist_node_t),
+        .lock = PTHREAD_MUTEX_INITIALIZER,
+    },
+    [NODE_CACHE_BT] = {
+        .obj_size = NODE_CACHE_SIZE(bt_node),
+        .lock = PTHREAD_MUTEX_INITIALIZER,
+    },
+    [NODE_CACHE_PAIRING_HEAP] = {
+        .obj_size = NODE_CACHE_SIZE(pairing_heap_node_t),
+        .lock = PTHREAD_MUTEX_INITIALIZER,
+    },
+    [NODE_CACHE_AVL] = {
+        .obj_size = NODE_CACHE_SIZE(avl_node_t),
+        .lock = PTHREAD_MUTEX_INITIALIZER,
+    },
+};
+
+_Thread_local node_cache_tls_t node_cache_tls[NODE_CACHE_MAX];
+
+static pthread_once_t node_cache_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t node_cache_key;
+
+static void
+node_cache_thread_exit(void *arg)
+{
+    node_cache_thread_flush();
+}
+
+static void
+node_cache_key_init(void)
+{
+    pthread_key_create(&node_cache_key, node_cache_thread_exit);
+}
+
+/*
+ * First slow path call on a thread arms the thread exit flush and
+ * opens up the fast free path by setting a non zero limit.
+ */
+static void
+node_cache_thread_register(node_cache_tls_t *tls)
+{
+    if (tls->limit != 0) {
+        return;
+    }
+
+    pthread_once(&node_cache_key_once, node_cache_key_init);
+    pthread_setspecific(node_cache_key, node_cache_tls);
+
+    for (int i = 0; i < NODE_CACHE_MAX; i++) {
+        node_cache_tls[i].limit = 2 * NODE_CACHE_BATCH;
+    }
+}
+
+static void
+free_obj_chain(node_cache_obj_t *obj)
+{
+    node_cache_obj_t *next = NULL;
+
+    while (obj) {
+        next = obj->next;
+        free(obj);
+        obj = next;
+    }
+}
+
+/*
+ * Hand a chain of free nodes to the depot as one batch. If the depot is
+ * already holding plenty, the nodes go back to malloc instead.
+ */
+static void
+depot_put_batch(node_cache_t *c, node_cache_obj_t *batch, uint64_t count)
+{
+    bool release = false;
+
+    if (batch == NULL) {
+        return;
+    }
+
+    batch->batch_count = count;
+
+    pthread_mutex_lock(&c->lock);
+    if (c->num_batches >= NODE_CACHE_DEPOT_MAX) {
+        release = true;
+    } else {
+        batch->batch_next = c->batches;
+        c->batches = batch;
+        c->num_batches++;
+    }
+    pthread_mutex_unlock(&c->lock);
+
+    if (release) {
+        free_obj_chain(batch);
+    }
+}
+
+static node_cache_obj_t *
+depot_get_batch(node_cache_t *c, uint64_t *count)
+{
+    node_cache_obj_t *batch = NULL;
+
+    pthread_mutex_lock(&c->lock);
+    batch = c->batches;
+    if (batch) {
+        c->batches = batch->batch_next;
+        c->num_batches--;
+    }
+    pthread_mutex_unlock(&c->lock);
+
+    *count = batch ? batch->batch_count : 0;
+    return batch;
+}
+
+void *
+node_cache_alloc_slow(node_cache_id_e id)
+{
+    node_cache_t *c = &node_caches[id];
+    node_cache_tls_t *tls = &node_cache_tls[id];
+    node_cache_obj_t *batch = NULL;
+    uint64_t count = 0;
+
+    node_cache_thread_register(tls);
+
+    batch = depot_get_batch(c, &count);
+    if (batch == NULL) {
+        return malloc(c->obj_size);
+    }
+
+    tls->free_list = batch->next;
+    tls->count = count - 1;
+    return batch;
+}
+
+void
+node_cache_free_slow(node_cache_id_e id, void *obj)
+{
+    node_cache_t *c = &node_caches[id];
+    node_cache_tls_t *tls = &node_cache_tls[id];
+    node_cache_obj_t *batch = NULL;
+    node_cache_obj_t *last = NULL;
+
+    node_cache_thread_register(tls);
+
+    /* Return the oldest NODE_CACHE_BATCH nodes, keep the hot ones. */
+    if (tls->count >= tls->limit) {
+        last = tls->free_list;
+        for (uint64_t i = 1; i < tls->count - NODE_CACHE_BATCH; i++) {
+            last = last->next;
+        }
+        batch = last->next;
+        last->next = NULL;
+        tls->count -= NODE_CACHE_BATCH;
+        depot_put_batch(c, batch, NODE_CACHE_BATCH);
+    }
+
+    ((node_cache_obj_t *)obj)->next = tls->free_list;
+    tls->free_list = (node_cache_obj_t *)obj;
+    tls->count++;
+}
+
+void
+node_cache_thread_flush(void)
+{
+    for (int i = 0; i < NODE_CACHE_MAX; i++) {
+        node_cache_tls_t *tls = &node_cache_tls[i];
+
+        depot_put_batch(&node_caches[i], tls->free_list, tls->count);
+        tls->free_list = NULL;
+        tls->count = 0;
+    }
+}
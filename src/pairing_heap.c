@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Pairing Heap Data Structure Operations Implementation.
+ */
+
+#include <pairing_heap.h>
+#include <node_cache.h>
+#include <stdlib.h>
+#include <errno.h>
+
+static bool
+ph_before(pairing_heap_t *h, uint64_t a, uint64_t b)
+{
+    return (h->ph_type == MIN_HEAP) ? (a < b) : (a > b);
+}
+
+/*
+ * Link two roots, making the loser the leftmost child of the winner.
+ * Either argument may be NULL.
+ */
+static pairing_heap_node_t *
+ph_link(pairing_heap_t *h, pairing_heap_node_t *a, pairing_heap_node_t *b)
+{
+    pairing_heap_node_t *temp = NULL;
+
+    if (a == NULL) {
+        return b;
+    }
+    if (b == NULL) {
+        return a;
+    }
+
+    if (ph_before(h, b->key, a->key)) {
+        temp = a;
+        a = b;
+        b = temp;
+    }
+
+    b->prev = a;
+    b->next = a->child;
+    if (a->child) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    a->next = NULL;
+    a->prev = NULL;
+
+    return a;
+}
+
+/*
+ * Two pass pairing of a sibling list. The first pass links neighbours
+ * left to right and stacks the results through 'prev'; the second pass
+ * links them right to left into a single tree. No recursion, so long
+ * sibling lists cannot overflow the stack.
+ */
+static pairing_heap_node_t *
+ph_merge_pairs(pairing_heap_t *h, pairing_heap_node_t *first)
+{
+    pairing_heap_node_t *stack = NULL;
+    pairing_heap_node_t *result = NULL;
+
+    while (first) {
+        pairing_heap_node_t *a = first;
+        pairing_heap_node_t *b = first->next;
+        pairing_heap_node_t *pair = NULL;
+
+        first = b ? b->next : NULL;
+        a->next = NULL;
+        a->prev = NULL;
+        if (b) {
+            b->next = NULL;
+            b->prev = NULL;
+        }
+
+        pair = ph_link(h, a, b);
+        pair->prev = stack;
+        stack = pair;
+    }
+
+    while (stack) {
+        pairing_heap_node_t *prev = stack->prev;
+        stack->prev = NULL;
+        result = ph_link(h, stack, result);
+        stack = prev;
+    }
+
+    return result;
+}
+
+/*
+ * Detach a non root node and its subtree from its parent or siblings.
+ */
+static void
+ph_cut(pairing_heap_node_t *node)
+{
+    if (node->prev->child == node) {
+        node->prev->child = node->next;
+    } else {
+        node->prev->next = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+    node->next = NULL;
+    node->prev = NULL;
+}
+
+pairing_heap_t *
+create_pairing_heap(heap_type_e type)
+{
+    pairing_heap_t *h = (pairing_heap_t *)malloc(sizeof(pairing_heap_t));
+    if (h == NULL) {
+        goto done;
+    }
+
+    h->ph_type = type;
+    h->ph_root = NULL;
+    h->ph_size = 0;
+
+done:
+    return h;
+}
+
+int
+destroy_pairing_heap(pairing_heap_t *h)
+{
+    int error = 0;
+    pairing_heap_node_t *node = NULL;
+
+    if (h == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    /*
+     * Free iteratively by splicing each node's children into the list
+     * of nodes still to visit.
+     */
+    node = h->ph_root;
+    while (node) {
+        pairing_heap_node_t *next = node->next;
+        if (node->child) {
+            pairing_heap_node_t *last = node->child;
+            while (last->next) {
+                last = last->next;
+            }
+            last->next = next;
+            next = node->child;
+        }
+        node_cache_free(NODE_CACHE_PAIRING_HEAP, node);
+        node = next;
+    }
+
+    free(h);
+
+done:
+    return error;
+}
+
+bool
+pairing_heap_is_empty(pairing_heap_t *h)
+{
+    return (h->ph_root == NULL);
+}
+
+pairing_heap_node_t *
+pairing_heap_insert(pairing_heap_t *h, uint64_t key, void *payload)
+{
+    pairing_heap_node_t *node = NULL;
+
+    if (h == NULL) {
+        goto done;
+    }
+
+    node = (pairing_heap_node_t *)node_cache_alloc(NODE_CACHE_PAIRING_HEAP);
+    if (node == NULL) {
+        goto done;
+    }
+
+    node->key = key;
+    node->payload = payload;
+    node->child = NULL;
+    node->next = NULL;
+    node->prev = NULL;
+
+    h->ph_root = ph_link(h, h->ph_root, node);
+    h->ph_size++;
+
+done:
+    return node;
+}
+
+pairing_heap_node_t *
+pairing_heap_top(pairing_heap_t *h)
+{
+    return h->ph_root;
+}
+
+int
+pairing_heap_pop(pairing_heap_t *h, uint64_t *key, void **payload)
+{
+    int error = 0;
+    pairing_heap_node_t *root = NULL;
+
+    if (h == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    root = h->ph_root;
+    if (root == NULL) {
+        error = ENOENT;
+        goto done;
+    }
+
+    if (key) {
+        *key = root->key;
+    }
+    if (payload) {
+        *payload = root->payload;
+    }
+
+    h->ph_root = ph_merge_pairs(h, root->child);
+    h->ph_size--;
+    node_cache_free(NODE_CACHE_PAIRING_HEAP, root);
+
+done:
+    return error;
+}
+
+int
+pairing_heap_remove(pairing_heap_t *h, pairing_heap_node_t *node)
+{
+    int error = 0;
+    pairing_heap_node_t *children = NULL;
+
+    if (h == NULL || node == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (node == h->ph_root) {
+        error = pairing_heap_pop(h, NULL, NULL);
+        goto done;
+    }
+
+    ph_cut(node);
+    children = ph_merge_pairs(h, node->child);
+    h->ph_root = ph_link(h, h->ph_root, children);
+    h->ph_size--;
+    node_cache_free(NODE_CACHE_PAIRING_HEAP, node);
+
+done:
+    return error;
+}
+
+static int
+ph_change_key(pairing_heap_t *h, pairing_heap_node_t *node, uint64_t key,
+              bool decrease)
+{
+    int error = 0;
+    bool towards_root = false;
+    pairing_heap_node_t *children = NULL;
+
+    if (h == NULL || node == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if ((decrease && key > node->key) || (!decrease && key < node->key)) {
+        error = EINVAL;
+        goto done;
+    }
+
+    towards_root = ph_before(h, key, node->key);
+    node->key = key;
+
+    if (towards_root) {
+        /* Cut the whole subtree and link it back at the root. */
+        if (node != h->ph_root) {
+            ph_cut(node);
+            h->ph_root = ph_link(h, h->ph_root, node);
+        }
+        goto done;
+    }
+
+    /*
+     * Moving away from the root may break order with the children, so
+     * detach them, pair them up and link them back in as one tree.
+     */
+    children = ph_merge_pairs(h, node->child);
+    node->child = NULL;
+
+    if (node == h->ph_root) {
+        h->ph_root = ph_link(h, node, children);
+    } else {
+        h->ph_root = ph_link(h, h->ph_root, children);
+    }
+
+done:
+    return error;
+}
+
+int
+pairing_heap_decrease_key(pairing_heap_t *h, pairing_heap_node_t *node,
+                          uint64_t key)
+{
+    return ph_change_key(h, node, key, true);
+}
+
+int
+pairing_heap_increase_key(pairing_heap_t *h, pairing_heap_node_t *node,
+                          uint64_t key)
+{
+    return ph_change_key(h, node, key, false);
+}
+
+int
+pairing_heap_meld(pairing_heap_t *dst, pairing_heap_t *src)
+{
+    int error = 0;
+
+    if (dst == NULL || src == NULL || dst->ph_type != src->ph_type) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (dst == src) {
+        goto done;
+    }
+
+    dst->ph_root = ph_link(dst, dst->ph_root, src->ph_root);
+    dst->ph_size += src->ph_size;
+    src->ph_root = NULL;
+    src->ph_size = 0;
+
+done:
+    return error;
+}
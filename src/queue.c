@@ -6,10 +6,54 @@
 
 #include <queue.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdio.h>
 
+static uint64_t
+simple_q_capacity(simple_q *q)
+{
+    return (q->mask + 1);
+}
+
+static uint64_t
+round_up_pow2(uint64_t size)
+{
+    uint64_t capacity = 1;
+
+    while (capacity < size) {
+        capacity <<= 1;
+    }
+
+    return capacity;
+}
+
+/*
+ * Double the array of a full ring. Slots [0, rear) hold its wrapped
+ * tail, and moving them to just past the old end puts them back in
+ * order behind [front, old capacity).
+ */
+static int
+simple_q_grow(simple_q *q)
+{
+    uint64_t capacity = simple_q_capacity(q);
+    simple_q_slot_t *arr = NULL;
+
+    arr = (simple_q_slot_t *)realloc(q->arr,
+                                     2 * capacity * sizeof(simple_q_slot_t));
+    if (arr == NULL) {
+        return -1;
+    }
+
+    memcpy(&arr[capacity], arr, q->rear * sizeof(simple_q_slot_t));
+    q->rear += capacity;
+
+    q->arr = arr;
+    q->mask = 2 * capacity - 1;
+    return 0;
+}
+
 simple_q*
-create_simple_q(uint64_t size)
+create_simple_q_flags(uint64_t size, uint32_t flags)
 {
     if (size < 1 ) {
         return NULL;
@@ -20,7 +64,9 @@ create_simple_q(uint64_t size)
         return NULL;
     }
 
-    newq->arr = (uint64_t*)malloc(sizeof(uint64_t) * size);
+    newq->mask = round_up_pow2(size) - 1;
+    newq->arr = (simple_q_slot_t*)malloc(sizeof(simple_q_slot_t) *
+                                         (newq->mask + 1));
     if (newq->arr == NULL) {
         free(newq);
         return NULL;
@@ -30,10 +76,16 @@ create_simple_q(uint64_t size)
     newq->rear = 0;
     newq->max_size = size;
     newq->curr_size = 0;
+    newq->flags = flags;
 
     return newq;
 }
 
+simple_q*
+create_simple_q(uint64_t size)
+{
+    return create_simple_q_flags(size, 0);
+}
 
 void
 destroy_simple_q(simple_q *q)
@@ -42,18 +94,59 @@ destroy_simple_q(simple_q *q)
     free(q);
 }
 
+/*
+ * Claim the next slot at the rear, growing first if allowed.
+ */
+static simple_q_slot_t *
+simple_q_push_slot(simple_q *q)
+{
+    simple_q_slot_t *slot = NULL;
+
+    if (simple_q_is_full(q)) {
+        goto done;
+    }
+
+    if (q->curr_size == simple_q_capacity(q) && simple_q_grow(q) != 0) {
+        goto done;
+    }
+
+    slot = &q->arr[q->rear];
+    q->rear = (q->rear + 1) & q->mask;
+    ++q->curr_size;
+
+done:
+    return slot;
+}
+
+static simple_q_slot_t *
+simple_q_pop_slot(simple_q *q)
+{
+    simple_q_slot_t *slot = NULL;
+
+    if (simple_q_is_empty(q)) {
+        goto done;
+    }
+
+    slot = &q->arr[q->front];
+    q->front = (q->front + 1) & q->mask;
+    --q->curr_size;
+
+done:
+    return slot;
+}
+
 int
 simple_q_enqueue(simple_q *q, uint64_t key)
 {
     int error = 0;
-    if (simple_q_is_full(q)) {
+    simple_q_slot_t *slot = simple_q_push_slot(q);
+
+    if (slot == NULL) {
         error = -1;
         goto done;
     }
 
-    q->arr[q->rear] = key;
-    q->rear = ((q->rear + 1) % q->max_size);
-    ++q->curr_size;
+    slot->key = key;
 
 done:
     return error;
@@ -63,14 +156,48 @@ int
 simple_q_dequeue(simple_q *q, uint64_t *out)
 {
     int error = 0;
-    if (simple_q_is_empty(q)) {
+    simple_q_slot_t *slot = simple_q_pop_slot(q);
+
+    if (slot == NULL) {
         error = -1;
         goto done;
     }
 
-    *out = q->arr[q->front];
-    q->front = ((q->front + 1) % q->max_size);
-    --q->curr_size;
+    *out = slot->key;
+
+done:
+    return error;
+}
+
+int
+simple_q_enqueue_ptr(simple_q *q, void *ptr)
+{
+    int error = 0;
+    simple_q_slot_t *slot = simple_q_push_slot(q);
+
+    if (slot == NULL) {
+        error = -1;
+        goto done;
+    }
+
+    slot->ptr = ptr;
+
+done:
+    return error;
+}
+
+int
+simple_q_dequeue_ptr(simple_q *q, void **out)
+{
+    int error = 0;
+    simple_q_slot_t *slot = simple_q_pop_slot(q);
+
+    if (slot == NULL) {
+        error = -1;
+        goto done;
+    }
+
+    *out = slot->ptr;
 
 done:
     return error;
@@ -79,6 +206,10 @@ done:
 bool
 simple_q_is_full(simple_q *q)
 {
+    if (q->flags & SIMPLE_Q_F_GROW) {
+        return false;
+    }
+
     return (q->curr_size == q->max_size);
 }
 
@@ -94,8 +225,8 @@ print_simple_q(simple_q *q)
     if (q->curr_size == 0) {
         printf("Empty");
     } else {
-        for (int i = 0; i < q->curr_size; i++) {
-            printf("%llu ", q->arr[i]);
+        for (uint64_t i = 0; i < q->curr_size; i++) {
+            printf("%llu ", q->arr[(q->front + i) & q->mask].key);
         }
     }
 }
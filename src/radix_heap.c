@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Radix Heap Data Structure Operations Implementation.
+ */
+
+#include <radix_heap.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#define RADIX_HEAP_MIN_BUCKET_CAPACITY 16
+
+static int
+radix_bucket_index(uint64_t key, uint64_t last_min)
+{
+    uint64_t diff = key ^ last_min;
+
+    if (diff == 0) {
+        return 0;
+    }
+
+    return 64 - __builtin_clzll(diff);
+}
+
+static int
+radix_bucket_push(radix_heap_bucket_t *b, heap_elem_t *elem)
+{
+    if (b->rb_size == b->rb_capacity) {
+        uint64_t capacity = b->rb_capacity ?
+                            b->rb_capacity * 2 : RADIX_HEAP_MIN_BUCKET_CAPACITY;
+        heap_elem_t *arr = (heap_elem_t *)realloc(b->rb_arr,
+                                capacity * sizeof(heap_elem_t));
+        if (arr == NULL) {
+            return ENOMEM;
+        }
+        b->rb_arr = arr;
+        b->rb_capacity = capacity;
+    }
+
+    b->rb_arr[b->rb_size++] = *elem;
+    return 0;
+}
+
+/*
+ * Refill bucket 0 when it is empty: take the lowest non empty bucket,
+ * make its smallest key the new minimum and spread its keys over the
+ * lower buckets. Every key lands strictly below the bucket it left, and
+ * the minimum itself lands in bucket 0.
+ */
+static int
+radix_heap_refill(radix_heap_t *h)
+{
+    int error = 0;
+    int index = 1;
+    radix_heap_bucket_t *b = NULL;
+    uint64_t new_min = UINT64_MAX;
+
+    if (h->rh_buckets[0].rb_size != 0) {
+        goto done;
+    }
+
+    while (index < RADIX_HEAP_NUM_BUCKETS &&
+           h->rh_buckets[index].rb_size == 0) {
+        index++;
+    }
+
+    if (index == RADIX_HEAP_NUM_BUCKETS) {
+        error = ENOENT;
+        goto done;
+    }
+
+    b = &h->rh_buckets[index];
+    for (uint64_t i = 0; i < b->rb_size; i++) {
+        if (b->rb_arr[i].key < new_min) {
+            new_min = b->rb_arr[i].key;
+        }
+    }
+
+    h->rh_last_min = new_min;
+    for (uint64_t i = 0; i < b->rb_size; i++) {
+        int to = radix_bucket_index(b->rb_arr[i].key, new_min);
+        error = radix_bucket_push(&h->rh_buckets[to], &b->rb_arr[i]);
+        if (error) {
+            /* Keep the entries not moved yet so nothing is lost. */
+            b->rb_size -= i;
+            for (uint64_t j = 0; j < b->rb_size; j++) {
+                b->rb_arr[j] = b->rb_arr[i + j];
+            }
+            goto done;
+        }
+    }
+    b->rb_size = 0;
+
+done:
+    return error;
+}
+
+radix_heap_t *
+create_radix_heap(void)
+{
+    radix_heap_t *h = (radix_heap_t *)calloc(1, sizeof(radix_heap_t));
+    return h;
+}
+
+int
+destroy_radix_heap(radix_heap_t *h)
+{
+    int error = 0;
+
+    if (h == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    for (int i = 0; i < RADIX_HEAP_NUM_BUCKETS; i++) {
+        free(h->rh_buckets[i].rb_arr);
+    }
+    free(h);
+
+done:
+    return error;
+}
+
+bool
+radix_heap_is_empty(radix_heap_t *h)
+{
+    return (h->rh_curr_size == 0);
+}
+
+int
+insert_radix_heap(radix_heap_t *h, heap_elem_t *elem)
+{
+    int error = 0;
+
+    if (h == NULL || elem == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (elem->key < h->rh_last_min) {
+        error = EINVAL;
+        goto done;
+    }
+
+    error = radix_bucket_push(
+                &h->rh_buckets[radix_bucket_index(elem->key, h->rh_last_min)],
+                elem);
+    if (error) {
+        goto done;
+    }
+    h->rh_curr_size++;
+
+done:
+    return error;
+}
+
+heap_elem_t *
+get_radix_heap_min(radix_heap_t *h)
+{
+    radix_heap_bucket_t *b = &h->rh_buckets[0];
+
+    if (radix_heap_is_empty(h) || radix_heap_refill(h) != 0) {
+        return NULL;
+    }
+
+    return &b->rb_arr[b->rb_size - 1];
+}
+
+int
+delete_radix_heap_min(radix_heap_t *h, heap_elem_t *min)
+{
+    int error = 0;
+    radix_heap_bucket_t *b = NULL;
+
+    if (h == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (radix_heap_is_empty(h)) {
+        error = EFAULT;
+        goto done;
+    }
+
+    error = radix_heap_refill(h);
+    if (error) {
+        goto done;
+    }
+
+    b = &h->rh_buckets[0];
+    b->rb_size--;
+    if (min) {
+        *min = b->rb_arr[b->rb_size];
+    }
+    h->rh_curr_size--;
+
+done:
+    return error;
+}
@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Shared Memory Message Queue Implementation.
+ */
+
+#include <shm_queue.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SHM_Q_MIN_CAPACITY      64
+
+/*
+ * Frame header: payload length in the low 32 bits, type in the high 32.
+ * A zero type means the frame has been claimed (or not even that) but
+ * not published yet.
+ */
+#define SHM_Q_FRAME_HDR         sizeof(uint64_t)
+#define SHM_Q_FRAME_MSG         1ULL
+#define SHM_Q_FRAME_PAD         2ULL
+
+static uint64_t
+shm_q_frame_size(uint64_t len)
+{
+    return SHM_Q_FRAME_HDR + ((len + 7) & ~7ULL);
+}
+
+static _Atomic uint64_t *
+shm_q_frame(shm_q *q, uint64_t pos)
+{
+    return (_Atomic uint64_t *)&q->sq_data[pos & q->sq_mask];
+}
+
+static shm_q *
+shm_q_alloc(const char *name, shm_q_hdr_t *hdr, size_t map_size, bool owner)
+{
+    shm_q *q = NULL;
+
+    q = (shm_q *)malloc(sizeof(shm_q));
+    if (q == NULL) {
+        goto done;
+    }
+
+    q->sq_name = strdup(name);
+    if (q->sq_name == NULL) {
+        free(q);
+        q = NULL;
+        goto done;
+    }
+
+    q->sq_hdr = hdr;
+    q->sq_data = hdr->sh_data;
+    q->sq_mask = hdr->sh_capacity - 1;
+    q->sq_max_msg = hdr->sh_capacity / 2 - SHM_Q_FRAME_HDR;
+    if (q->sq_max_msg > (UINT32_MAX & ~7U)) {
+        q->sq_max_msg = UINT32_MAX & ~7U;
+    }
+    q->sq_cached_tail = atomic_load_explicit(&hdr->sh_tail,
+                                             memory_order_acquire);
+    q->sq_map_size = map_size;
+    q->sq_owner = owner;
+
+done:
+    return q;
+}
+
+shm_q *
+create_shm_q(const char *name, uint64_t capacity, uint32_t flags)
+{
+    shm_q *q = NULL;
+    shm_q_hdr_t *hdr = NULL;
+    uint64_t size = SHM_Q_MIN_CAPACITY;
+    size_t map_size = 0;
+    int fd = -1;
+    int error = 0;
+
+    if (name == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    while (size < capacity) {
+        size <<= 1;
+    }
+    map_size = sizeof(shm_q_hdr_t) + size;
+
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        error = errno;
+        goto done;
+    }
+
+    /* A fresh segment reads as zeroes, which is an empty ring. */
+    if (ftruncate(fd, (off_t)map_size) != 0) {
+        error = errno;
+        goto fail;
+    }
+
+    hdr = (shm_q_hdr_t *)mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                              MAP_SHARED, fd, 0);
+    if (hdr == MAP_FAILED) {
+        error = errno;
+        goto fail;
+    }
+
+    hdr->sh_capacity = size;
+    hdr->sh_flags = flags;
+    atomic_store_explicit(&hdr->sh_head, 0, memory_order_relaxed);
+    atomic_store_explicit(&hdr->sh_tail, 0, memory_order_relaxed);
+    atomic_store_explicit(&hdr->sh_magic, SHM_Q_MAGIC, memory_order_release);
+
+    q = shm_q_alloc(name, hdr, map_size, true);
+    if (q == NULL) {
+        error = ENOMEM;
+        munmap(hdr, map_size);
+        goto fail;
+    }
+    goto done;
+
+fail:
+    shm_unlink(name);
+
+done:
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (error) {
+        errno = error;
+    }
+    return q;
+}
+
+shm_q *
+open_shm_q(const char *name)
+{
+    shm_q *q = NULL;
+    shm_q_hdr_t *hdr = NULL;
+    struct stat st;
+    size_t map_size = 0;
+    int fd = -1;
+    int error = 0;
+
+    if (name == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        error = errno;
+        goto done;
+    }
+
+    if (fstat(fd, &st) != 0) {
+        error = errno;
+        goto done;
+    }
+
+    /* The creator has not sized the segment yet. */
+    if (st.st_size < (off_t)sizeof(shm_q_hdr_t)) {
+        error = EAGAIN;
+        goto done;
+    }
+    map_size = (size_t)st.st_size;
+
+    hdr = (shm_q_hdr_t *)mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                              MAP_SHARED, fd, 0);
+    if (hdr == MAP_FAILED) {
+        error = errno;
+        goto done;
+    }
+
+    if (atomic_load_explicit(&hdr->sh_magic, memory_order_acquire) !=
+        SHM_Q_MAGIC) {
+        error = EAGAIN;
+        munmap(hdr, map_size);
+        goto done;
+    }
+
+    if (map_size != sizeof(shm_q_hdr_t) + hdr->sh_capacity) {
+        error = EINVAL;
+        munmap(hdr, map_size);
+        goto done;
+    }
+
+    q = shm_q_alloc(name, hdr, map_size, false);
+    if (q == NULL) {
+        error = ENOMEM;
+        munmap(hdr, map_size);
+    }
+
+done:
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (error) {
+        errno = error;
+    }
+    return q;
+}
+
+int
+destroy_shm_q(shm_q *q)
+{
+    int error = 0;
+
+    if (q == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (q->sq_owner) {
+        shm_unlink(q->sq_name);
+    }
+    munmap(q->sq_hdr, q->sq_map_size);
+    free(q->sq_name);
+    free(q);
+
+done:
+    return error;
+}
+
+void *
+shm_q_reserve(shm_q *q, uint32_t len)
+{
+    shm_q_hdr_t *hdr = q->sq_hdr;
+    uint64_t capacity = q->sq_mask + 1;
+    uint64_t frame = shm_q_frame_size(len);
+    uint64_t head = atomic_load_explicit(&hdr->sh_head, memory_order_relaxed);
+    uint64_t pad = 0;
+
+    if (len > q->sq_max_msg) {
+        errno = EMSGSIZE;
+        return NULL;
+    }
+
+    for (;;) {
+        uint64_t to_end = capacity - (head & q->sq_mask);
+
+        /* Keep the payload contiguous by padding out the end of the ring. */
+        pad = (to_end < frame) ? to_end : 0;
+
+        if (head + pad + frame - q->sq_cached_tail > capacity) {
+            q->sq_cached_tail = atomic_load_explicit(&hdr->sh_tail,
+                                                     memory_order_acquire);
+            if (head + pad + frame - q->sq_cached_tail > capacity) {
+                errno = EAGAIN;
+                return NULL;
+            }
+        }
+
+        if (hdr->sh_flags & SHM_Q_F_SPSC) {
+            atomic_store_explicit(&hdr->sh_head, head + pad + frame,
+                                  memory_order_relaxed);
+            break;
+        }
+
+        if (atomic_compare_exchange_weak_explicit(&hdr->sh_head, &head,
+                                                  head + pad + frame,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    if (pad) {
+        atomic_store_explicit(shm_q_frame(q, head),
+                              (SHM_Q_FRAME_PAD << 32) |
+                              (pad - SHM_Q_FRAME_HDR),
+                              memory_order_release);
+        head += pad;
+    }
+
+    /* Remember the length for commit; type zero keeps it unpublished. */
+    atomic_store_explicit(shm_q_frame(q, head), len, memory_order_relaxed);
+
+    return (uint8_t *)shm_q_frame(q, head) + SHM_Q_FRAME_HDR;
+}
+
+int
+shm_q_commit(shm_q *q, void *msg)
+{
+    int error = 0;
+    _Atomic uint64_t *frame = NULL;
+    uint64_t len = 0;
+
+    if (q == NULL || msg == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    frame = (_Atomic uint64_t *)((uint8_t *)msg - SHM_Q_FRAME_HDR);
+    len = atomic_load_explicit(frame, memory_order_relaxed);
+    atomic_store_explicit(frame, (SHM_Q_FRAME_MSG << 32) | len,
+                          memory_order_release);
+
+done:
+    return error;
+}
+
+/*
+ * Hand 'size' bytes at the tail back to the producers. The frame is
+ * zeroed first so that no byte of it can pass for a published header
+ * on a later lap.
+ */
+static void
+shm_q_advance(shm_q *q, uint64_t tail, uint64_t size)
+{
+    _Atomic uint64_t *frame = shm_q_frame(q, tail);
+
+    atomic_store_explicit(frame, 0, memory_order_relaxed);
+    memset((uint8_t *)frame + SHM_Q_FRAME_HDR, 0, size - SHM_Q_FRAME_HDR);
+    atomic_store_explicit(&q->sq_hdr->sh_tail, tail + size,
+                          memory_order_release);
+}
+
+void *
+shm_q_peek(shm_q *q, uint32_t *len)
+{
+    uint64_t tail = atomic_load_explicit(&q->sq_hdr->sh_tail,
+                                         memory_order_relaxed);
+
+    for (;;) {
+        _Atomic uint64_t *frame = shm_q_frame(q, tail);
+        uint64_t word = atomic_load_explicit(frame, memory_order_acquire);
+        uint64_t type = word >> 32;
+        uint64_t size = SHM_Q_FRAME_HDR + (uint32_t)word;
+
+        if (type == SHM_Q_FRAME_MSG) {
+            *len = (uint32_t)word;
+            return (uint8_t *)frame + SHM_Q_FRAME_HDR;
+        }
+
+        if (type != SHM_Q_FRAME_PAD) {
+            errno = EAGAIN;
+            return NULL;
+        }
+
+        shm_q_advance(q, tail, size);
+        tail += size;
+    }
+}
+
+int
+shm_q_release(shm_q *q)
+{
+    int error = 0;
+    uint64_t tail = 0;
+    uint64_t word = 0;
+
+    if (q == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    tail = atomic_load_explicit(&q->sq_hdr->sh_tail, memory_order_relaxed);
+    word = atomic_load_explicit(shm_q_frame(q, tail), memory_order_relaxed);
+
+    /* Nothing was peeked. */
+    if ((word >> 32) != SHM_Q_FRAME_MSG) {
+        error = EAGAIN;
+        goto done;
+    }
+
+    shm_q_advance(q, tail, shm_q_frame_size((uint32_t)word));
+
+done:
+    return error;
+}
+
+int
+shm_q_send(shm_q *q, const void *buf, uint32_t len)
+{
+    void *msg = NULL;
+
+    if (q == NULL || (buf == NULL && len != 0)) {
+        return EINVAL;
+    }
+
+    msg = shm_q_reserve(q, len);
+    if (msg == NULL) {
+        return errno;
+    }
+
+    /* An empty message may come with a NULL 'buf', which memcpy forbids. */
+    if (len) {
+        memcpy(msg, buf, len);
+    }
+    return shm_q_commit(q, msg);
+}
+
+int
+shm_q_recv(shm_q *q, void *buf, uint32_t max, uint32_t *len)
+{
+    void *msg = NULL;
+    uint32_t n = 0;
+
+    if (q == NULL || (buf == NULL && max != 0) || len == NULL) {
+        return EINVAL;
+    }
+
+    msg = shm_q_peek(q, &n);
+    if (msg == NULL) {
+        return errno;
+    }
+
+    *len = n;
+    if (n > max) {
+        return EMSGSIZE;
+    }
+
+    if (n) {
+        memcpy(buf, msg, n);
+    }
+    return shm_q_release(q);
+}
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Lock-free Single Producer Single Consumer Ring Implementation.
+ */
+
+#include <spsc_ring.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+static uint64_t
+spsc_capacity(spsc_ring_t *r)
+{
+    return (r->sr_mask + 1);
+}
+
+static void *
+spsc_slot(spsc_ring_t *r, uint64_t index)
+{
+    return &r->sr_buf[(index & r->sr_mask) * r->sr_elem_size];
+}
+
+/*
+ * Free slots the producer can see. The shared tail is only loaded when
+ * the cached one runs out; the acquire pairs with the consumer's release
+ * so slots it handed back are really done being read.
+ */
+static uint64_t
+spsc_free_slots(spsc_ring_t *r, uint64_t head, uint64_t want)
+{
+    uint64_t free_slots = spsc_capacity(r) - (head - r->sr_cached_tail);
+
+    if (free_slots < want) {
+        r->sr_cached_tail = atomic_load_explicit(&r->sr_tail,
+                                                 memory_order_acquire);
+        free_slots = spsc_capacity(r) - (head - r->sr_cached_tail);
+    }
+
+    return free_slots;
+}
+
+static uint64_t
+spsc_ready_slots(spsc_ring_t *r, uint64_t tail, uint64_t want)
+{
+    uint64_t ready = r->sr_cached_head - tail;
+
+    if (ready < want) {
+        r->sr_cached_head = atomic_load_explicit(&r->sr_head,
+                                                 memory_order_acquire);
+        ready = r->sr_cached_head - tail;
+    }
+
+    return ready;
+}
+
+/*
+ * Clip a run of 'n' slots starting at 'index' at the end of the array.
+ */
+static uint64_t
+spsc_contiguous(spsc_ring_t *r, uint64_t index, uint64_t n)
+{
+    uint64_t to_end = spsc_capacity(r) - (index & r->sr_mask);
+
+    return (n < to_end) ? n : to_end;
+}
+
+spsc_ring_t *
+create_spsc_ring(uint64_t capacity, size_t elem_size)
+{
+    spsc_ring_t *r = NULL;
+    uint64_t size = 1;
+
+    if (capacity == 0 || elem_size == 0) {
+        goto done;
+    }
+
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    if (posix_memalign((void **)&r, SPSC_RING_CACHE_LINE,
+                       sizeof(spsc_ring_t)) != 0) {
+        r = NULL;
+        goto done;
+    }
+
+    if (posix_memalign((void **)&r->sr_buf, SPSC_RING_CACHE_LINE,
+                       size * elem_size) != 0) {
+        free(r);
+        r = NULL;
+        goto done;
+    }
+
+    atomic_init(&r->sr_head, 0);
+    atomic_init(&r->sr_tail, 0);
+    r->sr_cached_tail = 0;
+    r->sr_cached_head = 0;
+    r->sr_mask = size - 1;
+    r->sr_elem_size = elem_size;
+
+done:
+    return r;
+}
+
+int
+destroy_spsc_ring(spsc_ring_t *r)
+{
+    int error = 0;
+
+    if (r == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    free(r->sr_buf);
+    free(r);
+
+done:
+    return error;
+}
+
+int
+spsc_ring_push(spsc_ring_t *r, const void *elem)
+{
+    int error = 0;
+    uint64_t head = atomic_load_explicit(&r->sr_head, memory_order_relaxed);
+
+    if (spsc_free_slots(r, head, 1) == 0) {
+        error = EAGAIN;
+        goto done;
+    }
+
+    memcpy(spsc_slot(r, head), elem, r->sr_elem_size);
+    atomic_store_explicit(&r->sr_head, head + 1, memory_order_release);
+
+done:
+    return error;
+}
+
+int
+spsc_ring_pop(spsc_ring_t *r, void *elem)
+{
+    int error = 0;
+    uint64_t tail = atomic_load_explicit(&r->sr_tail, memory_order_relaxed);
+
+    if (spsc_ready_slots(r, tail, 1) == 0) {
+        error = EAGAIN;
+        goto done;
+    }
+
+    memcpy(elem, spsc_slot(r, tail), r->sr_elem_size);
+    atomic_store_explicit(&r->sr_tail, tail + 1, memory_order_release);
+
+done:
+    return error;
+}
+
+void *
+spsc_ring_reserve(spsc_ring_t *r, uint64_t want, uint64_t *got)
+{
+    uint64_t head = atomic_load_explicit(&r->sr_head, memory_order_relaxed);
+    uint64_t n = spsc_free_slots(r, head, want);
+
+    if (n > want) {
+        n = want;
+    }
+    n = spsc_contiguous(r, head, n);
+
+    *got = n;
+    return n ? spsc_slot(r, head) : NULL;
+}
+
+int
+spsc_ring_commit(spsc_ring_t *r, uint64_t n)
+{
+    int error = 0;
+    uint64_t head = atomic_load_explicit(&r->sr_head, memory_order_relaxed);
+
+    if (n > spsc_capacity(r) - (head - r->sr_cached_tail)) {
+        error = EINVAL;
+        goto done;
+    }
+
+    atomic_store_explicit(&r->sr_head, head + n, memory_order_release);
+
+done:
+    return error;
+}
+
+void *
+spsc_ring_peek(spsc_ring_t *r, uint64_t want, uint64_t *got)
+{
+    uint64_t tail = atomic_load_explicit(&r->sr_tail, memory_order_relaxed);
+    uint64_t n = spsc_ready_slots(r, tail, want);
+
+    if (n > want) {
+        n = want;
+    }
+    n = spsc_contiguous(r, tail, n);
+
+    *got = n;
+    return n ? spsc_slot(r, tail) : NULL;
+}
+
+int
+spsc_ring_release(spsc_ring_t *r, uint64_t n)
+{
+    int error = 0;
+    uint64_t tail = atomic_load_explicit(&r->sr_tail, memory_order_relaxed);
+
+    if (n > r->sr_cached_head - tail) {
+        error = EINVAL;
+        goto done;
+    }
+
+    atomic_store_explicit(&r->sr_tail, tail + n, memory_order_release);
+
+done:
+    return error;
+}
+
+uint64_t
+spsc_ring_size(spsc_ring_t *r)
+{
+    uint64_t tail = atomic_load_explicit(&r->sr_tail, memory_order_acquire);
+    uint64_t head = atomic_load_explicit(&r->sr_head, memory_order_acquire);
+
+    return (head - tail);
+}
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Hierarchical Timing Wheel Implementation.
+ */
+
+#include <timing_wheel.h>
+#include <stdlib.h>
+#include <errno.h>
+
+static void
+tw_list_init(tw_list_t *head)
+{
+    head->next = head;
+    head->prev = head;
+}
+
+static bool
+tw_list_empty(tw_list_t *head)
+{
+    return (head->next == head);
+}
+
+static void
+tw_list_add_tail(tw_list_t *head, tw_list_t *node)
+{
+    node->prev = head->prev;
+    node->next = head;
+    head->prev->next = node;
+    head->prev = node;
+}
+
+static void
+tw_list_del(tw_list_t *node)
+{
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->next = NULL;
+    node->prev = NULL;
+}
+
+/*
+ * Move every entry of 'from' onto the empty list 'to'.
+ */
+static void
+tw_list_splice(tw_list_t *from, tw_list_t *to)
+{
+    tw_list_init(to);
+    if (tw_list_empty(from)) {
+        return;
+    }
+
+    to->next = from->next;
+    to->prev = from->prev;
+    to->next->prev = to;
+    to->prev->next = to;
+    tw_list_init(from);
+}
+
+/*
+ * Pick the level from how far ahead the timer is, and the slot from the
+ * bits of its absolute expiry at that level.
+ */
+static void
+tw_place(timing_wheel_t *tw, tw_timer_t *t)
+{
+    uint64_t expires = t->expires;
+    uint64_t delta = 0;
+    int level = 0;
+
+    if (expires < tw->tw_now) {
+        expires = tw->tw_now;
+    }
+
+    delta = expires - tw->tw_now;
+    if (delta > TW_MAX_DELTA) {
+        delta = TW_MAX_DELTA;
+        expires = tw->tw_now + TW_MAX_DELTA;
+    }
+
+    while (level < TW_LEVELS - 1 &&
+           delta >= (1ULL << (TW_SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+
+    tw_list_add_tail(
+        &tw->tw_slots[level][(expires >> (TW_SLOT_BITS * level)) & TW_SLOT_MASK],
+        &t->node);
+}
+
+/*
+ * Re-place every timer of one slot; they all land on lower levels.
+ * Returns the slot index so the caller knows whether this level wrapped.
+ */
+static uint64_t
+tw_cascade(timing_wheel_t *tw, int level)
+{
+    uint64_t index = (tw->tw_now >> (TW_SLOT_BITS * level)) & TW_SLOT_MASK;
+    tw_list_t work;
+
+    tw_list_splice(&tw->tw_slots[level][index], &work);
+    while (!tw_list_empty(&work)) {
+        tw_timer_t *t = (tw_timer_t *)work.next;
+        tw_list_del(&t->node);
+        tw_place(tw, t);
+    }
+
+    return index;
+}
+
+timing_wheel_t *
+create_timing_wheel(uint64_t start_tick)
+{
+    timing_wheel_t *tw = (timing_wheel_t *)malloc(sizeof(timing_wheel_t));
+    if (tw == NULL) {
+        goto done;
+    }
+
+    tw->tw_now = start_tick;
+    tw->tw_count = 0;
+    for (int l = 0; l < TW_LEVELS; l++) {
+        for (int s = 0; s < TW_SLOTS; s++) {
+            tw_list_init(&tw->tw_slots[l][s]);
+        }
+    }
+
+done:
+    return tw;
+}
+
+int
+destroy_timing_wheel(timing_wheel_t *tw)
+{
+    int error = 0;
+
+    if (tw == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    /* Timers belong to the caller, just detach them. */
+    for (int l = 0; l < TW_LEVELS; l++) {
+        for (int s = 0; s < TW_SLOTS; s++) {
+            while (!tw_list_empty(&tw->tw_slots[l][s])) {
+                tw_list_del(tw->tw_slots[l][s].next);
+            }
+        }
+    }
+    free(tw);
+
+done:
+    return error;
+}
+
+void
+tw_timer_init(tw_timer_t *t, void *payload)
+{
+    t->node.next = NULL;
+    t->node.prev = NULL;
+    t->expires = 0;
+    t->payload = payload;
+}
+
+bool
+tw_timer_pending(tw_timer_t *t)
+{
+    return (t->node.next != NULL);
+}
+
+int
+timing_wheel_schedule(timing_wheel_t *tw, tw_timer_t *t, uint64_t expires)
+{
+    int error = 0;
+
+    if (tw == NULL || t == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (tw_timer_pending(t)) {
+        tw_list_del(&t->node);
+        tw->tw_count--;
+    }
+
+    t->expires = expires;
+    tw_place(tw, t);
+    tw->tw_count++;
+
+done:
+    return error;
+}
+
+int
+timing_wheel_cancel(timing_wheel_t *tw, tw_timer_t *t)
+{
+    int error = 0;
+
+    if (tw == NULL || t == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (!tw_timer_pending(t)) {
+        error = ENOENT;
+        goto done;
+    }
+
+    tw_list_del(&t->node);
+    tw->tw_count--;
+
+done:
+    return error;
+}
+
+uint64_t
+timing_wheel_advance(timing_wheel_t *tw, uint64_t now, tw_expirycb cb)
+{
+    uint64_t expired = 0;
+    tw_list_t work;
+
+    if (tw == NULL) {
+        return 0;
+    }
+
+    while (tw->tw_now <= now) {
+        uint64_t index = tw->tw_now & TW_SLOT_MASK;
+
+        /* Level 0 wrapped, pull the next range down level by level. */
+        if (index == 0) {
+            for (int l = 1; l < TW_LEVELS; l++) {
+                if (tw_cascade(tw, l) != 0) {
+                    break;
+                }
+            }
+        }
+
+        /*
+         * Detach the slot and step the clock first, so callbacks that
+         * schedule at or before the current tick land on the next one.
+         */
+        tw_list_splice(&tw->tw_slots[0][index], &work);
+        tw->tw_now++;
+
+        while (!tw_list_empty(&work)) {
+            tw_timer_t *t = (tw_timer_t *)work.next;
+            tw_list_del(&t->node);
+            tw->tw_count--;
+            expired++;
+            if (cb) {
+                cb(t);
+            }
+        }
+
+        if (tw->tw_now == 0) {
+            break;
+        }
+    }
+
+    return expired;
+}
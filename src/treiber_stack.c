@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Lock-free Treiber Stack Implementation.
+ */
+
+#include <treiber_stack.h>
+#include <stdlib.h>
+#include <errno.h>
+
+/*
+ * Head word: the node address shifted right by its 3 alignment bits in
+ * the low 45 bits, and the tag in the 19 bits above.
+ */
+#define TREIBER_ADDR_BITS       45
+#define TREIBER_ADDR_MASK       ((1ULL << TREIBER_ADDR_BITS) - 1)
+
+_Static_assert(sizeof(void *) == sizeof(uint64_t),
+               "treiber_stack packs pointers into 64 bit words");
+
+static _Thread_local uint32_t treiber_seed;
+
+static uint64_t
+treiber_pack(treiber_node_t *node, uint64_t tag)
+{
+    return (tag << TREIBER_ADDR_BITS) | ((uintptr_t)node >> 3);
+}
+
+static treiber_node_t *
+treiber_node(uint64_t word)
+{
+    return (treiber_node_t *)(uintptr_t)((word & TREIBER_ADDR_MASK) << 3);
+}
+
+static uint64_t
+treiber_tag(uint64_t word)
+{
+    return word >> TREIBER_ADDR_BITS;
+}
+
+static treiber_slot_t *
+treiber_elim_slot(treiber_stack_t *s)
+{
+    uint32_t x = treiber_seed;
+
+    /* xorshift32; seeded from the thread's stack address. */
+    if (x == 0) {
+        x = (uint32_t)((uintptr_t)&x >> 4) | 1;
+    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    treiber_seed = x;
+
+    return &s->tr_elim[x % TREIBER_ELIM_SLOTS];
+}
+
+/*
+ * Offer 'node' to a concurrent pop. Returns true if a pop took it.
+ */
+static bool
+treiber_elim_push(treiber_stack_t *s, treiber_node_t *node)
+{
+    treiber_slot_t *slot = treiber_elim_slot(s);
+    treiber_node_t *expected = NULL;
+
+    if (!atomic_compare_exchange_strong_explicit(&slot->node, &expected, node,
+                                                 memory_order_release,
+                                                 memory_order_relaxed)) {
+        return false;
+    }
+
+    for (int i = 0; i < TREIBER_ELIM_SPINS; i++) {
+        if (atomic_load_explicit(&slot->node, memory_order_relaxed) != node) {
+            return true;
+        }
+    }
+
+    /* Withdraw the offer; failing means a pop got there first. */
+    expected = node;
+    return !atomic_compare_exchange_strong_explicit(&slot->node, &expected,
+                                                    NULL,
+                                                    memory_order_relaxed,
+                                                    memory_order_relaxed);
+}
+
+/*
+ * Take a node offered by a concurrent push, if there is one.
+ */
+static treiber_node_t *
+treiber_elim_pop(treiber_stack_t *s)
+{
+    treiber_slot_t *slot = treiber_elim_slot(s);
+    treiber_node_t *node = atomic_load_explicit(&slot->node,
+                                                memory_order_relaxed);
+
+    if (node == NULL ||
+        !atomic_compare_exchange_strong_explicit(&slot->node, &node, NULL,
+                                                 memory_order_acquire,
+                                                 memory_order_relaxed)) {
+        return NULL;
+    }
+
+    return node;
+}
+
+treiber_stack_t *
+create_treiber_stack(uint32_t flags)
+{
+    treiber_stack_t *s = NULL;
+
+    if (posix_memalign((void **)&s, TREIBER_CACHE_LINE,
+                       sizeof(treiber_stack_t)) != 0) {
+        s = NULL;
+        goto done;
+    }
+
+    atomic_init(&s->tr_head, treiber_pack(NULL, 0));
+    s->tr_flags = flags;
+    for (int i = 0; i < TREIBER_ELIM_SLOTS; i++) {
+        atomic_init(&s->tr_elim[i].node, NULL);
+    }
+
+done:
+    return s;
+}
+
+int
+destroy_treiber_stack(treiber_stack_t *s)
+{
+    int error = 0;
+
+    if (s == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    free(s);
+
+done:
+    return error;
+}
+
+/*
+ * Push the chain 'top' ... 'bottom', already linked through next.
+ * Pushes keep the tag; only pops need to change it.
+ */
+static void
+treiber_push_chain(treiber_stack_t *s, treiber_node_t *top,
+                   treiber_node_t *bottom)
+{
+    uint64_t old = atomic_load_explicit(&s->tr_head, memory_order_relaxed);
+
+    for (;;) {
+        uint64_t want = treiber_pack(top, treiber_tag(old));
+
+        atomic_store_explicit(&bottom->next, treiber_node(old),
+                              memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(&s->tr_head, &old, want,
+                                                  memory_order_release,
+                                                  memory_order_relaxed)) {
+            return;
+        }
+
+        if ((s->tr_flags & TREIBER_F_ELIMINATE) && top == bottom &&
+            treiber_elim_push(s, top)) {
+            return;
+        }
+    }
+}
+
+int
+treiber_stack_push(treiber_stack_t *s, treiber_node_t *node)
+{
+    int error = 0;
+
+    if (s == NULL || node == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    treiber_push_chain(s, node, node);
+
+done:
+    return error;
+}
+
+int
+treiber_stack_push_batch(treiber_stack_t *s, treiber_node_t **nodes,
+                         uint64_t n)
+{
+    int error = 0;
+
+    if (s == NULL || (nodes == NULL && n != 0)) {
+        error = EINVAL;
+        goto done;
+    }
+
+    if (n == 0) {
+        goto done;
+    }
+
+    for (uint64_t i = 1; i < n; i++) {
+        atomic_store_explicit(&nodes[i]->next, nodes[i - 1],
+                              memory_order_relaxed);
+    }
+    treiber_push_chain(s, nodes[n - 1], nodes[0]);
+
+done:
+    return error;
+}
+
+int
+treiber_stack_pop(treiber_stack_t *s, treiber_node_t **node)
+{
+    uint64_t old = 0;
+
+    if (s == NULL || node == NULL) {
+        return EINVAL;
+    }
+
+    old = atomic_load_explicit(&s->tr_head, memory_order_acquire);
+    for (;;) {
+        treiber_node_t *top = treiber_node(old);
+        treiber_node_t *next = NULL;
+        treiber_node_t *taken = NULL;
+        uint64_t want = 0;
+
+        if (top == NULL) {
+            return ENOENT;
+        }
+
+        /* 'top' may already be gone; the tag makes the CAS fail then. */
+        next = atomic_load_explicit(&top->next, memory_order_relaxed);
+        want = treiber_pack(next, treiber_tag(old) + 1);
+        if (atomic_compare_exchange_weak_explicit(&s->tr_head, &old, want,
+                                                  memory_order_acquire,
+                                                  memory_order_acquire)) {
+            *node = top;
+            return 0;
+        }
+
+        if ((s->tr_flags & TREIBER_F_ELIMINATE) &&
+            (taken = treiber_elim_pop(s)) != NULL) {
+            *node = taken;
+            return 0;
+        }
+    }
+}
+
+treiber_node_t *
+treiber_stack_pop_all(treiber_stack_t *s)
+{
+    uint64_t old = atomic_load_explicit(&s->tr_head, memory_order_acquire);
+
+    while (treiber_node(old) != NULL) {
+        uint64_t want = treiber_pack(NULL, treiber_tag(old) + 1);
+
+        if (atomic_compare_exchange_weak_explicit(&s->tr_head, &old, want,
+                                                  memory_order_acquire,
+                                                  memory_order_acquire)) {
+            break;
+        }
+    }
+
+    return treiber_node(old);
+}
+
+bool
+treiber_stack_is_empty(treiber_stack_t *s)
+{
+    return (treiber_node(atomic_load_explicit(&s->tr_head,
+                                              memory_order_relaxed)) == NULL);
+}
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026 Vedant Mathur
+ *
+ * Chase-Lev Work Stealing Deque Implementation.
+ */
+
+#include <ws_deque.h>
+#include <stdlib.h>
+#include <errno.h>
+
+static ws_array_t *
+ws_array_alloc(int64_t size)
+{
+    ws_array_t *a = NULL;
+
+    a = (ws_array_t *)malloc(sizeof(ws_array_t) + size * sizeof(void *));
+    if (a == NULL) {
+        goto done;
+    }
+
+    a->prev = NULL;
+    a->mask = size - 1;
+
+done:
+    return a;
+}
+
+/*
+ * Copy the live range [top, bottom) into an array twice the size. Only
+ * the owner calls this, and positions keep their meaning because both
+ * arrays are indexed by the same position under their own mask.
+ */
+static ws_array_t *
+ws_deque_grow(ws_deque_t *d, ws_array_t *old, int64_t top, int64_t bottom)
+{
+    ws_array_t *a = ws_array_alloc(2 * (old->mask + 1));
+
+    if (a == NULL) {
+        return NULL;
+    }
+
+    for (int64_t i = top; i < bottom; i++) {
+        void *item = atomic_load_explicit(&old->slots[i & old->mask],
+                                          memory_order_relaxed);
+        atomic_store_explicit(&a->slots[i & a->mask], item,
+                              memory_order_relaxed);
+    }
+
+    a->prev = old;
+    atomic_store_explicit(&d->wd_array, a, memory_order_release);
+    return a;
+}
+
+ws_deque_t *
+create_ws_deque(uint64_t capacity)
+{
+    ws_deque_t *d = NULL;
+    ws_array_t *a = NULL;
+    int64_t size = 1;
+
+    while (size < (int64_t)capacity) {
+        size <<= 1;
+    }
+
+    a = ws_array_alloc(size);
+    if (a == NULL) {
+        goto done;
+    }
+
+    if (posix_memalign((void **)&d, WS_DEQUE_CACHE_LINE,
+                       sizeof(ws_deque_t)) != 0) {
+        free(a);
+        d = NULL;
+        goto done;
+    }
+
+    atomic_init(&d->wd_top, 0);
+    atomic_init(&d->wd_bottom, 0);
+    atomic_init(&d->wd_array, a);
+
+done:
+    return d;
+}
+
+int
+destroy_ws_deque(ws_deque_t *d)
+{
+    int error = 0;
+    ws_array_t *a = NULL;
+
+    if (d == NULL) {
+        error = EINVAL;
+        goto done;
+    }
+
+    a = atomic_load_explicit(&d->wd_array, memory_order_relaxed);
+    while (a) {
+        ws_array_t *prev = a->prev;
+        free(a);
+        a = prev;
+    }
+    free(d);
+
+done:
+    return error;
+}
+
+int
+ws_deque_push(ws_deque_t *d, void *item)
+{
+    int64_t bottom = atomic_load_explicit(&d->wd_bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&d->wd_top, memory_order_acquire);
+    ws_array_t *a = atomic_load_explicit(&d->wd_array, memory_order_relaxed);
+
+    if (bottom - top > a->mask) {
+        a = ws_deque_grow(d, a, top, bottom);
+        if (a == NULL) {
+            return ENOMEM;
+        }
+    }
+
+    atomic_store_explicit(&a->slots[bottom & a->mask], item,
+                          memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->wd_bottom, bottom + 1, memory_order_relaxed);
+
+    return 0;
+}
+
+int
+ws_deque_pop(ws_deque_t *d, void **item)
+{
+    int error = 0;
+    int64_t bottom = atomic_load_explicit(&d->wd_bottom,
+                                          memory_order_relaxed) - 1;
+    ws_array_t *a = atomic_load_explicit(&d->wd_array, memory_order_relaxed);
+    int64_t top = 0;
+    void *popped = NULL;
+
+    /*
+     * Claim the bottom slot before looking at top. The fence orders the
+     * store against the load so that a thief and the owner cannot both
+     * take the last element.
+     */
+    atomic_store_explicit(&d->wd_bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    top = atomic_load_explicit(&d->wd_top, memory_order_relaxed);
+
+    if (top > bottom) {
+        error = ENOENT;
+        atomic_store_explicit(&d->wd_bottom, bottom + 1,
+                              memory_order_relaxed);
+        goto done;
+    }
+
+    popped = atomic_load_explicit(&a->slots[bottom & a->mask],
+                                  memory_order_relaxed);
+    if (top == bottom) {
+        /* Last element: race thieves for it through top. */
+        if (!atomic_compare_exchange_strong_explicit(&d->wd_top, &top,
+                                                     top + 1,
+                                                     memory_order_seq_cst,
+                                                     memory_order_relaxed)) {
+            error = ENOENT;
+        }
+        atomic_store_explicit(&d->wd_bottom, bottom + 1,
+                              memory_order_relaxed);
+        if (error) {
+            goto done;
+        }
+    }
+
+    *item = popped;
+
+done:
+    return error;
+}
+
+int
+ws_deque_steal(ws_deque_t *d, void **item)
+{
+    int64_t top = atomic_load_explicit(&d->wd_top, memory_order_acquire);
+    int64_t bottom = 0;
+    ws_array_t *a = NULL;
+    void *stolen = NULL;
+
+    atomic_thread_fence(memory_order_seq_cst);
+    bottom = atomic_load_explicit(&d->wd_bottom, memory_order_acquire);
+
+    if (top >= bottom) {
+        return ENOENT;
+    }
+
+    a = atomic_load_explicit(&d->wd_array, memory_order_acquire);
+    stolen = atomic_load_explicit(&a->slots[top & a->mask],
+                                  memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&d->wd_top, &top, top + 1,
+                                                 memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return EAGAIN;
+    }
+
+    *item = stolen;
+    return 0;
+}
+
+uint64_t
+ws_deque_size(ws_deque_t *d)
+{
+    int64_t bottom = atomic_load_explicit(&d->wd_bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&d->wd_top, memory_order_relaxed);
+
+    return (bottom > top) ? (uint64_t)(bottom - top) : 0;
+}